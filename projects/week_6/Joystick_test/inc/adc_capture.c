@@ -0,0 +1,217 @@
+// Embarcatech, April 2025 - ADC acquisition service (DMA round-robin)
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    The ADC FIFO does not say which input a sample came from, so the
+    channel is deduced from the sample's position: conversions run in the
+    fixed order ADC0, ADC1, ADC4 from the first one of a run (the
+    "origin"), and sample k of the run belongs to channel k % 3. Positions
+    are absolute sample counts, taken from the DMA transfer counter; ring
+    slot = position % ring size. A FIFO overflow drops samples and breaks
+    that order, so every read first checks for one and restarts the run
+    at a new origin: no read ever returns a sample of the wrong channel.
+    A read takes the origin and the sample count together with interrupts
+    off, so a restart by a read in the timer tick cannot split them.
+    ======================================================================== */
+
+#include "pico/stdlib.h"       // Pico SDK utilities (time)
+#include "hardware/adc.h"      // ADC round-robin and FIFO
+#include "hardware/dma.h"      // DMA channel draining the FIFO
+#include "hardware/irq.h"      // DMA completion interrupt
+#include "hardware/clocks.h"   // clock_get_hz()
+#include "hardware/sync.h"     // save_and_disable_interrupts()
+#include "adc_capture.h"
+
+#define VRX_PIN 26                        // GPIO of ADC0 (joystick X)
+#define VRY_PIN 27                        // GPIO of ADC1 (joystick Y)
+#define ROUND_ROBIN_MASK ((1u << ADC_CAPTURE_CH_X) | (1u << ADC_CAPTURE_CH_Y) | (1u << ADC_CAPTURE_CH_TEMP))
+#define RING_MASK (ADC_CAPTURE_RING_SAMPLES - 1)
+#define DMA_RUN_COUNT 0xFFFFFFFFu         // Transfers per DMA run (~2.4 h at 500 kSps), then re-armed
+
+// Wrapping DMA writes need the ring aligned to its own size
+static uint16_t ring[ADC_CAPTURE_RING_SAMPLES] __attribute__((aligned(1u << ADC_CAPTURE_RING_BITS)));
+
+static int dma_chan = -1;
+static dma_channel_config dma_config;
+static volatile uint64_t run_base;        // Samples written before the current DMA run
+static uint64_t origin;                   // Position of the first ADC0 sample of the current capture run
+static volatile uint16_t last_latest[ADC_CAPTURE_CHANNELS]; // Returned by adc_capture_latest() just after a restart
+static volatile uint32_t overflows;       // Counted by the reads, possibly in interrupt context
+static uint64_t stats_samples;            // Counters at the previous adc_capture_get_stats()
+static uint64_t stats_time_us;
+
+// Samples written so far (consistent even if the completion IRQ fires in between)
+static uint64_t samples_written(void) {
+    uint64_t base;
+    uint32_t remaining;
+    do {
+        base = run_base;
+        remaining = dma_channel_hw_addr(dma_chan)->transfer_count;
+    } while (base != run_base);
+    return base + (DMA_RUN_COUNT - remaining);
+}
+
+// DMA run finished: keep going from where the ring pointer is
+static void dma_complete_handler(void) {
+    if (dma_hw->ints1 & (1u << dma_chan)) {
+        dma_hw->ints1 = 1u << dma_chan;
+        run_base += DMA_RUN_COUNT;
+        dma_channel_set_trans_count(dma_chan, DMA_RUN_COUNT, true);
+    }
+}
+
+// Starts a capture run at the current position, beginning with ADC0
+static void start_run(void) {
+    uint64_t position = samples_written();
+    run_base = position;
+    origin = position;
+    adc_select_input(ADC_CAPTURE_CH_X);
+    dma_channel_configure(dma_chan, &dma_config, &ring[position & RING_MASK], &adc_hw->fifo,
+                          DMA_RUN_COUNT, true);
+    adc_run(true);
+}
+
+// Stops conversions and DMA, discards what is left in the FIFO and starts again
+static void restart_run(void) {
+    adc_run(false);
+    dma_channel_set_irq1_enabled(dma_chan, false);  // Abort may raise a spurious completion
+    dma_channel_abort(dma_chan);
+    dma_hw->ints1 = 1u << dma_chan;
+    dma_channel_set_irq1_enabled(dma_chan, true);
+    adc_fifo_drain();
+    adc_hw->fcs |= ADC_FCS_OVER_BITS | ADC_FCS_UNDER_BITS;  // Write 1 to clear
+    start_run();
+}
+
+// Restarts the run after a FIFO overflow, then returns the origin of the run and the samples
+// written, read together (the timer tick and the main loop both read, on the same core)
+static uint64_t run_snapshot(uint64_t *written) {
+    uint32_t status = save_and_disable_interrupts();
+    if (adc_hw->fcs & ADC_FCS_OVER_BITS) {
+        overflows++;
+        restart_run();
+    }
+    uint64_t first = origin;
+    *written = samples_written();
+    restore_interrupts(status);
+    return first;
+}
+
+// Position of a channel in the round-robin, -1 if it is not sampled
+static int channel_slot(uint8_t channel) {
+    switch (channel) {
+        case ADC_CAPTURE_CH_X: return 0;
+        case ADC_CAPTURE_CH_Y: return 1;
+        case ADC_CAPTURE_CH_TEMP: return 2;
+        default: return -1;
+    }
+}
+
+// Run-relative index of the newest sample of a channel, -1 if there is none yet
+static int64_t newest_index(int slot, uint64_t first, uint64_t written) {
+    int64_t count = (int64_t)(written - first);
+    if (slot < 0 || count <= slot) {
+        return -1;
+    }
+    return count - 1 - (count - 1 - slot) % ADC_CAPTURE_CHANNELS;
+}
+
+int adc_capture_init(uint32_t sample_rate_hz) {
+    if (sample_rate_hz == 0 || sample_rate_hz > ADC_CAPTURE_MAX_RATE) {
+        return ADC_CAPTURE_BAD_RATE;
+    }
+    dma_chan = dma_claim_unused_channel(false);
+    if (dma_chan < 0) {
+        return ADC_CAPTURE_NO_DMA;
+    }
+
+    adc_init();
+    adc_gpio_init(VRX_PIN);
+    adc_gpio_init(VRY_PIN);
+    adc_set_temp_sensor_enabled(true);
+    adc_set_round_robin(ROUND_ROBIN_MASK);
+    adc_fifo_setup(true, true, 1, false, false);  // FIFO on, DREQ at 1 sample, no error bit, 12-bit samples
+    adc_set_clkdiv((float)clock_get_hz(clk_adc) / sample_rate_hz - 1.0f);  // Below 96: back-to-back
+
+    dma_config = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_16);
+    channel_config_set_read_increment(&dma_config, false);
+    channel_config_set_write_increment(&dma_config, true);
+    channel_config_set_ring(&dma_config, true, ADC_CAPTURE_RING_BITS);  // Wrap the write address
+    channel_config_set_dreq(&dma_config, DREQ_ADC);
+
+    dma_channel_set_irq1_enabled(dma_chan, true);
+    irq_add_shared_handler(DMA_IRQ_1, dma_complete_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    run_base = 0;
+    overflows = 0;
+    for (int i = 0; i < ADC_CAPTURE_CHANNELS; i++) {
+        last_latest[i] = 0;
+    }
+    stats_samples = 0;
+    stats_time_us = time_us_64();
+    dma_channel_configure(dma_chan, &dma_config, ring, &adc_hw->fifo, DMA_RUN_COUNT, false);
+    start_run();
+    return ADC_CAPTURE_OK;
+}
+
+uint16_t adc_capture_latest(uint8_t channel) {
+    uint64_t written;
+    uint64_t first = run_snapshot(&written);
+    int slot = channel_slot(channel);
+    int64_t index = newest_index(slot, first, written);
+    if (index < 0) {
+        return slot < 0 ? 0 : last_latest[slot];  // Nothing converted yet in this run
+    }
+    uint16_t value = ring[(first + (uint64_t)index) & RING_MASK];
+    last_latest[slot] = value;
+    return value;
+}
+
+uint16_t adc_capture_average(uint8_t channel, uint16_t count) {
+    uint64_t written;
+    uint64_t first = run_snapshot(&written);
+    int64_t index = newest_index(channel_slot(channel), first, written);
+    if (count > ADC_CAPTURE_MAX_AVERAGE) {
+        count = ADC_CAPTURE_MAX_AVERAGE;
+    }
+    uint32_t sum = 0;
+    uint16_t used = 0;
+    for (; used < count && index >= 0; used++, index -= ADC_CAPTURE_CHANNELS) {
+        sum += ring[(first + (uint64_t)index) & RING_MASK];
+    }
+    return used ? (uint16_t)((sum + used / 2) / used) : 0;
+}
+
+uint16_t adc_capture_recent(uint8_t channel, uint16_t *out, uint16_t count) {
+    uint64_t written;
+    uint64_t first = run_snapshot(&written);
+    int64_t index = newest_index(channel_slot(channel), first, written);
+    if (count > ADC_CAPTURE_MAX_AVERAGE) {
+        count = ADC_CAPTURE_MAX_AVERAGE;
+    }
+    if (index < 0) {
+        return 0;
+    }
+    int64_t available = index / ADC_CAPTURE_CHANNELS + 1;  // Samples of this channel in the run
+    if (count > available) {
+        count = (uint16_t)available;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        out[i] = ring[(first + (uint64_t)(index - (int64_t)(count - 1 - i) * ADC_CAPTURE_CHANNELS)) & RING_MASK];
+    }
+    return count;
+}
+
+void adc_capture_get_stats(adc_capture_stats_t *stats) {
+    uint64_t samples = samples_written();
+    uint64_t now = time_us_64();
+    uint64_t elapsed = now - stats_time_us;
+
+    stats->samples = samples;
+    stats->samples_per_second = elapsed ? (uint32_t)((samples - stats_samples) * 1000000u / elapsed) : 0;
+    stats->overflows = overflows;
+    stats_samples = samples;
+    stats_time_us = now;
+}
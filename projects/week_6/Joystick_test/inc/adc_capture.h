@@ -0,0 +1,93 @@
+// Embarcatech, April 2025 - ADC acquisition service (DMA round-robin)
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Free-running capture of the joystick axes (ADC0 on GPIO26, ADC1 on
+    GPIO27) and the internal temperature sensor (ADC4). The ADC converts
+    the three inputs in hardware round-robin and DMA drains its FIFO into
+    a RAM ring, so reading a value never starts a conversion or waits.
+
+    Key Features:
+    - No CPU per sample: ADC round-robin + DREQ-paced DMA with write-address
+      ring wrap
+    - Non-blocking reads of the latest or the average of the last N
+      samples of each channel
+    - Samples-per-second and FIFO overflow counters; every read checks
+      for an overflow (DMA starved) and restarts the capture first, so
+      the channel order stays aligned
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADC_CAPTURE_CH_X 0            // Joystick X axis (GPIO26)
+#define ADC_CAPTURE_CH_Y 1            // Joystick Y axis (GPIO27)
+#define ADC_CAPTURE_CH_TEMP 4         // Internal temperature sensor
+#define ADC_CAPTURE_CHANNELS 3        // Inputs in the round-robin
+
+#define ADC_CAPTURE_RING_BITS 9       // Ring of 2^9 bytes = 256 samples (~85 per channel)
+#define ADC_CAPTURE_RING_SAMPLES ((1u << ADC_CAPTURE_RING_BITS) / 2)
+#define ADC_CAPTURE_MAX_AVERAGE 64    // Keeps averaged samples well clear of the DMA write pointer
+
+#define ADC_CAPTURE_MAX_RATE 500000   // Samples per second over all channels (96 ADC clocks each)
+
+// Return codes
+#define ADC_CAPTURE_OK 0
+#define ADC_CAPTURE_BAD_RATE -1       // Rate of 0 or above ADC_CAPTURE_MAX_RATE
+#define ADC_CAPTURE_NO_DMA -2         // No free DMA channel
+
+/**
+ * @brief Acquisition counters
+ */
+typedef struct {
+    uint64_t samples;                 // Samples written to the ring since adc_capture_init()
+    uint32_t samples_per_second;      // Measured since the previous adc_capture_get_stats() call
+    uint32_t overflows;               // ADC FIFO overflows (each one restarts the capture)
+} adc_capture_stats_t;
+
+/**
+ * @brief Configures the ADC, the sensor inputs and DMA, and starts capturing
+ *
+ * @param sample_rate_hz Conversions per second over all channels
+ *                       (each channel gets a third of it)
+ * @return ADC_CAPTURE_OK, ADC_CAPTURE_BAD_RATE or ADC_CAPTURE_NO_DMA
+ */
+int adc_capture_init(uint32_t sample_rate_hz);
+
+/**
+ * @brief Most recent sample of a channel (12 bits), 0 before its first conversion.
+ *        Right after an overflow restart, until the new run has converted the
+ *        channel (a few conversions), the value returned by the previous call
+ *
+ * @param channel ADC_CAPTURE_CH_X, ADC_CAPTURE_CH_Y or ADC_CAPTURE_CH_TEMP
+ */
+uint16_t adc_capture_latest(uint8_t channel);
+
+/**
+ * @brief Average of the last `count` samples of a channel (1..ADC_CAPTURE_MAX_AVERAGE),
+ *        fewer while the capture has just started or restarted (0 with none)
+ */
+uint16_t adc_capture_average(uint8_t channel, uint16_t count);
+
+/**
+ * @brief Copies the last `count` samples of a channel (at most ADC_CAPTURE_MAX_AVERAGE),
+ *        oldest first, e.g. to feed a filter
+ *
+ * @return Number of samples copied (fewer while the capture has just started or restarted)
+ */
+uint16_t adc_capture_recent(uint8_t channel, uint16_t *out, uint16_t count);
+
+/**
+ * @brief Reads the counters (overflows are detected and recovered by the reads,
+ *        which may run in the main loop and in interrupts of the same core)
+ */
+void adc_capture_get_stats(adc_capture_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
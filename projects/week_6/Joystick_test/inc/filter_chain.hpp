@@ -0,0 +1,187 @@
+// Embarcatech, April 2025 - Integer filter chain (C++17)
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Streaming filters for joystick and sensor samples, composed at compile
+    time: a chain is a type listing its stages, and running it is a fold
+    over them, so the whole chain inlines into one loop with no function
+    pointers and no virtual calls.
+
+    Key Features:
+    - Integer only (int32_t samples): no soft-float on the Cortex-M0+
+    - Stages: median_of<N>, normalize (center/extent), deadzone, ema<K>,
+      slew_limit, hysteresis_quantize
+    - Each stage keeps its own state; parameters are set at run time
+      (e.g. the joystick center measured at power-up)
+    - No dependency on the Pico SDK: runs and is benchmarked on the host
+
+    Usage:
+        filt::chain<filt::median_of<3>, filt::normalize, filt::deadzone, filt::ema<2>> axis{
+            {}, filt::normalize(2048, 2048, 1000), filt::deadzone(40, 1000), {} };
+        int32_t x = axis(adc_value);           // One sample
+        axis.run(dma_buffer, out, 256);        // A block
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stddef.h>   // size_t
+#include <tuple>      // std::tuple, std::get
+#include <utility>    // std::index_sequence
+
+namespace filt {
+
+// Median of the last N samples (N odd): removes isolated spikes, keeps edges
+template <int N>
+struct median_of {
+    static_assert(N >= 3 && N % 2 == 1 && N <= 9, "median_of<N>: N must be odd, 3..9");
+    int32_t window[N] = {};
+    int index = 0;
+    int filled = 0;
+
+    int32_t operator()(int32_t x) {
+        window[index] = x;
+        index = index + 1 == N ? 0 : index + 1;
+        if (filled < N && ++filled < N) {
+            return x;                    // Window still filling: pass through
+        }
+        if constexpr (N == 3) {
+            int32_t a = window[0], b = window[1], c = window[2];
+            int32_t lo = a < b ? a : b, hi = a < b ? b : a;
+            return c < lo ? lo : c > hi ? hi : c;
+        } else {
+            int32_t sorted[N];           // Insertion sort of a copy: N <= 9
+            for (int i = 0; i < N; i++) {
+                int32_t v = window[i];
+                int j = i;
+                for (; j > 0 && sorted[j - 1] > v; j--) {
+                    sorted[j] = sorted[j - 1];
+                }
+                sorted[j] = v;
+            }
+            return sorted[N / 2];
+        }
+    }
+};
+
+// (x - center) scaled so +-extent maps to +-out_max, clamped
+struct normalize {
+    int32_t center;
+    int32_t out_max;
+    int32_t scale_q16;                   // out_max / extent in Q16 (no divide per sample)
+
+    normalize(int32_t center_ = 2048, int32_t extent = 2048, int32_t out_max_ = 1000)
+        : center(center_), out_max(out_max_),
+          scale_q16(static_cast<int32_t>((static_cast<int64_t>(out_max_) << 16) / (extent > 0 ? extent : 1))) {}
+
+    int32_t operator()(int32_t x) const {
+        int32_t y = static_cast<int32_t>((static_cast<int64_t>(x - center) * scale_q16 + 0x8000) >> 16);
+        return y > out_max ? out_max : y < -out_max ? -out_max : y;
+    }
+};
+
+// 0 within +-width, shifted by width outside (no jump at the edge); expects a signed, centered input.
+// With out_max, the remaining width..out_max is stretched back to 0..out_max, so full deflection
+// still reads +-out_max
+struct deadzone {
+    int32_t width;
+    int32_t scale_q16;                   // out_max / (out_max - width) in Q16, 1.0 without out_max
+
+    explicit deadzone(int32_t width_ = 0, int32_t out_max = 0)
+        : width(width_),
+          scale_q16(out_max > width_ ? static_cast<int32_t>((static_cast<int64_t>(out_max) << 16) / (out_max - width_))
+                                     : 1 << 16) {}
+
+    int32_t operator()(int32_t x) const {
+        int32_t y = x > width ? x - width : x < -width ? x + width : 0;
+        return static_cast<int32_t>((static_cast<int64_t>(y) * scale_q16 + 0x8000) >> 16);
+    }
+};
+
+// Exponential moving average, y += (x - y) / 2^K, with 8 fraction bits of state
+template <int K>
+struct ema {
+    static_assert(K >= 1 && K <= 12, "ema<K>: K must be 1..12");
+    int32_t acc = 0;
+    bool primed = false;
+
+    int32_t operator()(int32_t x) {
+        if (!primed) {
+            acc = x * 256;               // Starts at the first sample, not at 0
+            primed = true;
+        }
+        acc += (x * 256 - acc) >> K;
+        return (acc + 128) >> 8;
+    }
+};
+
+// Output moves at most max_step per sample toward the input
+struct slew_limit {
+    int32_t max_step;
+    int32_t y = 0;
+    bool primed = false;
+
+    explicit slew_limit(int32_t max_step_ = 1) : max_step(max_step_) {}
+
+    int32_t operator()(int32_t x) {
+        if (!primed) {
+            y = x;
+            primed = true;
+        }
+        int32_t d = x - y;
+        y += d > max_step ? max_step : d < -max_step ? -max_step : d;
+        return y;
+    }
+};
+
+// Quantizes to multiples of step; a new level needs the input past the
+// level's midpoint by band, so jitter around a boundary does not flicker
+struct hysteresis_quantize {
+    int32_t step;
+    int32_t band;
+    int32_t level = 0;                   // Current output / step
+
+    explicit hysteresis_quantize(int32_t step_ = 1, int32_t band_ = 0) : step(step_ > 0 ? step_ : 1), band(band_) {}
+
+    int32_t operator()(int32_t x) {
+        int32_t limit = step / 2 + band;
+        while (x > level * step + limit) {
+            level++;
+        }
+        while (x < level * step - limit) {
+            level--;
+        }
+        return level * step;
+    }
+};
+
+/**
+ * @brief Stages applied in order, each to the previous one's output
+ */
+template <typename... Stages>
+struct chain {
+    std::tuple<Stages...> stages;
+
+    chain() = default;
+    explicit chain(Stages... s) : stages(s...) {}
+
+    int32_t operator()(int32_t x) {
+        return apply(x, std::index_sequence_for<Stages...>{});
+    }
+
+    // Block of raw samples (e.g. a DMA buffer) to filtered samples
+    void run(const uint16_t *in, int16_t *out, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = static_cast<int16_t>((*this)(in[i]));
+        }
+    }
+
+  private:
+    template <size_t... I>
+    int32_t apply(int32_t x, std::index_sequence<I...>) {
+        ((x = std::get<I>(stages)(x)), ...);
+        return x;
+    }
+};
+
+}  // namespace filt
@@ -0,0 +1,37 @@
+// Embarcatech, April 2025 - Joystick axis filter (C interface)
+// Author: Filipe Alves de Sousa
+
+#include <new>                 // Placement new
+#include "filter_chain.hpp"
+#include "joystick_filter.h"
+
+namespace {
+
+using axis_chain = filt::chain<filt::median_of<3>, filt::normalize, filt::deadzone, filt::ema<2>>;
+
+static_assert(sizeof(axis_chain) <= sizeof(joystick_filter_t::storage), "JOYSTICK_FILTER_STORAGE_WORDS too small");
+static_assert(alignof(axis_chain) <= alignof(joystick_filter_t), "joystick_filter_t under-aligned");
+
+axis_chain &chain_of(joystick_filter_t *filter) {
+    return *reinterpret_cast<axis_chain *>(filter->storage);
+}
+
+}  // namespace
+
+extern "C" {
+
+void joystick_filter_init(joystick_filter_t *filter, const joystick_filter_config_t *config) {
+    new (filter->storage) axis_chain(filt::median_of<3>{},
+                                     filt::normalize(config->center, config->extent, config->out_max),
+                                     filt::deadzone(config->deadzone, config->out_max), filt::ema<2>{});
+}
+
+int16_t joystick_filter_step(joystick_filter_t *filter, uint16_t raw) {
+    return static_cast<int16_t>(chain_of(filter)(raw));
+}
+
+void joystick_filter_block(joystick_filter_t *filter, const uint16_t *in, int16_t *out, size_t n) {
+    chain_of(filter).run(in, out, n);
+}
+
+}  // extern "C"
@@ -0,0 +1,63 @@
+// Embarcatech, April 2025 - Joystick axis filter (C interface)
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    C wrapper around one filt::chain (filter_chain.hpp) tuned for a
+    joystick axis: median of 3 (spikes), normalize to +-out_max around
+    the measured center, deadzone (rest jitter, the rest of the travel
+    stretched back to +-out_max), EMA with 1/4 weight.
+    The chain is instantiated in joystick_filter.cpp; C code only sees
+    an opaque, statically allocated state.
+
+    Key Features:
+    - Same inlined loop as the C++ chain, callable from C
+    - Single-sample and block (DMA buffer) entry points
+    - Parameters at run time, e.g. the center read at power-up
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stddef.h>   // size_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define JOYSTICK_FILTER_STORAGE_WORDS 16   // Room for the chain state (checked at compile time)
+
+/**
+ * @brief Axis calibration and shaping
+ */
+typedef struct {
+    int32_t center;      // Raw reading at rest (~2048)
+    int32_t extent;      // Raw distance from center to full deflection (~2048)
+    int32_t out_max;     // Output at full deflection (e.g. 1000)
+    int32_t deadzone;    // Output units ignored around the center
+} joystick_filter_config_t;
+
+/**
+ * @brief Opaque filter state
+ */
+typedef struct {
+    uint32_t storage[JOYSTICK_FILTER_STORAGE_WORDS];
+} joystick_filter_t;
+
+/**
+ * @brief Builds the chain with the given parameters (clears its state)
+ */
+void joystick_filter_init(joystick_filter_t *filter, const joystick_filter_config_t *config);
+
+/**
+ * @brief Filters one raw 12-bit reading; returns -out_max..out_max
+ */
+int16_t joystick_filter_step(joystick_filter_t *filter, uint16_t raw);
+
+/**
+ * @brief Filters n raw readings into out
+ */
+void joystick_filter_block(joystick_filter_t *filter, const uint16_t *in, int16_t *out, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
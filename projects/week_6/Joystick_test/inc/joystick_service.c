@@ -0,0 +1,127 @@
+// Embarcatech, April 2025 - Event-driven joystick service
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    The tick runs in the timer interrupt: it only filters two samples,
+    compares them with the last reported values and reads one GPIO, so
+    it takes a few microseconds. Events go through a pico/util queue,
+    which is safe between the interrupt and the main loop; its
+    producer wakes a core sleeping in WFE.
+    ======================================================================== */
+
+#include "pico/stdlib.h"       // Pico SDK utilities (GPIO, time, repeating timer)
+#include "pico/util/queue.h"   // Interrupt-safe event queue
+#include "adc_capture.h"
+#include "joystick_service.h"
+
+#define CALIBRATION_SAMPLES 64            // Samples averaged to find the rest position
+
+static joystick_filter_t filter_x, filter_y;
+static repeating_timer_t tick_timer;
+static queue_t events;
+static uint8_t button_pin;
+static uint32_t debounce_us;
+static int16_t move_threshold;
+static int16_t out_max;
+static int16_t reported_x, reported_y;    // Axis values of the last queued event
+static uint8_t button;                    // Debounced button state
+static uint64_t last_edge_us;
+static volatile uint32_t dropped;         // Failed queue adds (each one retried on the next tick)
+
+// Queues an event; when the queue is full the change is kept pending and retried on the next tick
+static bool push_event(uint8_t type, uint8_t pressed, int16_t x, int16_t y, uint64_t now) {
+    joystick_event_t event = { now, x, y, type, pressed };
+    if (!queue_try_add(&events, &event)) {
+        dropped++;
+        return false;
+    }
+    reported_x = x;
+    reported_y = y;
+    return true;
+}
+
+// Movement worth reporting: past the threshold, or onto rest or a full-deflection stop (the
+// filter's deadzone stretches the travel, so a stick held at a stop settles on exactly +-out_max)
+static bool axis_changed(int16_t value, int16_t reported) {
+    int16_t d = value - reported;
+    if (d == 0) {
+        return false;
+    }
+    return d >= move_threshold || d <= -move_threshold || value == 0 || value >= out_max || value <= -out_max;
+}
+
+static bool tick(repeating_timer_t *timer) {
+    (void)timer;
+    uint64_t now = time_us_64();
+    int16_t x = joystick_filter_step(&filter_x, adc_capture_latest(ADC_CAPTURE_CH_X));
+    int16_t y = joystick_filter_step(&filter_y, adc_capture_latest(ADC_CAPTURE_CH_Y));
+
+    uint8_t pressed = !gpio_get(button_pin);  // Active low
+    if (pressed != button && now - last_edge_us >= debounce_us) {
+        if (push_event(pressed ? JOYSTICK_EVENT_PRESS : JOYSTICK_EVENT_RELEASE, pressed, x, y, now)) {
+            button = pressed;
+            last_edge_us = now;
+        }
+    } else if (axis_changed(x, reported_x) || axis_changed(y, reported_y)) {
+        push_event(JOYSTICK_EVENT_MOVE, button, x, y, now);
+    }
+    return true;  // Keep repeating
+}
+
+int joystick_service_init(const joystick_service_config_t *config) {
+    if (config->tick_us == 0 || config->move_threshold < 1) {
+        return JOYSTICK_SERVICE_BAD_CONFIG;
+    }
+    button_pin = config->button_pin;
+    debounce_us = config->debounce_us;
+    move_threshold = config->move_threshold;
+    out_max = (int16_t)config->axis.out_max;
+
+    gpio_init(button_pin);
+    gpio_set_dir(button_pin, GPIO_IN);
+    gpio_pull_up(button_pin);
+
+    joystick_filter_config_t axis = config->axis;
+    bool measure = axis.center == 0;
+    if (measure) {
+        sleep_ms(10);  // Lets the capture ring fill with samples of the stick at rest
+        axis.center = adc_capture_average(ADC_CAPTURE_CH_X, CALIBRATION_SAMPLES);
+    }
+    joystick_filter_init(&filter_x, &axis);
+    if (measure) {
+        axis.center = adc_capture_average(ADC_CAPTURE_CH_Y, CALIBRATION_SAMPLES);
+    }
+    joystick_filter_init(&filter_y, &axis);
+
+    reported_x = 0;
+    reported_y = 0;
+    button = !gpio_get(button_pin);
+    last_edge_us = time_us_64();
+    dropped = 0;
+    queue_init(&events, sizeof(joystick_event_t), JOYSTICK_SERVICE_QUEUE_LENGTH);
+
+    // Negative period: ticks are spaced from start to start, not from end to start
+    if (!add_repeating_timer_us(-(int64_t)config->tick_us, tick, NULL, &tick_timer)) {
+        queue_free(&events);
+        return JOYSTICK_SERVICE_NO_TIMER;
+    }
+    return JOYSTICK_SERVICE_OK;
+}
+
+bool joystick_service_poll(joystick_event_t *event) {
+    return queue_try_remove(&events, event);
+}
+
+bool joystick_service_wait(joystick_event_t *event, uint32_t timeout_ms) {
+    absolute_time_t deadline = make_timeout_time_ms(timeout_ms);
+    while (!queue_try_remove(&events, event)) {
+        if (best_effort_wfe_or_timeout(deadline)) {  // Sleeps until an interrupt/event or the deadline
+            return queue_try_remove(&events, event);
+        }
+    }
+    return true;
+}
+
+uint32_t joystick_service_dropped(void) {
+    return dropped;
+}
@@ -0,0 +1,98 @@
+// Embarcatech, April 2025 - Event-driven joystick service
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Samples the joystick in the background and reports only what changed.
+    A repeating timer (1 kHz by default) takes the newest X/Y samples
+    from the ADC capture, runs them through the axis filter chain and
+    debounces the button; it queues an event when an axis moved by more
+    than a threshold or the button was pressed or released. The main
+    loop sleeps (WFE) in joystick_service_wait() until one arrives.
+
+    Key Features:
+    - Input latency of about one tick (1 ms) instead of the old 500 ms poll
+    - Nothing to do in the main loop while the stick is idle: the tick
+      filters two samples and returns, and no event is queued
+    - Button edges debounced by a lockout after each accepted edge
+    - Events carry their timestamp, so the consumer can measure latency
+    - Needs adc_capture_init() to have been called first
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool
+#include "joystick_filter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define JOYSTICK_SERVICE_QUEUE_LENGTH 16   // Events waiting for the main loop
+
+// Return codes
+#define JOYSTICK_SERVICE_OK 0
+#define JOYSTICK_SERVICE_BAD_CONFIG -1     // Tick of 0 or threshold below 1
+#define JOYSTICK_SERVICE_NO_TIMER -2       // No free alarm for the repeating timer
+
+/**
+ * @brief What an event reports
+ */
+typedef enum {
+    JOYSTICK_EVENT_MOVE,                   // An axis moved by at least the threshold (or back to rest)
+    JOYSTICK_EVENT_PRESS,                  // Button pressed
+    JOYSTICK_EVENT_RELEASE                 // Button released
+} joystick_event_type_t;
+
+/**
+ * @brief One input event, with the full joystick state at that moment
+ */
+typedef struct {
+    uint64_t time_us;                      // When the tick detected it (time_us_64())
+    int16_t x;                             // Filtered X axis, -out_max..out_max
+    int16_t y;                             // Filtered Y axis, -out_max..out_max
+    uint8_t type;                          // joystick_event_type_t
+    uint8_t button;                        // 1 while pressed
+} joystick_event_t;
+
+/**
+ * @brief Service parameters
+ */
+typedef struct {
+    uint8_t button_pin;                    // GPIO of the button (active low, pull-up enabled here)
+    uint32_t tick_us;                      // Sampling period (e.g. 1000)
+    uint32_t debounce_us;                  // Edges ignored after an accepted one (e.g. 20000)
+    int16_t move_threshold;                // Change in output units that makes a MOVE event
+    joystick_filter_config_t axis;         // Filter of both axes; center 0 = measure at init
+} joystick_service_config_t;
+
+/**
+ * @brief Calibrates the axes, configures the button and starts the tick
+ *
+ * @return JOYSTICK_SERVICE_OK, JOYSTICK_SERVICE_BAD_CONFIG or JOYSTICK_SERVICE_NO_TIMER
+ */
+int joystick_service_init(const joystick_service_config_t *config);
+
+/**
+ * @brief Takes the next event without waiting
+ *
+ * @return false if there is none
+ */
+bool joystick_service_poll(joystick_event_t *event);
+
+/**
+ * @brief Sleeps until an event arrives or timeout_ms passes
+ *
+ * @return false on timeout
+ */
+bool joystick_service_wait(joystick_event_t *event, uint32_t timeout_ms);
+
+/**
+ * @brief Times the queue was full when a change was detected (the change
+ *        is reported on a later tick, so button edges are not lost)
+ */
+uint32_t joystick_service_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,195 @@
+// Embarcatech, April 2025 - Scrolling chart widget for the SSD1306
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Pixels are stored page by page, `width` bytes per page, so column x
+    of page p is pixels[p * width + x]. The newest sample sits in column
+    width - 1 and sample k (counting back from the newest) in column
+    width - 1 - k; while the ring is filling up, the left columns stay
+    empty. The ring holds width + 1 samples: the extra one is the sample
+    that scrolled out last, which the oldest column is joined to.
+    Scrolling by n columns is one memmove() per page.
+    ======================================================================== */
+
+#include <string.h>   // memmove(), memset()
+#include "oled_chart.h"
+
+// Next ring slot
+static uint8_t ring_next(const oled_chart_t *chart, uint8_t slot) {
+    return (uint8_t)(slot == chart->config.width ? 0 : slot + 1);
+}
+
+// Ring slot of the sample `back` places before the next one (1 = newest)
+static uint8_t ring_back(const oled_chart_t *chart, uint8_t back) {
+    int slot = chart->head - back;
+    return (uint8_t)(slot < 0 ? slot + chart->config.width + 1 : slot);
+}
+
+// Row of a value in the region: 0 is the top (max), rows - 1 the bottom (min)
+static uint8_t value_row(const oled_chart_t *chart, int16_t value) {
+    int32_t bottom = chart->config.pages * 8 - 1;
+    int32_t span = (int32_t)chart->max - chart->min;
+    int32_t offset = (int32_t)value - chart->min;
+    if (offset <= 0) {
+        return (uint8_t)bottom;
+    }
+    if (offset >= span) {
+        return 0;
+    }
+    return (uint8_t)(bottom - (offset * bottom + span / 2) / span);
+}
+
+// Writes column x with rows top..bottom set, one byte per page
+static void draw_span(oled_chart_t *chart, uint8_t x, int top, int bottom) {
+    uint8_t *byte = &chart->pixels[x];
+    for (int page_top = 0; page_top < chart->config.pages * 8; page_top += 8, byte += chart->config.width) {
+        int first = top - page_top;          // Rows of the span inside this page
+        int last = bottom - page_top;
+        if (last < 0 || first > 7) {
+            *byte = 0;
+            continue;
+        }
+        first = first < 0 ? 0 : first;
+        last = last > 7 ? 7 : last;
+        *byte = (uint8_t)((0xFFu >> (7 - last)) & (0xFFu << first));
+    }
+}
+
+// Draws one sample in column x, joined to the previous sample's row when there is one
+static void draw_sample(oled_chart_t *chart, uint8_t x, int16_t value, bool joined) {
+    uint8_t row = value_row(chart, value);
+    if (chart->config.style == OLED_CHART_FILL) {
+        draw_span(chart, x, row, chart->config.pages * 8 - 1);
+    } else if (joined) {
+        draw_span(chart, x, row < chart->last_row ? row : chart->last_row, row > chart->last_row ? row : chart->last_row);
+    } else {
+        draw_span(chart, x, row, row);
+    }
+    chart->last_row = row;
+}
+
+// Samples on screen
+static uint8_t shown(const oled_chart_t *chart) {
+    return chart->count < chart->config.width ? chart->count : chart->config.width;
+}
+
+// Range of the samples on screen, widened to auto_span and padded by 1/8 so noise does not refit it at once
+static void fit_range(oled_chart_t *chart) {
+    int32_t low = chart->samples[ring_back(chart, 1)];
+    int32_t high = low;
+    for (uint8_t back = 2; back <= shown(chart); back++) {
+        int16_t value = chart->samples[ring_back(chart, back)];
+        low = value < low ? value : low;
+        high = value > high ? value : high;
+    }
+    int32_t pad = (high - low) / 8;
+    low -= pad;
+    high += pad;
+    if (high - low < chart->config.auto_span) {
+        int32_t mid = low + (high - low) / 2;
+        low = mid - chart->config.auto_span / 2;
+        high = low + chart->config.auto_span;
+    }
+    low = low < INT16_MIN ? INT16_MIN : low;
+    high = high > INT16_MAX ? INT16_MAX : high;
+    if (low != chart->min || high != chart->max) {
+        chart->min = (int16_t)low;
+        chart->max = (int16_t)high;
+        chart->redraw = true;
+    }
+    chart->since_fit = 0;
+}
+
+int oled_chart_init(oled_chart_t *chart, const oled_chart_config_t *config) {
+    if (config->width == 0 || config->pages == 0 || config->column + config->width > OLED_CHART_MAX_WIDTH ||
+        config->page + config->pages > OLED_CHART_MAX_PAGES) {
+        return OLED_CHART_BAD_REGION;
+    }
+    if (config->auto_span < 0 || (config->auto_span == 0 && config->max <= config->min)) {
+        return OLED_CHART_BAD_RANGE;
+    }
+    memset(chart, 0, sizeof(*chart));
+    chart->config = *config;
+    chart->min = config->min;
+    chart->max = config->max > config->min ? config->max : (int16_t)(config->min + 1);
+    return OLED_CHART_OK;
+}
+
+void oled_chart_add(oled_chart_t *chart, int16_t value) {
+    if (chart->count && value == chart->samples[ring_back(chart, 1)]) {
+        if (chart->flat < 2 * chart->config.width + 1) {   // Enough for any number of pending samples
+            chart->flat++;
+        }
+    } else {
+        chart->flat = 1;
+    }
+    chart->samples[chart->head] = value;
+    chart->head = ring_next(chart, chart->head);
+    if (chart->count <= chart->config.width) {
+        chart->count++;
+    }
+    if (chart->pending < chart->config.width) {
+        chart->pending++;
+    }
+    if (chart->config.auto_span) {
+        // Refit when a sample leaves the range, and once per screen so the range can shrink again
+        if (chart->count == 1 || value < chart->min || value > chart->max || ++chart->since_fit >= chart->config.width) {
+            fit_range(chart);
+        }
+    }
+}
+
+bool oled_chart_update(oled_chart_t *chart) {
+    uint8_t width = chart->config.width;
+    uint8_t fresh = chart->pending;
+    if (chart->redraw || fresh >= width) {       // pending saturates at width: the count may be short
+        oled_chart_redraw(chart);
+        return true;
+    }
+    if (fresh == 0) {
+        return false;
+    }
+    // Flat line before and after: the screen shows samples back 1..width + fresh (plus the one
+    // each oldest column joins to), all equal, so scrolling would give the same pixels
+    if (chart->flat > width + fresh) {
+        chart->pending = 0;
+        return false;
+    }
+
+    uint8_t *row = chart->pixels;                // Scroll: one memmove per page
+    for (uint8_t page = 0; page < chart->config.pages; page++, row += width) {
+        memmove(row, row + fresh, width - fresh);
+    }
+    bool joined = chart->count > fresh;          // An older sample is on screen to join to
+    uint8_t slot = ring_back(chart, fresh);
+    for (uint8_t x = (uint8_t)(width - fresh); x < width; x++, slot = ring_next(chart, slot)) {
+        draw_sample(chart, x, chart->samples[slot], joined);
+        joined = true;
+    }
+    chart->pending = 0;
+    return true;
+}
+
+void oled_chart_redraw(oled_chart_t *chart) {
+    memset(chart->pixels, 0, oled_chart_bytes(chart));
+    uint8_t columns = shown(chart);
+    bool joined = chart->count > columns;        // The sample that scrolled out is still in the ring
+    if (joined) {
+        chart->last_row = value_row(chart, chart->samples[ring_back(chart, columns + 1)]);
+    }
+    uint8_t slot = ring_back(chart, columns);
+    for (uint8_t x = (uint8_t)(chart->config.width - columns); x < chart->config.width; x++) {
+        draw_sample(chart, x, chart->samples[slot], joined);
+        slot = ring_next(chart, slot);
+        joined = true;
+    }
+    chart->pending = 0;
+    chart->redraw = false;
+}
+
+void oled_chart_set_range(oled_chart_t *chart, int16_t min, int16_t max) {
+    chart->config.auto_span = 0;
+    chart->min = min;
+    chart->max = max > min ? max : (int16_t)(min + 1);
+    chart->redraw = true;
+}
@@ -0,0 +1,196 @@
+// Embarcatech, April 2025 - Online sensor statistics
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    P² (Jain & Chlamtac, 1985) keeps five markers: min, p/2, p, (1+p)/2
+    quantiles and max. Each reading moves the marker positions; a marker
+    more than one position away from where it should be is moved one
+    step, its height adjusted with a parabolic (or, if that leaves the
+    neighbours' range, linear) interpolation. Heights are Q8, desired
+    positions Q16. All divisions are 32- or 64-bit integer divisions,
+    which the RP2040 runs on its hardware divider.
+    ======================================================================== */
+
+#include <string.h>    // memset()
+#include "sensor_stats.h"
+
+#define Q16_ONE 65536
+
+int sensor_stats_init(sensor_stats_t *stats, const sensor_stats_config_t *config) {
+    if (config->hist_bins == 0 || config->hist_bins > SENSOR_STATS_MAX_BINS || config->hist_bin_width < 1) {
+        return SENSOR_STATS_BAD_BINS;
+    }
+    if (config->percentile_q16 == 0) {
+        return SENSOR_STATS_BAD_PERCENTILE;
+    }
+    if (config->rate_shift > 12) {
+        return SENSOR_STATS_BAD_SHIFT;
+    }
+    stats->config = *config;
+    sensor_stats_reset(stats);
+    return SENSOR_STATS_OK;
+}
+
+void sensor_stats_reset(sensor_stats_t *stats) {
+    sensor_stats_config_t config = stats->config;
+    memset(stats, 0, sizeof(*stats));
+    stats->config = config;
+}
+
+// Integer square root (floor) of a 64-bit value
+static uint32_t isqrt64(uint64_t v) {
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+// Marker i moves one step in direction d (+1/-1): parabolic prediction of its new height
+static int32_t p2_parabolic(const sensor_stats_t *s, int i, int32_t d) {
+    const int32_t *q = s->p2_height;
+    const int32_t *n = s->p2_pos;
+    int64_t up = (int64_t)(n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]);
+    int64_t down = (int64_t)(n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]);
+    return (int32_t)(q[i] + d * (up + down) / (n[i + 1] - n[i - 1]));
+}
+
+static void p2_add(sensor_stats_t *s, int32_t x_q8) {
+    int32_t *q = s->p2_height;
+    int32_t *n = s->p2_pos;
+    uint32_t p = s->config.percentile_q16;
+
+    if (s->count <= 5) {                       // First five readings: kept sorted
+        int i = (int)s->count - 1;
+        for (; i > 0 && q[i - 1] > x_q8; i--) {
+            q[i] = q[i - 1];
+        }
+        q[i] = x_q8;
+        if (s->count == 5) {
+            for (int k = 0; k < 5; k++) {
+                n[k] = k;
+            }
+            s->p2_desired[0] = 0;
+            s->p2_desired[1] = 2 * (int64_t)p;
+            s->p2_desired[2] = 4 * (int64_t)p;
+            s->p2_desired[3] = 2 * Q16_ONE + 2 * (int64_t)p;
+            s->p2_desired[4] = 4 * Q16_ONE;
+        }
+        return;
+    }
+
+    int k;                                     // Cell the reading falls in
+    if (x_q8 < q[0]) {
+        q[0] = x_q8;
+        k = 0;
+    } else if (x_q8 >= q[4]) {
+        q[4] = x_q8;
+        k = 3;
+    } else {
+        for (k = 0; x_q8 >= q[k + 1]; k++) {
+        }
+    }
+    for (int i = k + 1; i < 5; i++) {
+        n[i]++;
+    }
+    s->p2_desired[1] += p / 2;
+    s->p2_desired[2] += p;
+    s->p2_desired[3] += (Q16_ONE + p) / 2;
+    s->p2_desired[4] += Q16_ONE;
+
+    for (int i = 1; i <= 3; i++) {
+        int64_t off = s->p2_desired[i] - ((int64_t)n[i] << 16);
+        if ((off >= Q16_ONE && n[i + 1] - n[i] > 1) || (off <= -Q16_ONE && n[i - 1] - n[i] < -1)) {
+            int32_t d = off > 0 ? 1 : -1;
+            int32_t h = p2_parabolic(s, i, d);
+            if (h <= q[i - 1] || h >= q[i + 1]) {
+                h = q[i] + d * (q[i + d] - q[i]) / (n[i + d] - n[i]);   // Linear
+            }
+            q[i] = h;
+            n[i] += d;
+        }
+    }
+}
+
+void sensor_stats_add(sensor_stats_t *stats, int32_t value, uint32_t time_ms) {
+    stats->count++;
+    if (stats->count == 1) {
+        stats->min = value;
+        stats->max = value;
+    } else {
+        stats->min = value < stats->min ? value : stats->min;
+        stats->max = value > stats->max ? value : stats->max;
+
+        uint32_t dt = time_ms - stats->last_time_ms;
+        if (dt > 0) {
+            int64_t rate = ((int64_t)(value - stats->last) * 1000 * 256) / dt;
+            rate = rate > INT32_MAX ? INT32_MAX : rate < -INT32_MAX ? -INT32_MAX : rate;
+            if (stats->count == 2) {
+                stats->rate_q8 = (int32_t)rate;  // First estimate: no history to smooth with
+            } else {
+                stats->rate_q8 += (int32_t)((rate - stats->rate_q8) >> stats->config.rate_shift);
+            }
+        }
+    }
+    stats->last = value;
+    stats->last_time_ms = time_ms;
+
+    // Welford: mean += delta / n, M2 += delta * (x - new mean). The mean keeps 24 fraction bits so
+    // delta / n does not round to 0 on long runs; M2 uses the differences at 12 fraction bits
+    int64_t x_q24 = (int64_t)value * (1 << 24);
+    int64_t n = stats->count;
+    int64_t delta = x_q24 - stats->mean_q24;
+    stats->mean_q24 += (delta >= 0 ? delta + n / 2 : delta - n / 2) / n;
+    stats->m2_q8 += ((delta >> 12) * ((x_q24 - stats->mean_q24) >> 12)) >> 16;
+
+    const sensor_stats_config_t *c = &stats->config;
+    if (value < c->hist_min) {
+        stats->below++;
+    } else {
+        uint32_t bin = (uint32_t)(value - c->hist_min) / (uint32_t)c->hist_bin_width;
+        if (bin < c->hist_bins) {
+            stats->hist[bin]++;
+        } else {
+            stats->above++;
+        }
+    }
+
+    p2_add(stats, value * 256);
+}
+
+int32_t sensor_stats_mean_q8(const sensor_stats_t *stats) {
+    return (int32_t)((stats->mean_q24 + (1 << 15)) >> 16);
+}
+
+int32_t sensor_stats_stddev_q8(const sensor_stats_t *stats) {
+    if (stats->count < 2 || stats->m2_q8 <= 0) {
+        return 0;
+    }
+    uint64_t variance_q8 = (uint64_t)stats->m2_q8 / (stats->count - 1);
+    return (int32_t)isqrt64(variance_q8 << 8);   // sqrt(var * 2^16) = stddev * 2^8
+}
+
+int32_t sensor_stats_rate_q8(const sensor_stats_t *stats) {
+    return stats->rate_q8;
+}
+
+int32_t sensor_stats_percentile_q8(const sensor_stats_t *stats) {
+    if (stats->count == 0) {
+        return 0;
+    }
+    if (stats->count < 5) {                     // Sorted readings: nearest rank
+        uint32_t rank = (uint32_t)(((uint64_t)stats->config.percentile_q16 * (stats->count - 1) + Q16_ONE / 2) >> 16);
+        return stats->p2_height[rank];
+    }
+    return stats->p2_height[2];
+}
@@ -0,0 +1,112 @@
+// Embarcatech, April 2025 - Online sensor statistics
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Running statistics of a stream of integer readings (centi-degrees,
+    ADC codes, microseconds...), updated in O(1) per sample with constant
+    memory and no sample history, in integer and fixed-point arithmetic
+    only (no soft-float on the Cortex-M0+).
+
+    Key Features:
+    - Count, min, max and last value
+    - Mean and standard deviation (Welford's method, Q8 fixed point)
+    - Exponentially weighted rate of change, in units per second (Q8)
+    - Fixed-bin histogram with below/above counters
+    - One streaming percentile (P² algorithm, 5 markers), e.g. the 95th
+
+    Fixed point: results named *_q8 are value * 256. SENSOR_STATS_Q8_ROUND()
+    turns them back into input units.
+
+    Range: readings within +-2^20 and within 2^19 of each other. The
+    variance accumulator holds 2^35 readings of a signal spread over 1000.
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SENSOR_STATS_MAX_BINS 16          // Histogram bins
+#define SENSOR_STATS_Q8_ROUND(v) (((v) + 128) >> 8)   // Q8 to the nearest integer
+
+// Return codes
+#define SENSOR_STATS_OK 0
+#define SENSOR_STATS_BAD_BINS -1          // Bins of 0 or above SENSOR_STATS_MAX_BINS, or width below 1
+#define SENSOR_STATS_BAD_PERCENTILE -2    // Percentile of 0 (use the min instead)
+#define SENSOR_STATS_BAD_SHIFT -3         // Rate smoothing shift above 12
+
+/**
+ * @brief What to track besides the always-on moments
+ */
+typedef struct {
+    int32_t hist_min;                     // Lower edge of the first bin
+    int32_t hist_bin_width;               // Width of each bin (input units)
+    uint8_t hist_bins;                    // Bins in use (1..SENSOR_STATS_MAX_BINS)
+    uint8_t rate_shift;                   // Rate smoothing: weight 1/2^shift per sample (0 = no smoothing)
+    uint16_t percentile_q16;              // Percentile tracked, p * 65536 (e.g. 62259 = 0.95)
+} sensor_stats_config_t;
+
+/**
+ * @brief Accumulator state (~200 bytes)
+ */
+typedef struct {
+    sensor_stats_config_t config;
+    uint32_t count;                       // Samples added
+    int32_t min;
+    int32_t max;
+    int32_t last;
+    uint32_t last_time_ms;
+    int64_t mean_q24;                     // Running mean, Q24
+    int64_t m2_q8;                        // Sum of squared differences from the mean, Q8
+    int32_t rate_q8;                      // Smoothed change per second, Q8
+    uint32_t hist[SENSOR_STATS_MAX_BINS];
+    uint32_t below;                       // Samples under hist_min
+    uint32_t above;                       // Samples past the last bin
+    int32_t p2_height[5];                 // P² marker heights, Q8
+    int32_t p2_pos[5];                    // P² marker positions
+    int64_t p2_desired[5];                // P² desired positions, Q16
+} sensor_stats_t;
+
+/**
+ * @brief Checks the configuration and clears the accumulator
+ *
+ * @return SENSOR_STATS_OK, SENSOR_STATS_BAD_BINS, SENSOR_STATS_BAD_PERCENTILE or SENSOR_STATS_BAD_SHIFT
+ */
+int sensor_stats_init(sensor_stats_t *stats, const sensor_stats_config_t *config);
+
+/**
+ * @brief Clears every statistic, keeps the configuration
+ */
+void sensor_stats_reset(sensor_stats_t *stats);
+
+/**
+ * @brief Adds one reading taken at time_ms (used for the rate of change)
+ */
+void sensor_stats_add(sensor_stats_t *stats, int32_t value, uint32_t time_ms);
+
+/**
+ * @brief Mean of all readings, Q8 (0 before the first)
+ */
+int32_t sensor_stats_mean_q8(const sensor_stats_t *stats);
+
+/**
+ * @brief Sample standard deviation, Q8 (0 before the second reading)
+ */
+int32_t sensor_stats_stddev_q8(const sensor_stats_t *stats);
+
+/**
+ * @brief Smoothed rate of change in units per second, Q8
+ */
+int32_t sensor_stats_rate_q8(const sensor_stats_t *stats);
+
+/**
+ * @brief Estimate of the configured percentile, Q8 (exact while fewer than 5 readings)
+ */
+int32_t sensor_stats_percentile_q8(const sensor_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,58 @@
+// Embarcatech, April 2025 - SSD1306 number drawing without printf
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Draws numbers straight into the SSD1306 framebuffer: the digits come
+    from number_format.c (divide-free) and each one is stamped with
+    ssd1306_draw_char(), so a screen update needs no snprintf() and no
+    intermediate line buffer.
+
+    Every function returns the column after the last glyph, so a line is
+    built by chaining calls:
+        x = ssd1306_draw_fixed(buffer, 0, 0, centi, 2);   // "27.31"
+        ssd1306_draw_text(buffer, x, 0, " C");
+
+    Key Features:
+    - Unsigned, signed and fixed-point values (e.g. centi-degrees with
+      2 decimals), same text as printf "%u", "%d" and "%.2f"
+    - No float, no division, no formatting library
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_GLYPH_WIDTH 8            // Columns per character of the SSD1306 font
+
+/**
+ * @brief Draws a string at (x, y)
+ * @return Column after the last glyph
+ */
+int16_t ssd1306_draw_text(uint8_t *ssd, int16_t x, int16_t y, const char *text);
+
+/**
+ * @brief Draws an unsigned value ("%u")
+ * @return Column after the last glyph
+ */
+int16_t ssd1306_draw_uint(uint8_t *ssd, int16_t x, int16_t y, uint32_t value);
+
+/**
+ * @brief Draws a signed value ("%d")
+ * @return Column after the last glyph
+ */
+int16_t ssd1306_draw_int(uint8_t *ssd, int16_t x, int16_t y, int32_t value);
+
+/**
+ * @brief Draws value / 10^decimals with `decimals` digits after the point
+ *        (e.g. 2731 with 2 decimals is "27.31")
+ * @return Column after the last glyph
+ */
+int16_t ssd1306_draw_fixed(uint8_t *ssd, int16_t x, int16_t y, int32_t value, uint8_t decimals);
+
+#ifdef __cplusplus
+}
+#endif
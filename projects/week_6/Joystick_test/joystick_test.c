@@ -1,6 +1,6 @@
 // Embarcatech, April 2025 - "Joystick reader" --- Author: Filipe Alves de Sousa
 // Reads the digitally converted values of the joystick from the BitDogLab.
-// The values can be displayed on the terminal and on an OLED display.
+// The values can be displayed on the terminal and on an OLED display, with a scrolling chart of each axis.
 //----------------------------------------------------------------------------------
 
 #include <stdio.h>             // Standard library for input/output functions, e.g., printf().
@@ -10,6 +10,11 @@
 #include "hardware/gpio.h"     // Library for GPIO (General-Purpose Input/Output) pin control and functions.
 #include "hardware/i2c.h"      // Library for communication using I2C protocol.
 #include "inc/ssd1306.h"       // Library for controlling the OLED display SSD1306.
+#include "inc/adc_capture.h"   // Background ADC capture (round-robin + DMA) of the joystick axes.
+#include "inc/joystick_service.h" // Background joystick sampling that queues events on change.
+#include "inc/sensor_stats.h"  // Running statistics of the event latency (integer, O(1) per event).
+#include "inc/oled_chart.h"    // Scrolling charts of the axes (only the new columns are drawn).
+#include "inc/ssd1306_number.h" // Draws numbers straight into the OLED buffer (no snprintf).
 
 
 // === CONFIGURATIONS ===
@@ -18,14 +23,26 @@
 #define SDA_PIN 14               // GPIO pin for I2C data (SDA).
 #define SCL_PIN 15               // GPIO pin for I2C clock (SCL).
 #define I2C_PORT i2c1            // Defines the I2C port to be used (I2C1).
-#define I2C_SPEED 100000         // I2C communication speed set to 100 kHz.
+#define I2C_SPEED 400000         // I2C speed: 400 kHz (SSD1306 fast mode), a moving chart is flushed every 20 ms.
 
 #define VRX_PIN 26               // GPIO pin for the joystick X-axis ADC input.
 #define VRY_PIN 27               // GPIO pin for the joystick Y-axis ADC input.
 #define JOY_SW  22               // GPIO pin for the joystick button (switch).
 
-#define ADC_CH_X 0               // ADC channel for the X-axis.
-#define ADC_CH_Y 1               // ADC channel for the Y-axis.
+#define ADC_CH_X ADC_CAPTURE_CH_X // ADC channel for the X-axis.
+#define ADC_CH_Y ADC_CAPTURE_CH_Y // ADC channel for the Y-axis.
+#define ADC_SAMPLE_RATE 30000    // Conversions per second over X, Y and temperature (10 kHz each).
+#define AXIS_OUT_MAX 1000        // Filtered axis range: -1000 (full left/up) to 1000.
+#define AXIS_DEADZONE 40         // Filtered units ignored around the rest position.
+#define AXIS_THRESHOLD 20        // Filtered units an axis must move to raise an event.
+#define JOY_TICK_US 1000         // Joystick sampling period (1 kHz).
+#define JOY_DEBOUNCE_US 20000    // Button edges ignored for 20 ms after an accepted edge.
+#define STATS_PERIOD_MS 5000     // Prints the ADC capture counters when idle this long.
+#define LATENCY_BIN_US 500       // Latency histogram: 16 bins of 500 us (0 to 8 ms).
+#define CHART_PERIOD_MS 20       // One chart column per axis every 20 ms (50 Hz, 2.5 s on screen).
+#define TEXT_PAGES 2             // Two text lines on top, the X and Y charts below them (3 pages each).
+
+sensor_stats_t latency_stats;    // Time from event detection to its handling in the main loop, in us.
 
 // Buffer and rendering area for the OLED display.
 uint8_t oled_buffer[ssd1306_buffer_length]; // Buffer to store data for rendering on the OLED display.
@@ -36,6 +53,20 @@ struct render_area oled_area = {
     .end_page = ssd1306_n_pages - 1     // Ending page (covers the total height of the display).
 };
 
+// Text lines: the first pages of oled_buffer, sent on their own.
+struct render_area text_area = {
+    .start_column = 0,
+    .end_column = ssd1306_width - 1,
+    .start_page = 0,
+    .end_page = TEXT_PAGES - 1
+};
+
+// Charts of the filtered axes, full range, one above the other.
+const oled_chart_config_t x_chart_config = { 0, TEXT_PAGES, ssd1306_width, 3, OLED_CHART_LINE, -AXIS_OUT_MAX, AXIS_OUT_MAX, 0 };
+const oled_chart_config_t y_chart_config = { 0, TEXT_PAGES + 3, ssd1306_width, 3, OLED_CHART_LINE, -AXIS_OUT_MAX, AXIS_OUT_MAX, 0 };
+oled_chart_t x_chart, y_chart;            // Chart states and their own pixels.
+struct render_area x_chart_area, y_chart_area; // Screen areas of the charts.
+
 
 // === FUNCTION: Initialize I2C and OLED display ===
 // This function configures the I2C communication and initializes the OLED display.
@@ -59,52 +90,65 @@ bool setup_display()
 }
 
 
-// === FUNCTION: Initialize the joystick ===
-// This function configures the GPIO pins and ADC channels for the joystick.
-void setup_joystick()
+// === FUNCTION: Initialize a chart and its screen area ===
+void setup_chart(oled_chart_t *chart, const oled_chart_config_t *config, struct render_area *area)
 {
-    adc_init();                         // Initializes the ADC module.
-    adc_gpio_init(VRX_PIN);             // Configures the GPIO pin for joystick X-axis ADC input.
-    adc_gpio_init(VRY_PIN);             // Configures the GPIO pin for joystick Y-axis ADC input.
-    gpio_init(JOY_SW);                  // Initializes the GPIO pin for the joystick button (switch).
-    gpio_set_dir(JOY_SW, GPIO_IN);      // Configures the button pin as an input.
-    gpio_pull_up(JOY_SW);               // Activates the pull-up resistor for the button pin to prevent floating values.
+    oled_chart_init(chart, config);          // Empty chart (a valid region and range).
+    area->start_column = config->column;     // The chart is sent straight from chart->pixels.
+    area->end_column = config->column + config->width - 1;
+    area->start_page = config->page;
+    area->end_page = config->page + config->pages - 1;
+    calculate_render_area_buffer_length(area);
 }
 
 
-// === FUNCTION: Read joystick axis values ===
-// This function reads the joystick's X and Y axes values using ADC channels.
-void joystick_read_axis(uint16_t *eixo_x, uint16_t *eixo_y)
+// === FUNCTION: Initialize the joystick ===
+// This function starts the background ADC capture and the joystick service (calibration, button, 1 kHz tick).
+void setup_joystick()
 {
-    adc_select_input(ADC_CH_X);         // Selects the ADC channel for the X-axis.
-    sleep_us(5);                        // Waits for 5 microseconds to stabilize the reading.
-    *eixo_x = adc_read();               // Reads the value from the X-axis ADC channel.
+    if (adc_capture_init(ADC_SAMPLE_RATE) != ADC_CAPTURE_OK) { // Configures VRX_PIN/VRY_PIN, round-robin and DMA.
+        printf("Error starting ADC capture\n");                // Prints an error if no DMA channel is free.
+    }
 
-    adc_select_input(ADC_CH_Y);         // Selects the ADC channel for the Y-axis.
-    sleep_us(5);                        // Waits for 5 microseconds to stabilize the reading.
-    *eixo_y = adc_read();               // Reads the value from the Y-axis ADC channel.
+    joystick_service_config_t config = {
+        .button_pin = JOY_SW,               // Button pin (active low, pull-up enabled by the service).
+        .tick_us = JOY_TICK_US,             // Sampling period of the axes and the button.
+        .debounce_us = JOY_DEBOUNCE_US,     // Lockout after each button edge.
+        .move_threshold = AXIS_THRESHOLD,   // Minimum axis change reported.
+        .axis = { 0, 2048, AXIS_OUT_MAX, AXIS_DEADZONE } // Center 0: measured at rest during init.
+    };
+    if (joystick_service_init(&config) != JOYSTICK_SERVICE_OK) { // Calibrates the axes and starts the tick.
+        printf("Error starting joystick service\n");             // Prints an error if no timer is free.
+    }
 }
 
 
 // === FUNCTION: Display values on OLED display ===
-// This function displays the joystick values (X, Y, button state) on the OLED screen.
-void oled_display_values(uint16_t eixo_x, uint16_t eixo_y, uint8_t botao)
+// This function displays the joystick values (X, Y, button state) on the two text lines of the OLED screen.
+void oled_display_values(int16_t eixo_x, int16_t eixo_y, uint8_t botao)
 {
-    memset(oled_buffer, 0, sizeof(oled_buffer)); // Clears the OLED buffer before rendering new data.
-
-    char linha1[22], linha2[22], linha3[22], linha4[22]; // Buffers to store messages for display.
-    snprintf(linha1, sizeof(linha1), "Joystick test:");  // Formats the title message.
-    snprintf(linha2, sizeof(linha2), "X: %d", eixo_x);   // Formats the X-axis value message.
-    snprintf(linha3, sizeof(linha3), "Y: %d", eixo_y);   // Formats the Y-axis value message.
-    snprintf(linha4, sizeof(linha4), "Button: %s", botao ? "on 1" : "off 0"); // Formats the button state message.
+    memset(oled_buffer, 0, TEXT_PAGES * ssd1306_width); // Clears the text lines only.
+
+    int16_t x = ssd1306_draw_text(oled_buffer, 0, 0, "X "); // Axis values at the top: "X -1000 Y 1000" (16 characters max).
+    x = ssd1306_draw_int(oled_buffer, x, 0, eixo_x);
+    x = ssd1306_draw_text(oled_buffer, x, 0, " Y ");
+    ssd1306_draw_int(oled_buffer, x, 0, eixo_y);
+    ssd1306_draw_text(oled_buffer, 0, 8, botao ? "Button: on 1" : "Button: off 0"); // Button state below them.
+    render_on_display(oled_buffer, &text_area);      // Sends the two text pages only.
+}
 
-    ssd1306_draw_string(oled_buffer, 0, 0, linha1);  // Draws the title message at the top of the OLED display.
-    ssd1306_draw_string(oled_buffer, 0, 20, linha2); // Draws the X-axis message below the title.
-    ssd1306_draw_string(oled_buffer, 0, 35, linha3); // Draws the Y-axis message below the X-axis.
-    ssd1306_draw_string(oled_buffer, 0, 50, linha4); // Draws the button state message below the Y-axis.
 
-    calculate_render_area_buffer_length(&oled_area); // Recalculates the buffer length for the specified rendering area.
-    render_on_display(oled_buffer, &oled_area); // Renders the buffer content onto the OLED display.
+// === FUNCTION: Update the charts on OLED display ===
+// Scrolls each chart by the columns added since the last call, draws them and sends the chart areas only.
+// A chart whose flat line did not change is not sent (an idle stick costs no I2C).
+void oled_display_charts()
+{
+    if (oled_chart_update(&x_chart)) {               // Draws the new X columns.
+        render_on_display(x_chart.pixels, &x_chart_area);
+    }
+    if (oled_chart_update(&y_chart)) {               // Draws the new Y columns.
+        render_on_display(y_chart.pixels, &y_chart_area);
+    }
 }
 
 
@@ -117,28 +161,67 @@ void setup()
     if (!setup_display()) {          // Calls function to initialize the OLED display.
         printf("Error initializing display\n"); // Prints error message if display initialization fails.
     }
+    calculate_render_area_buffer_length(&text_area); // Area of the text lines.
+    setup_chart(&x_chart, &x_chart_config, &x_chart_area); // Chart of the X axis.
+    setup_chart(&y_chart, &y_chart_config, &y_chart_area); // Chart of the Y axis.
 }
 
 
 // === MAIN FUNCTION ===
-// The main loop reads joystick values and updates both the serial monitor and OLED display.
+// The main loop sleeps until the joystick service reports a change or the next chart column is due,
+// then updates the serial monitor and OLED display.
 int main()
 {
-    uint16_t x = 0, y = 0;           // Variables to hold X and Y axes values of the joystick.
-    uint8_t botao = 0;               // Variable to hold the state of the joystick button.
+    joystick_event_t event;          // Latest joystick event (axes, button and timestamp).
+    joystick_event_t current = { 0 }; // Joystick state after the last event (what the charts show).
+    adc_capture_stats_t adc_stats;   // Sample rate and FIFO overflows of the ADC capture.
+    static const char *event_names[] = { "MOVE", "PRESS", "RELEASE" }; // Names of joystick_event_type_t.
+    const sensor_stats_config_t latency_config = { 0, LATENCY_BIN_US, 16, 3, 64880 }; // Histogram, trend, p99.
 
     setup();                         // Calls the general setup function.
+    sensor_stats_init(&latency_stats, &latency_config); // Clears the latency statistics.
     printf("Starting joystick reading\n"); // Prints the start message to the serial monitor.
+    uint32_t next_column_ms = to_ms_since_boot(get_absolute_time()); // Time of the next chart column.
+    uint32_t idle_since_ms = next_column_ms; // Time of the last event (or of the last statistics print).
+    oled_display_values(current.x, current.y, current.button); // Text lines until the first event.
 
-    while (1)                        // Infinite loop to continuously read and display joystick values.
+    while (1)                        // Infinite loop: one pass per joystick change or chart period.
     {
-        joystick_read_axis(&x, &y);  // Reads the X and Y axes values of the joystick.
-        botao = !gpio_get(JOY_SW);   // Reads the button state (active-low logic, so value is inverted).
-
-        printf("X: %d, Y: %d, Button: %s\n", x, y, botao ? "ON 1" : "OFF 0"); // Prints joystick values to serial monitor.
-
-        oled_display_values(x, y, botao); // Updates the OLED display with joystick values.
-
-        sleep_ms(500);               // Waits for 500 milliseconds before repeating the loop.
+        uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+        int32_t until_column = (int32_t)(next_column_ms - now_ms);
+        if (joystick_service_wait(&event, until_column > 0 ? (uint32_t)until_column : 0)) { // Sleeps until an event or a column.
+            do {                     // Prints every queued event; only the last one is drawn.
+                uint64_t now = time_us_64();
+                int32_t latency = (int32_t)(now - event.time_us); // From detection in the tick to here.
+                sensor_stats_add(&latency_stats, latency, (uint32_t)(now / 1000)); // Updates the latency statistics.
+                printf("%s X: %d, Y: %d, Button: %s (latency %ld us)\n", event_names[event.type], event.x, event.y,
+                       event.button ? "ON 1" : "OFF 0", (long)latency); // Prints joystick values to serial monitor.
+            } while (joystick_service_poll(&event)); // Events that arrived while printing or drawing.
+
+            current = event;
+            oled_display_values(current.x, current.y, current.button); // Updates the text lines with joystick values.
+            idle_since_ms = to_ms_since_boot(get_absolute_time());
+        }
+
+        now_ms = to_ms_since_boot(get_absolute_time());
+        while ((int32_t)(now_ms - next_column_ms) >= 0) { // One column per period, catching up after a slow pass.
+            oled_chart_add(&x_chart, current.x);
+            oled_chart_add(&y_chart, current.y);
+            next_column_ms += CHART_PERIOD_MS;
+        }
+        oled_display_charts();       // Draws and sends the new columns.
+
+        if (now_ms - idle_since_ms >= STATS_PERIOD_MS) { // No event for a while: prints the health counters.
+            idle_since_ms = now_ms;
+            adc_capture_get_stats(&adc_stats); // Reads the capture counters.
+            printf("ADC: %lu samples/s, overflows: %lu, dropped events: %lu\n",
+                   (unsigned long)adc_stats.samples_per_second, (unsigned long)adc_stats.overflows,
+                   (unsigned long)joystick_service_dropped()); // Prints the acquisition health.
+            printf("Latency: %lu events, avg %ld us, sd %ld us, p99 %ld us, max %ld us\n",
+                   (unsigned long)latency_stats.count, (long)SENSOR_STATS_Q8_ROUND(sensor_stats_mean_q8(&latency_stats)),
+                   (long)SENSOR_STATS_Q8_ROUND(sensor_stats_stddev_q8(&latency_stats)),
+                   (long)SENSOR_STATS_Q8_ROUND(sensor_stats_percentile_q8(&latency_stats)),
+                   (long)latency_stats.max); // Prints how fast events are handled.
+        }
     }
 }
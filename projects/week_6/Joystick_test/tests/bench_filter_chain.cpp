@@ -0,0 +1,218 @@
+// Embarcatech, April 2025 - Filter chain check and benchmark (host)
+// Author: Filipe Alves de Sousa
+// Checks each filter stage, then times the joystick chain (median of 3,
+// normalize, deadzone, EMA) three ways: the compile-time chain, the C wrapper,
+// and the same stages called through a run-time table of function pointers,
+// and checks that the stick at either stop reads exactly +-out_max.
+//
+// Build and run on the host (from the project folder):
+//   g++ -std=c++17 -O2 -Iinc tests/bench_filter_chain.cpp inc/joystick_filter.cpp -o bench_filter_chain
+//   ./bench_filter_chain   (exit code 0 when the checks pass)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <time.h>      // clock_gettime()
+#include "filter_chain.hpp"
+#include "joystick_filter.h"
+
+#define SAMPLES 4096          // Samples per block
+#define ROUNDS 5000           // Blocks per timing
+
+static uint16_t raw[SAMPLES];
+static int16_t out_chain[SAMPLES];
+static int16_t out_table[SAMPLES];
+static int16_t out_wrapper[SAMPLES];
+static uint32_t rng = 2025;
+
+static uint32_t next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// Monotonic time in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// === Run-time pipeline: one indirect call per stage and sample ===
+
+struct stage_ref {
+    int32_t (*fn)(void *, int32_t);
+    void *state;
+};
+
+template <typename S>
+static int32_t call_stage(void *state, int32_t x) {
+    return (*static_cast<S *>(state))(x);
+}
+
+__attribute__((noinline)) static void run_table(const stage_ref *stages, int count, const uint16_t *in, int16_t *out,
+                                                size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        int32_t x = in[i];
+        for (int s = 0; s < count; s++) {
+            x = stages[s].fn(stages[s].state, x);
+        }
+        out[i] = static_cast<int16_t>(x);
+    }
+}
+
+// === Stage checks ===
+
+static int check_stages(void) {
+    int failures = 0;
+
+    filt::median_of<3> median3;
+    const int32_t spiky[] = { 100, 100, 4000, 100, 100, 0, 100 };
+    for (int32_t x : spiky) {
+        int32_t y = median3(x);
+        if (y != 100) {
+            printf("  FAIL: median of 3 let %d through\n", y);
+            failures++;
+        }
+    }
+    filt::median_of<5> median5;
+    const int32_t five[] = { 5, 1, 4, 2, 3 };
+    int32_t m = 0;
+    for (int32_t x : five) {
+        m = median5(x);
+    }
+    failures += m != 3 ? (printf("  FAIL: median of 5 gave %d\n", m), 1) : 0;
+
+    filt::normalize norm(2000, 2000, 1000);
+    if (norm(2000) != 0 || norm(4000) != 1000 || norm(0) != -1000 || norm(3000) != 500 || norm(4095) != 1000) {
+        printf("  FAIL: normalize\n");
+        failures++;
+    }
+
+    filt::deadzone dz(40);
+    if (dz(39) != 0 || dz(-40) != 0 || dz(41) != 1 || dz(-100) != -60) {
+        printf("  FAIL: deadzone\n");
+        failures++;
+    }
+    filt::deadzone stretched(40, 1000);  // 40..1000 stretched to 0..1000
+    if (stretched(40) != 0 || stretched(-40) != 0 || stretched(1000) != 1000 || stretched(-1000) != -1000 ||
+        stretched(520) != 500 || stretched(41) != 1) {
+        printf("  FAIL: deadzone with out_max\n");
+        failures++;
+    }
+
+    filt::ema<2> smooth;
+    int32_t e = smooth(0);
+    for (int i = 0; i < 40; i++) {
+        e = smooth(1000);
+    }
+    failures += (e != 1000) ? (printf("  FAIL: EMA settled at %d\n", e), 1) : 0;
+
+    filt::slew_limit slew(10);
+    slew(0);
+    if (slew(100) != 10 || slew(100) != 20 || slew(-100) != 10) {
+        printf("  FAIL: slew limit\n");
+        failures++;
+    }
+
+    // Jitter of +-4 around the 50 / 100 boundary must not toggle the output
+    filt::hysteresis_quantize quant(100, 5);
+    int32_t level = quant(40);
+    for (int i = 0; i < 100; i++) {
+        int32_t y = quant(50 + static_cast<int32_t>(next_random() % 9) - 4);
+        if (y != level) {
+            printf("  FAIL: hysteresis toggled to %d\n", y);
+            failures++;
+            break;
+        }
+    }
+    if (quant(140) != 100 || quant(260) != 300) {
+        printf("  FAIL: hysteresis did not follow\n");
+        failures++;
+    }
+    return failures;
+}
+
+int main(void) {
+    int failures = check_stages();
+    printf("Stage checks: %s\n\n", failures ? "FAIL" : "ok");
+
+    // Stick at rest with noise, pushed to full deflection and back, with spikes
+    for (int i = 0; i < SAMPLES; i++) {
+        int32_t base = (i / 512) % 2 ? 3900 : 2050;
+        int32_t noise = static_cast<int32_t>(next_random() % 41) - 20;
+        raw[i] = static_cast<uint16_t>(next_random() % 64 == 0 ? 4095 : base + noise);
+    }
+
+    using axis_chain = filt::chain<filt::median_of<3>, filt::normalize, filt::deadzone, filt::ema<2>>;
+    const joystick_filter_config_t config = { 2048, 2048, 1000, 40 };
+
+    // Same stages behind function pointers
+    filt::median_of<3> t_median;
+    filt::normalize t_norm(config.center, config.extent, config.out_max);
+    filt::deadzone t_dz(config.deadzone, config.out_max);
+    filt::ema<2> t_ema;
+    stage_ref table[] = {
+        { call_stage<filt::median_of<3>>, &t_median },
+        { call_stage<filt::normalize>, &t_norm },
+        { call_stage<filt::deadzone>, &t_dz },
+        { call_stage<filt::ema<2>>, &t_ema },
+    };
+
+    axis_chain chain(filt::median_of<3>{}, filt::normalize(config.center, config.extent, config.out_max),
+                     filt::deadzone(config.deadzone, config.out_max), filt::ema<2>{});
+    joystick_filter_t wrapper;
+    joystick_filter_init(&wrapper, &config);
+
+    chain.run(raw, out_chain, SAMPLES);
+    run_table(table, 4, raw, out_table, SAMPLES);
+    joystick_filter_block(&wrapper, raw, out_wrapper, SAMPLES);
+    int mismatch = 0;
+    for (int i = 0; i < SAMPLES && !mismatch; i++) {
+        if (out_chain[i] != out_table[i] || out_chain[i] != out_wrapper[i]) {
+            printf("  FAIL: sample %d: chain %d, table %d, wrapper %d\n", i, out_chain[i], out_table[i],
+                   out_wrapper[i]);
+            mismatch = 1;
+        }
+    }
+    failures += mismatch;
+    printf("Chain, wrapper and function-pointer outputs identical: %s\n\n", mismatch ? "FAIL" : "ok");
+
+    // Stick held at either stop: the whole chain must settle on +-out_max, deadzone included
+    joystick_filter_t stop;
+    int16_t right = 0, left = 0;
+    joystick_filter_init(&stop, &config);
+    for (int i = 0; i < 64; i++) {
+        right = joystick_filter_step(&stop, 4095);
+    }
+    joystick_filter_init(&stop, &config);
+    for (int i = 0; i < 64; i++) {
+        left = joystick_filter_step(&stop, 0);
+    }
+    int range_failed = right != config.out_max || left != -config.out_max;
+    failures += range_failed;
+    printf("Full deflection reads %d / %d (expected +-%d): %s\n\n", left, right, (int)config.out_max,
+           range_failed ? "FAIL" : "ok");
+
+    double t0 = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        chain.run(raw, out_chain, SAMPLES);
+    }
+    double t1 = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        joystick_filter_block(&wrapper, raw, out_wrapper, SAMPLES);
+    }
+    double t2 = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        run_table(table, 4, raw, out_table, SAMPLES);
+    }
+    double t3 = now_ns();
+
+    double total = static_cast<double>(ROUNDS) * SAMPLES;
+    printf("===== FILTER CHAIN BENCHMARK (median 3 > normalize > deadzone > EMA) =====\n");
+    printf("%-30s %-12s %-10s\n", "Implementation", "ns/sample", "Msample/s");
+    printf("%-30s %-12.2f %-10.1f\n", "Compile-time chain (C++)", (t1 - t0) / total, total / (t1 - t0) * 1000);
+    printf("%-30s %-12.2f %-10.1f\n", "C wrapper (block)", (t2 - t1) / total, total / (t2 - t1) * 1000);
+    printf("%-30s %-12.2f %-10.1f\n", "Function-pointer table", (t3 - t2) / total, total / (t3 - t2) * 1000);
+    return failures ? 1 : 0;
+}
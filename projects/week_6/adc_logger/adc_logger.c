@@ -0,0 +1,115 @@
+// Embarcatech, April 2025 - "High-rate ADC logger" --- Author: Filipe Alves de Sousa
+// Captures one ADC input at up to 500 kSps with chained DMA and streams the
+// samples to the computer over USB CDC in binary frames (see inc/stream_frame.h).
+// The host side is host/adc_receiver.c, which writes the samples to a file.
+//----------------------------------------------------------------------------------
+
+#include <stdio.h>             // Standard library for input/output functions, e.g., getchar_timeout_us().
+#include "pico/stdlib.h"       // Standard functions for Raspberry Pi Pico board, like initialization and delay.
+#include "pico/stdio_usb.h"    // USB CDC driver of stdio, written to directly for binary data.
+#include "tusb.h"              // TinyUSB, for the free space of the CDC transmit buffer.
+#include "inc/adc_stream.h"    // Gapless block capture of one ADC input (chained DMA ring).
+#include "inc/stream_sender.h" // Binary framing of the blocks and their transport.
+
+
+// === CONFIGURATIONS ===
+// Capture parameters; the channel can also be changed from the computer.
+
+#define LOG_CHANNEL 0                // ADC input captured at startup (0-3: GPIO26-29, 4: temperature sensor).
+#define LOG_RATE 500000              // Samples per second (maximum of the RP2040 ADC).
+#define LOG_FORMAT STREAM_FORMAT_PACKED12 // 12-bit packed: 750 KB/s at 500 kSps.
+#define USB_STALL_US 16000           // USB wait before a frame is dropped (the capture ring holds 8 blocks of 2 ms).
+
+stream_sender_t sender;              // Frame buffer, drop counter and USB transport.
+bool streaming = true;               // Paused with 'p', resumed with 'g'.
+
+
+// === FUNCTION: USB transport ===
+// Writes one frame to USB CDC, without the CR/LF translation of printf. Each piece handed to
+// stdio fits in the free space of the CDC buffer, so it is taken whole and the count returned is
+// what the USB link really accepted. A frame the computer stops reading for USB_STALL_US comes back
+// short, and the sender counts it as a dropped block.
+size_t usb_write(void *context, const uint8_t *data, size_t length)
+{
+    (void)context;
+    size_t sent = 0;
+    absolute_time_t deadline = make_timeout_time_us(USB_STALL_US);
+    while (sent < length && stdio_usb_connected()) { // Not connected: no terminal open on the computer.
+        uint32_t room = tud_cdc_write_available(); // Free bytes in the CDC transmit buffer.
+        if (room == 0) {
+            if (time_reached(deadline)) {
+                break;               // The computer is not reading: give up on this frame.
+            }
+            continue;                // The USB background task empties the buffer every 1 ms.
+        }
+        size_t n = length - sent < room ? length - sent : room;
+        stdio_usb.out_chars((const char *)data + sent, (int)n); // Copies, flushes and returns at once.
+        sent += n;
+        deadline = make_timeout_time_us(USB_STALL_US);
+    }
+    return sent;
+}
+
+
+// === FUNCTION: Start capturing a channel ===
+// Restarts the capture and the frame sequence (the receiver sees the sequence go back to 0).
+void start_channel(uint8_t channel)
+{
+    if (adc_stream_start(channel, LOG_RATE) != ADC_STREAM_OK) { // Configures the ADC and both DMA channels.
+        return;                      // Invalid channel: keeps the current one.
+    }
+    stream_transport_t usb = { usb_write, NULL };
+    stream_sender_init(&sender, &usb, channel, LOG_FORMAT, adc_stream_rate()); // Frames carry the real rate.
+}
+
+
+// === FUNCTION: Commands from the computer ===
+// Single characters: '0'-'4' select the ADC input, 'p' pauses and 'g' resumes the stream.
+void handle_commands()
+{
+    int c = getchar_timeout_us(0);   // Non-blocking read of one character.
+    if (c >= '0' && c <= '4') {
+        start_channel((uint8_t)(c - '0'));
+        streaming = true;
+    } else if (c == 'p') {
+        adc_stream_stop();
+        streaming = false;
+    } else if (c == 'g' && !streaming) {
+        start_channel(sender.channel);
+        streaming = true;
+    }
+}
+
+
+// === MAIN FUNCTION ===
+// Sends every finished block as one frame; blocks the USB link could not take in time are counted as dropped.
+int main()
+{
+    adc_stream_block_t block;        // Finished block taken from the capture ring.
+    uint32_t skipped;                // Blocks overwritten before they could be sent.
+
+    stdio_init_all();                // Initializes USB CDC.
+    stdio_set_translate_crlf(&stdio_usb, false); // Binary data: no '\n' -> "\r\n" translation.
+    if (adc_stream_init() != ADC_STREAM_OK) { // Claims two DMA channels and the DMA interrupt.
+        while (1) {
+            tight_loop_contents();   // No DMA channels: nothing to do.
+        }
+    }
+    start_channel(LOG_CHANNEL);      // Starts capturing the default input.
+
+    while (1)
+    {
+        handle_commands();           // Channel change, pause, resume.
+        if (!streaming || !adc_stream_next(&block, &skipped)) {
+            __wfe();                 // Sleeps until the next interrupt (DMA block, USB).
+            continue;
+        }
+        stream_sender_drop(&sender, skipped); // Blocks lost while the USB link was slower than the ADC.
+        stream_sender_prepare(&sender, block.sequence, block.samples, ADC_STREAM_BLOCK_SAMPLES); // Packs the block.
+        if (adc_stream_release(&block)) {
+            stream_sender_send(&sender); // Writes the frame (a short write counts as a dropped block).
+        } else {
+            stream_sender_drop(&sender, 1); // The DMA overwrote the block while it was being packed.
+        }
+    }
+}
@@ -0,0 +1,153 @@
+// Embarcatech, April 2025 - ADC logger receiver (host, Linux)
+// Author: Filipe Alves de Sousa
+// Reads the binary frames sent by adc_logger over USB CDC (or from a file or a
+// pipe), checks them, and writes the samples to a file as little-endian uint16.
+// Once per second it prints the sample rate received, the blocks the device
+// dropped, the blocks lost on the way (sequence gaps) and the CRC errors.
+//
+// Build (from the project folder):
+//   gcc -O2 -Iinc host/adc_receiver.c inc/stream_frame.c -o adc_receiver
+// Run:
+//   ./adc_receiver /dev/ttyACM0 samples.bin [channel 0-4] [max samples]
+//   ./adc_receiver - samples.bin < capture.raw     (frames from a file or pipe)
+// Read the result with e.g. numpy.fromfile("samples.bin", dtype="<u2").
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>      // printf(), fopen(), fwrite()
+#include <stdlib.h>     // strtoul()
+#include <string.h>     // strcmp()
+#include <signal.h>     // Ctrl+C
+#include <time.h>       // clock_gettime()
+#include <fcntl.h>      // open()
+#include <unistd.h>     // read(), write()
+#include <termios.h>    // Raw mode of the serial port
+#include "stream_frame.h"
+
+typedef struct {
+    FILE *out;
+    unsigned long long samples;         // Samples written to the file
+    unsigned long long max_samples;     // Stop after this many (0: until Ctrl+C)
+    uint32_t device_dropped;            // Drop counter of the latest frame
+    uint32_t rate_hz;                   // Sample rate of the latest frame
+    int channel;                        // Channel of the latest frame, -1 before the first
+} receiver_t;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop = 1;
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Decoder callback: one valid frame
+static void on_frame(void *context, const stream_frame_header_t *header, const uint16_t *samples) {
+    receiver_t *rx = context;
+    if (rx->channel != header->channel) {
+        fprintf(stderr, "Channel %u, %lu Hz\n", header->channel, (unsigned long)header->sample_rate_hz);
+        rx->channel = header->channel;
+    }
+    rx->device_dropped = header->dropped;
+    rx->rate_hz = header->sample_rate_hz;
+
+    size_t n = header->count;
+    if (rx->max_samples && rx->samples + n > rx->max_samples) {
+        n = (size_t)(rx->max_samples - rx->samples);
+        stop = 1;
+    }
+    uint8_t le[2 * STREAM_FRAME_MAX_SAMPLES];
+    for (size_t i = 0; i < n; i++) {
+        le[2 * i] = (uint8_t)samples[i];
+        le[2 * i + 1] = (uint8_t)(samples[i] >> 8);
+    }
+    fwrite(le, 2, n, rx->out);
+    rx->samples += n;
+}
+
+// Serial port in raw mode: no echo, no line editing, no CR/LF changes
+static int open_port(const char *path) {
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tio.c_cc[VMIN] = 1;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+static void print_stats(const receiver_t *rx, const stream_decoder_t *decoder, double rate) {
+    fprintf(stderr, "%8.1f kSps | samples %llu | device dropped %lu | lost %lu | CRC errors %lu | skipped bytes %lu\n",
+            rate / 1000, rx->samples, (unsigned long)rx->device_dropped, (unsigned long)decoder->lost_blocks,
+            (unsigned long)decoder->crc_errors, (unsigned long)decoder->skipped_bytes);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <port|-> <output.bin> [channel 0-4] [max samples]\n", argv[0]);
+        return 2;
+    }
+    int is_port = strcmp(argv[1], "-") != 0;
+    int fd = is_port ? open_port(argv[1]) : STDIN_FILENO;
+    if (fd < 0) {
+        perror(argv[1]);
+        return 1;
+    }
+    receiver_t rx = { .channel = -1 };
+    rx.out = fopen(argv[2], "wb");
+    if (!rx.out) {
+        perror(argv[2]);
+        return 1;
+    }
+    if (argc > 4) {
+        rx.max_samples = strtoull(argv[4], NULL, 10);
+    }
+    if (is_port && argc > 3) {
+        char command = argv[3][0];       // '0'-'4': the device restarts on that channel
+        if (write(fd, &command, 1) != 1) {
+            perror("write");
+        }
+    }
+
+    static stream_decoder_t decoder;     // ~12 KB: kept off the stack
+    stream_decoder_init(&decoder, on_frame, &rx);
+    signal(SIGINT, on_signal);
+
+    uint8_t buf[16384];
+    double last = now_s();
+    unsigned long long last_samples = 0;
+    while (!stop) {
+        ssize_t got = read(fd, buf, sizeof(buf));
+        if (got <= 0) {
+            break;                       // End of file, or Ctrl+C during read()
+        }
+        stream_decoder_push(&decoder, buf, (size_t)got);
+        double t = now_s();
+        if (t - last >= 1.0) {
+            print_stats(&rx, &decoder, (rx.samples - last_samples) / (t - last));
+            last = t;
+            last_samples = rx.samples;
+        }
+    }
+    if (is_port) {
+        char pause = 'p';                // Stops the device from streaming into a closed port
+        if (write(fd, &pause, 1) != 1) {
+            perror("write");
+        }
+        close(fd);
+    }
+    fclose(rx.out);
+    print_stats(&rx, &decoder, 0);
+    fprintf(stderr, "Frames: %lu, bad headers: %lu\n", (unsigned long)decoder.frames,
+            (unsigned long)decoder.bad_headers);
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Embarcatech, April 2025 - High-rate ADC block capture (chained DMA)
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Block k is written by DMA channel k % 2 into ring slot k % BLOCKS.
+    When block k completes, the other channel (already pointed at slot
+    k+1) is started by the chain, and the interrupt points the finished
+    channel at slot k+2. So while `done` blocks are complete, slots of
+    blocks done and done+1 may be under DMA and every older block within
+    BLOCKS-2 of `done` is safe to read.
+    ======================================================================== */
+
+#include "pico/stdlib.h"       // Pico SDK utilities
+#include "hardware/adc.h"      // ADC free-running mode and FIFO
+#include "hardware/dma.h"      // Ping-pong DMA channels
+#include "hardware/irq.h"      // DMA completion interrupt
+#include "hardware/clocks.h"   // clock_get_hz()
+#include "adc_stream.h"
+
+#define FIRST_ADC_GPIO 26                // ADC0 is on GPIO26, ADC3 on GPIO29
+#define SAFE_DISTANCE (ADC_STREAM_BLOCKS - 2)
+
+static uint16_t ring[ADC_STREAM_BLOCKS][ADC_STREAM_BLOCK_SAMPLES];
+static int dma_chan[2] = { -1, -1 };
+static volatile uint32_t blocks_done;    // Blocks completed since adc_stream_start()
+static uint32_t next_block;              // Next block adc_stream_next() returns
+static uint32_t rate_hz;
+
+// Block finished: point its channel at the block after next (the other channel is already running)
+static void dma_block_handler(void) {
+    for (;;) {
+        int chan = dma_chan[blocks_done & 1];    // Channel of the block in progress
+        if (chan < 0 || !(dma_hw->ints0 & (1u << chan))) {
+            return;
+        }
+        dma_hw->ints0 = 1u << chan;
+        uint32_t done = blocks_done;
+        dma_channel_set_write_addr(chan, ring[(done + 2) % ADC_STREAM_BLOCKS], false);
+        dma_channel_set_trans_count(chan, ADC_STREAM_BLOCK_SAMPLES, false);
+        blocks_done = done + 1;
+    }
+}
+
+static void configure_channel(int index, uint32_t block) {
+    dma_channel_config config = dma_channel_get_default_config(dma_chan[index]);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_dreq(&config, DREQ_ADC);
+    channel_config_set_chain_to(&config, dma_chan[index ^ 1]);   // Starts the other channel when done
+    dma_channel_configure(dma_chan[index], &config, ring[block % ADC_STREAM_BLOCKS], &adc_hw->fifo,
+                          ADC_STREAM_BLOCK_SAMPLES, false);
+}
+
+int adc_stream_init(void) {
+    if (dma_chan[0] >= 0) {
+        return ADC_STREAM_OK;
+    }
+    int a = dma_claim_unused_channel(false);
+    int b = dma_claim_unused_channel(false);
+    if (a < 0 || b < 0) {
+        if (a >= 0) {
+            dma_channel_unclaim(a);
+        }
+        return ADC_STREAM_NO_DMA;
+    }
+    dma_chan[0] = a;
+    dma_chan[1] = b;
+    adc_init();
+    irq_add_shared_handler(DMA_IRQ_0, dma_block_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+    return ADC_STREAM_OK;
+}
+
+int adc_stream_start(uint8_t channel, uint32_t sample_rate_hz) {
+    if (channel > 4) {
+        return ADC_STREAM_BAD_CHANNEL;
+    }
+    if (sample_rate_hz == 0 || sample_rate_hz > ADC_STREAM_MAX_RATE) {
+        return ADC_STREAM_BAD_RATE;
+    }
+    adc_stream_stop();
+
+    if (channel == 4) {
+        adc_set_temp_sensor_enabled(true);
+    } else {
+        adc_gpio_init(FIRST_ADC_GPIO + channel);
+    }
+    adc_select_input(channel);
+    adc_set_round_robin(0);
+    adc_fifo_setup(true, true, 1, false, false);  // FIFO on, DREQ at 1 sample, no error bit, 12-bit samples
+
+    // Conversion every (div + 1) ADC clocks, 96 at least; div has 8 fraction bits. Below 95: back to back
+    uint32_t adc_clock = clock_get_hz(clk_adc);
+    uint32_t div_q8 = (uint32_t)(((uint64_t)adc_clock << 8) / sample_rate_hz) - 256;
+    if (div_q8 < 95 * 256) {
+        div_q8 = 0;
+    }
+    adc_set_clkdiv(div_q8 / 256.0f);
+    rate_hz = div_q8 ? (uint32_t)(((uint64_t)adc_clock << 8) / (div_q8 + 256)) : adc_clock / 96;
+
+    blocks_done = 0;
+    next_block = 0;
+    configure_channel(0, 0);
+    configure_channel(1, 1);
+    dma_channel_set_irq0_enabled(dma_chan[0], true);
+    dma_channel_set_irq0_enabled(dma_chan[1], true);
+    dma_channel_start(dma_chan[0]);
+    adc_run(true);
+    return ADC_STREAM_OK;
+}
+
+void adc_stream_stop(void) {
+    if (dma_chan[0] < 0) {
+        return;
+    }
+    adc_run(false);
+    for (int i = 0; i < 2; i++) {
+        dma_channel_config config = dma_get_channel_config(dma_chan[i]);
+        channel_config_set_chain_to(&config, dma_chan[i]);  // Aborting a chained channel can start the other one
+        dma_channel_set_config(dma_chan[i], &config, false);
+    }
+    for (int i = 0; i < 2; i++) {
+        dma_channel_set_irq0_enabled(dma_chan[i], false);  // Abort may raise a spurious completion
+        dma_channel_abort(dma_chan[i]);
+        dma_hw->ints0 = 1u << dma_chan[i];
+    }
+    adc_fifo_drain();
+    adc_hw->fcs |= ADC_FCS_OVER_BITS | ADC_FCS_UNDER_BITS;  // Write 1 to clear
+}
+
+bool adc_stream_next(adc_stream_block_t *block, uint32_t *skipped) {
+    uint32_t done = blocks_done;
+    *skipped = 0;
+    if (next_block == done) {
+        return false;
+    }
+    if (done - next_block > SAFE_DISTANCE) {
+        *skipped = done - SAFE_DISTANCE - next_block;   // Overwritten, or about to be
+        next_block = done - SAFE_DISTANCE;
+    }
+    block->samples = ring[next_block % ADC_STREAM_BLOCKS];
+    block->sequence = next_block;
+    next_block++;
+    return true;
+}
+
+bool adc_stream_release(const adc_stream_block_t *block) {
+    return blocks_done - block->sequence <= SAFE_DISTANCE;
+}
+
+uint32_t adc_stream_rate(void) {
+    return rate_hz;
+}
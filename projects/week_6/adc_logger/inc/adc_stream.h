@@ -0,0 +1,87 @@
+// Embarcatech, April 2025 - High-rate ADC block capture (chained DMA)
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Captures one ADC input at up to 500 kSps into a RAM ring of fixed-size
+    blocks. Two DMA channels take turns (each chained to the other), so
+    the hand-over between blocks needs no CPU and no sample is missed;
+    the completion interrupt only points the idle channel at the block
+    after next. The consumer takes finished blocks in order and is told
+    how many were overwritten because it fell behind.
+
+    Key Features:
+    - Gapless capture: chained ping-pong DMA, ADC paced by its own clock
+    - Ring of ADC_STREAM_BLOCKS blocks (8 x 1024 samples, 16 KB)
+    - Lap detection both when a block is taken and after it was used
+    - Channel 0-3 (GPIO26-29) or 4 (internal temperature sensor)
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADC_STREAM_BLOCK_SAMPLES 1024   // Samples per block (2 ms at 500 kSps)
+#define ADC_STREAM_BLOCKS 8             // Blocks in the ring (power of two)
+#define ADC_STREAM_MAX_RATE 500000      // 48 MHz ADC clock / 96 cycles per conversion
+
+// Return codes
+#define ADC_STREAM_OK 0
+#define ADC_STREAM_BAD_CHANNEL -1       // Channel above 4
+#define ADC_STREAM_BAD_RATE -2          // Rate of 0 or above ADC_STREAM_MAX_RATE
+#define ADC_STREAM_NO_DMA -3            // Fewer than two free DMA channels
+
+/**
+ * @brief A finished block, valid until adc_stream_release()
+ */
+typedef struct {
+    const uint16_t *samples;            // ADC_STREAM_BLOCK_SAMPLES 12-bit samples
+    uint32_t sequence;                  // Block number since adc_stream_start()
+} adc_stream_block_t;
+
+/**
+ * @brief Claims the DMA channels and the interrupt (once)
+ *
+ * @return ADC_STREAM_OK or ADC_STREAM_NO_DMA
+ */
+int adc_stream_init(void);
+
+/**
+ * @brief Starts (or restarts) capturing one input; block numbers start at 0
+ *
+ * @return ADC_STREAM_OK, ADC_STREAM_BAD_CHANNEL or ADC_STREAM_BAD_RATE
+ */
+int adc_stream_start(uint8_t channel, uint32_t sample_rate_hz);
+
+/**
+ * @brief Stops the ADC and both DMA channels
+ */
+void adc_stream_stop(void);
+
+/**
+ * @brief Takes the oldest finished block not yet taken
+ *
+ * @param skipped Set to the blocks overwritten since the previous one (0 when keeping up)
+ * @return false if no block is ready
+ */
+bool adc_stream_next(adc_stream_block_t *block, uint32_t *skipped);
+
+/**
+ * @brief Gives the block back
+ *
+ * @return false if the DMA reached the block while it was in use (its data is not reliable)
+ */
+bool adc_stream_release(const adc_stream_block_t *block);
+
+/**
+ * @brief Sample rate actually set (the ADC divider has 1/256 steps)
+ */
+uint32_t adc_stream_rate(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,186 @@
+// Embarcatech, April 2025 - Binary sample framing for the ADC logger
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    The CRC uses a 16-entry (nibble) table: two lookups per byte, 32
+    bytes of flash instead of 512, fast enough for 750 KB/s on the
+    Cortex-M0+. The decoder keeps unparsed bytes in a linear buffer and
+    slides past anything that is not a valid frame one byte at a time.
+    ======================================================================== */
+
+#include <string.h>    // memcpy(), memmove()
+#include "stream_frame.h"
+
+static const uint16_t crc_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+uint16_t stream_crc16(uint16_t crc, const uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        crc = (uint16_t)((crc << 4) ^ crc_nibble[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ crc_nibble[(crc >> 12) ^ (data[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+static void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+    put_u16(p, (uint16_t)v);
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+int stream_frame_encode(const stream_frame_header_t *header, const uint16_t *samples, uint8_t *out, size_t out_size) {
+    if (header->format != STREAM_FORMAT_PACKED12 && header->format != STREAM_FORMAT_RAW16) {
+        return STREAM_FRAME_BAD_FORMAT;
+    }
+    if (header->count > STREAM_FRAME_MAX_SAMPLES) {
+        return STREAM_FRAME_TOO_LONG;
+    }
+    size_t size = STREAM_FRAME_SIZE(header->format, (size_t)header->count);
+    if (size > out_size) {
+        return STREAM_FRAME_NO_ROOM;
+    }
+
+    out[0] = STREAM_FRAME_MAGIC0;
+    out[1] = STREAM_FRAME_MAGIC1;
+    out[2] = header->channel;
+    out[3] = header->format;
+    put_u32(out + 4, header->sequence);
+    put_u32(out + 8, header->dropped);
+    put_u32(out + 12, header->sample_rate_hz);
+    put_u16(out + 16, header->count);
+
+    uint8_t *p = out + STREAM_FRAME_HEADER_SIZE;
+    size_t n = header->count;
+    if (header->format == STREAM_FORMAT_PACKED12) {
+        size_t i = 0;
+        for (; i + 1 < n; i += 2, p += 3) {
+            uint16_t a = samples[i] & 0x0FFF, b = samples[i + 1] & 0x0FFF;
+            p[0] = (uint8_t)a;
+            p[1] = (uint8_t)((a >> 8) | (b << 4));
+            p[2] = (uint8_t)(b >> 4);
+        }
+        if (i < n) {
+            put_u16(p, samples[i] & 0x0FFF);
+            p += 2;
+        }
+    } else {
+        for (size_t i = 0; i < n; i++, p += 2) {
+            put_u16(p, samples[i]);
+        }
+    }
+    put_u16(p, stream_crc16(0xFFFF, out, (size_t)(p - out)));
+    return (int)size;
+}
+
+void stream_decoder_init(stream_decoder_t *decoder, stream_frame_handler_t handler, void *context) {
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->handler = handler;
+    decoder->context = context;
+}
+
+// Unpacks the payload of a frame whose header and CRC were checked
+static void deliver(stream_decoder_t *decoder, const uint8_t *frame, const stream_frame_header_t *header) {
+    const uint8_t *p = frame + STREAM_FRAME_HEADER_SIZE;
+    size_t n = header->count;
+    if (header->format == STREAM_FORMAT_PACKED12) {
+        size_t i = 0;
+        for (; i + 1 < n; i += 2, p += 3) {
+            decoder->samples[i] = (uint16_t)(p[0] | ((p[1] & 0x0F) << 8));
+            decoder->samples[i + 1] = (uint16_t)((p[1] >> 4) | (p[2] << 4));
+        }
+        if (i < n) {
+            decoder->samples[i] = get_u16(p);
+        }
+    } else {
+        for (size_t i = 0; i < n; i++, p += 2) {
+            decoder->samples[i] = get_u16(p);
+        }
+    }
+
+    int32_t gap = (int32_t)(header->sequence - decoder->next_sequence);
+    if (decoder->synced && gap > 0) {
+        decoder->lost_blocks += (uint32_t)gap;   // Negative gap: the device restarted, not a loss
+    }
+    decoder->synced = 1;
+    decoder->next_sequence = header->sequence + 1;
+    decoder->frames++;
+    if (decoder->handler) {
+        decoder->handler(decoder->context, header, decoder->samples);
+    }
+}
+
+// Parses as many frames as the buffer holds; keeps an incomplete one for the next push
+static void parse(stream_decoder_t *decoder) {
+    const uint8_t *buf = decoder->buffer;
+    size_t length = decoder->length;
+    size_t pos = 0;
+
+    while (length - pos >= 2) {
+        if (buf[pos] != STREAM_FRAME_MAGIC0 || buf[pos + 1] != STREAM_FRAME_MAGIC1) {
+            pos++;
+            decoder->skipped_bytes++;
+            continue;
+        }
+        if (length - pos < STREAM_FRAME_HEADER_SIZE) {
+            break;
+        }
+        const uint8_t *frame = buf + pos;
+        stream_frame_header_t header = {
+            .channel = frame[2],
+            .format = frame[3],
+            .count = get_u16(frame + 16),
+            .sequence = get_u32(frame + 4),
+            .dropped = get_u32(frame + 8),
+            .sample_rate_hz = get_u32(frame + 12),
+        };
+        if ((header.format != STREAM_FORMAT_PACKED12 && header.format != STREAM_FORMAT_RAW16) ||
+            header.count == 0 || header.count > STREAM_FRAME_MAX_SAMPLES) {
+            decoder->bad_headers++;
+            pos++;                               // Not a real frame start: keep looking
+            continue;
+        }
+        size_t size = STREAM_FRAME_SIZE(header.format, (size_t)header.count);
+        if (length - pos < size) {
+            break;
+        }
+        if (stream_crc16(0xFFFF, frame, size - STREAM_FRAME_CRC_SIZE) != get_u16(frame + size - STREAM_FRAME_CRC_SIZE)) {
+            decoder->crc_errors++;
+            pos++;
+            continue;
+        }
+        deliver(decoder, frame, &header);
+        pos += size;
+    }
+    if (length - pos == 1 && buf[pos] != STREAM_FRAME_MAGIC0) {
+        pos++;
+        decoder->skipped_bytes++;
+    }
+    memmove(decoder->buffer, decoder->buffer + pos, length - pos);
+    decoder->length = length - pos;
+}
+
+void stream_decoder_push(stream_decoder_t *decoder, const uint8_t *data, size_t length) {
+    while (length > 0) {
+        size_t room = sizeof(decoder->buffer) - decoder->length;
+        size_t chunk = length < room ? length : room;
+        memcpy(decoder->buffer + decoder->length, data, chunk);
+        decoder->length += chunk;
+        data += chunk;
+        length -= chunk;
+        parse(decoder);
+    }
+}
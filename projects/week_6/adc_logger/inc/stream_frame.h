@@ -0,0 +1,117 @@
+// Embarcatech, April 2025 - Binary sample framing for the ADC logger
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Compact framing for streaming ADC blocks over a byte pipe (USB CDC,
+    UART, a file or a test loopback). Frame layout, little endian:
+
+        offset  size  field
+        0       2     magic 0xA5 0x5A
+        2       1     ADC channel (0-4)
+        3       1     format: 0 = 12-bit packed (2 samples in 3 bytes),
+                              1 = 16-bit
+        4       4     block sequence number (a gap = blocks lost)
+        8       4     blocks dropped by the device so far
+        12      4     sample rate (Hz)
+        16      2     samples in the block
+        18      n     payload
+        18+n    2     CRC-16/CCITT-FALSE of bytes 0 .. 17+n
+
+    Key Features:
+    - 12-bit packing: 1.5 bytes per sample, ~1% framing overhead on a
+      1024-sample block
+    - Decoder resynchronizes on the magic after corrupted or partial data
+      and checks the CRC, so a lost USB packet costs one block, not the
+      stream
+    - No Pico SDK dependency: the same file builds the firmware, the host
+      receiver and the loopback test
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stddef.h>   // size_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STREAM_FRAME_MAGIC0 0xA5
+#define STREAM_FRAME_MAGIC1 0x5A
+#define STREAM_FRAME_HEADER_SIZE 18
+#define STREAM_FRAME_CRC_SIZE 2
+#define STREAM_FRAME_MAX_SAMPLES 2048   // Largest block a decoder accepts
+
+#define STREAM_FORMAT_PACKED12 0        // 2 samples in 3 bytes (odd count: last one in 2 bytes)
+#define STREAM_FORMAT_RAW16 1           // 2 bytes per sample
+
+// Bytes of a whole frame for `samples` samples
+#define STREAM_FRAME_SIZE(format, samples) \
+    (STREAM_FRAME_HEADER_SIZE + STREAM_FRAME_CRC_SIZE + \
+     ((format) == STREAM_FORMAT_PACKED12 ? ((samples) * 3 + 1) / 2 : (samples) * 2))
+
+// Return codes
+#define STREAM_FRAME_BAD_FORMAT -1      // Unknown format
+#define STREAM_FRAME_TOO_LONG -2        // More than STREAM_FRAME_MAX_SAMPLES
+#define STREAM_FRAME_NO_ROOM -3         // Output buffer too small
+
+/**
+ * @brief Header fields of a frame
+ */
+typedef struct {
+    uint8_t channel;                    // ADC input (0-4)
+    uint8_t format;                     // STREAM_FORMAT_*
+    uint16_t count;                     // Samples in the block
+    uint32_t sequence;                  // Block number since the capture started
+    uint32_t dropped;                   // Blocks the device could not send, so far
+    uint32_t sample_rate_hz;
+} stream_frame_header_t;
+
+/**
+ * @brief Called by the decoder for every frame that passes the CRC check
+ */
+typedef void (*stream_frame_handler_t)(void *context, const stream_frame_header_t *header, const uint16_t *samples);
+
+/**
+ * @brief Streaming decoder state (bytes may arrive in any chunk sizes)
+ */
+typedef struct {
+    stream_frame_handler_t handler;
+    void *context;
+    uint32_t frames;                    // Frames delivered
+    uint32_t crc_errors;                // Frames with a bad CRC (discarded)
+    uint32_t bad_headers;               // Headers with an unknown format or count (discarded)
+    uint32_t skipped_bytes;             // Bytes discarded while looking for the magic
+    uint32_t lost_blocks;               // Sequence gaps between delivered frames
+    uint32_t next_sequence;             // Expected sequence of the next frame
+    uint8_t synced;                     // A frame has been delivered since init
+    size_t length;                      // Bytes waiting in buffer
+    uint8_t buffer[2 * STREAM_FRAME_SIZE(STREAM_FORMAT_RAW16, STREAM_FRAME_MAX_SAMPLES)];
+    uint16_t samples[STREAM_FRAME_MAX_SAMPLES];
+} stream_decoder_t;
+
+/**
+ * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), continued from `crc`
+ */
+uint16_t stream_crc16(uint16_t crc, const uint8_t *data, size_t length);
+
+/**
+ * @brief Builds one frame from 12-bit samples
+ *
+ * @return Frame size in bytes, or STREAM_FRAME_BAD_FORMAT, STREAM_FRAME_TOO_LONG, STREAM_FRAME_NO_ROOM
+ */
+int stream_frame_encode(const stream_frame_header_t *header, const uint16_t *samples, uint8_t *out, size_t out_size);
+
+/**
+ * @brief Clears the decoder and sets the frame handler
+ */
+void stream_decoder_init(stream_decoder_t *decoder, stream_frame_handler_t handler, void *context);
+
+/**
+ * @brief Feeds received bytes; calls the handler for each complete, valid frame
+ */
+void stream_decoder_push(stream_decoder_t *decoder, const uint8_t *data, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,47 @@
+// Embarcatech, April 2025 - Block sender for the ADC logger
+// Author: Filipe Alves de Sousa
+
+#include "stream_sender.h"
+
+void stream_sender_init(stream_sender_t *sender, const stream_transport_t *transport, uint8_t channel, uint8_t format,
+                        uint32_t sample_rate_hz) {
+    sender->transport = *transport;
+    sender->channel = channel;
+    sender->format = format;
+    sender->sample_rate_hz = sample_rate_hz;
+    sender->dropped = 0;
+    sender->sent = 0;
+    sender->pending = 0;
+}
+
+int stream_sender_prepare(stream_sender_t *sender, uint32_t sequence, const uint16_t *samples, uint16_t count) {
+    stream_frame_header_t header = {
+        .channel = sender->channel,
+        .format = sender->format,
+        .count = count,
+        .sequence = sequence,
+        .dropped = sender->dropped,
+        .sample_rate_hz = sender->sample_rate_hz,
+    };
+    int size = stream_frame_encode(&header, samples, sender->frame, sizeof(sender->frame));
+    sender->pending = size > 0 ? size : 0;
+    return size;
+}
+
+bool stream_sender_send(stream_sender_t *sender) {
+    if (sender->pending == 0) {
+        return false;
+    }
+    size_t size = (size_t)sender->pending;
+    sender->pending = 0;
+    if (sender->transport.write(sender->transport.context, sender->frame, size) < size) {
+        sender->dropped++;                   // The host drops the partial frame on its CRC
+        return false;
+    }
+    sender->sent++;
+    return true;
+}
+
+void stream_sender_drop(stream_sender_t *sender, uint32_t blocks) {
+    sender->dropped += blocks;
+}
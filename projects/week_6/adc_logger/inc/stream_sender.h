@@ -0,0 +1,80 @@
+// Embarcatech, April 2025 - Block sender for the ADC logger
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Turns captured blocks into frames (stream_frame.h) and hands them to
+    a transport: a write function and its context. The firmware plugs in
+    USB CDC; the loopback test plugs in a memory pipe that can cut and
+    corrupt bytes. Sending is split in two steps so the caller can check
+    between them that the block was not overwritten while it was encoded.
+
+    Key Features:
+    - Any byte pipe as transport (USB CDC, UART, file, test loopback)
+    - Counts blocks that were skipped or only partly written; the count
+      travels in every frame header, so the host sees device-side drops
+    - No Pico SDK dependency
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include "stream_frame.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STREAM_SENDER_MAX_SAMPLES 1024   // Largest block sent
+
+/**
+ * @brief Byte pipe: write() returns how many bytes it took (fewer = failed)
+ */
+typedef struct {
+    size_t (*write)(void *context, const uint8_t *data, size_t length);
+    void *context;
+} stream_transport_t;
+
+/**
+ * @brief Sender state, with room for one encoded frame
+ */
+typedef struct {
+    stream_transport_t transport;
+    uint8_t channel;                     // Copied into every frame
+    uint8_t format;                      // STREAM_FORMAT_*
+    uint32_t sample_rate_hz;
+    uint32_t dropped;                    // Blocks skipped or not fully written
+    uint32_t sent;                       // Frames fully written
+    int pending;                         // Size of the prepared frame, 0 if none
+    uint8_t frame[STREAM_FRAME_SIZE(STREAM_FORMAT_RAW16, STREAM_SENDER_MAX_SAMPLES)];
+} stream_sender_t;
+
+/**
+ * @brief Sets the transport and the stream parameters
+ */
+void stream_sender_init(stream_sender_t *sender, const stream_transport_t *transport, uint8_t channel, uint8_t format,
+                        uint32_t sample_rate_hz);
+
+/**
+ * @brief Encodes block `sequence` into the sender's frame buffer
+ *
+ * @return Frame size, or a STREAM_FRAME_* error (count above STREAM_SENDER_MAX_SAMPLES: STREAM_FRAME_NO_ROOM)
+ */
+int stream_sender_prepare(stream_sender_t *sender, uint32_t sequence, const uint16_t *samples, uint16_t count);
+
+/**
+ * @brief Writes the prepared frame
+ *
+ * @return false if the transport took less than the whole frame (counted as dropped)
+ */
+bool stream_sender_send(stream_sender_t *sender);
+
+/**
+ * @brief Counts blocks lost before reaching the sender (e.g. overwritten in the capture ring)
+ */
+void stream_sender_drop(stream_sender_t *sender, uint32_t blocks);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,190 @@
+// Embarcatech, April 2025 - ADC logger loopback test (host)
+// Author: Filipe Alves de Sousa
+// Sends synthetic ADC blocks through stream_sender into a mock transport (a
+// memory pipe that can cut writes short, flip bytes and inject text), and
+// decodes the pipe with the receiver's decoder fed in random chunk sizes.
+// Checks that clean blocks arrive sample-exact and that every fault is
+// reported as a dropped or lost block without losing the blocks around it.
+// With a file argument, the clean stream is also written there, so the
+// receiver can be tried without a board: ./adc_receiver - out.bin < file
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -Iinc tests/test_stream_loopback.c inc/stream_sender.c inc/stream_frame.c -o test_stream_loopback
+//   ./test_stream_loopback [stream.raw]   (exit code 0 when all checks pass)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf(), fopen()
+#include <string.h>    // memcpy(), memcmp()
+#include "stream_sender.h"
+
+#define BLOCK 1024             // Samples per block, as in adc_stream.h
+#define BLOCKS 200             // Blocks per test
+
+typedef struct {
+    uint8_t data[2 * BLOCKS * STREAM_FRAME_SIZE(STREAM_FORMAT_RAW16, BLOCK)];
+    size_t length;
+    size_t accept_next;        // Bytes the next write takes (0: all)
+} mock_pipe_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t mismatches;
+    uint32_t last_dropped;     // Device drop counter of the latest frame
+} check_t;
+
+static mock_pipe_t pipe_;
+static stream_decoder_t decoder;
+static uint16_t expected[BLOCKS][BLOCK];
+static uint32_t rng = 2025;
+
+static uint32_t next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static size_t mock_write(void *context, const uint8_t *data, size_t length) {
+    mock_pipe_t *p = context;
+    size_t n = p->accept_next && p->accept_next < length ? p->accept_next : length;
+    p->accept_next = 0;
+    memcpy(p->data + p->length, data, n);
+    p->length += n;
+    return n;
+}
+
+// 12-bit test signal: a ramp plus noise, different in every block
+static void make_block(uint32_t sequence, uint16_t *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = (uint16_t)(((sequence * 37 + i * 3) + (next_random() & 15)) & 0x0FFF);
+    }
+}
+
+static void on_frame(void *context, const stream_frame_header_t *header, const uint16_t *samples) {
+    check_t *c = context;
+    c->frames++;
+    c->last_dropped = header->dropped;
+    if (header->sequence >= BLOCKS ||
+        memcmp(samples, expected[header->sequence], header->count * sizeof(uint16_t)) != 0) {
+        c->mismatches++;
+    }
+}
+
+// Decodes the pipe in random chunks of 1..700 bytes (USB reads do not follow frame boundaries)
+static void decode_pipe(check_t *c) {
+    memset(c, 0, sizeof(*c));
+    stream_decoder_init(&decoder, on_frame, c);
+    for (size_t pos = 0; pos < pipe_.length;) {
+        size_t chunk = 1 + next_random() % 700;
+        if (chunk > pipe_.length - pos) {
+            chunk = pipe_.length - pos;
+        }
+        stream_decoder_push(&decoder, pipe_.data + pos, chunk);
+        pos += chunk;
+    }
+}
+
+static int report(const char *name, int ok) {
+    printf("%-52s %s\n", name, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+static void send_all(stream_sender_t *sender, uint8_t format, size_t count, int fault) {
+    stream_transport_t transport = { mock_write, &pipe_ };
+    stream_sender_init(sender, &transport, 4, format, 500000);
+    pipe_.length = 0;
+    for (uint32_t seq = 0; seq < BLOCKS; seq++) {
+        make_block(seq, expected[seq], count);
+        if (fault == 1 && seq == 50) {
+            stream_sender_drop(sender, 3);                   // Capture ring lapped: 50..52 never sent
+            seq += 2;
+            continue;
+        }
+        stream_sender_prepare(sender, seq, expected[seq], (uint16_t)count);
+        if (fault == 2 && seq == 80) {
+            pipe_.accept_next = 700;                         // USB stalled halfway through a frame
+        }
+        if (fault == 3 && seq == 120) {
+            sender->frame[STREAM_FRAME_HEADER_SIZE + 100] ^= 0x10;  // Bit flip on the wire
+        }
+        if (fault == 4 && seq == 150) {
+            const char text[] = "debug printf\r\n";          // Stray text between frames
+            mock_write(&pipe_, (const uint8_t *)text, sizeof(text) - 1);
+        }
+        stream_sender_send(sender);
+    }
+}
+
+int main(int argc, char **argv) {
+    static stream_sender_t sender;
+    check_t c;
+    int failures = 0;
+
+    send_all(&sender, STREAM_FORMAT_PACKED12, BLOCK, 0);
+    if (argc > 1) {
+        FILE *f = fopen(argv[1], "wb");
+        if (f) {
+            fwrite(pipe_.data, 1, pipe_.length, f);
+            fclose(f);
+        }
+    }
+    decode_pipe(&c);
+    failures += report("Clean stream, 12-bit packed: all blocks exact",
+                       c.frames == BLOCKS && c.mismatches == 0 && decoder.lost_blocks == 0 &&
+                           decoder.crc_errors == 0 && decoder.skipped_bytes == 0);
+    failures += report("Packed size: 1.5 bytes per sample + 20 per frame",
+                       pipe_.length == (size_t)BLOCKS * (BLOCK * 3 / 2 + 20));
+
+    send_all(&sender, STREAM_FORMAT_RAW16, 333, 0);
+    decode_pipe(&c);
+    failures += report("Clean stream, 16-bit, odd block size", c.frames == BLOCKS && c.mismatches == 0);
+    send_all(&sender, STREAM_FORMAT_PACKED12, 333, 0);
+    decode_pipe(&c);
+    failures += report("Clean stream, 12-bit packed, odd block size", c.frames == BLOCKS && c.mismatches == 0);
+
+    send_all(&sender, STREAM_FORMAT_PACKED12, BLOCK, 1);
+    decode_pipe(&c);
+    failures += report("Ring lap: 3 blocks dropped, reported both ways",
+                       c.frames == BLOCKS - 3 && c.mismatches == 0 && decoder.lost_blocks == 3 && c.last_dropped == 3);
+
+    send_all(&sender, STREAM_FORMAT_PACKED12, BLOCK, 2);
+    decode_pipe(&c);
+    failures += report("Short write: partial frame dropped, next ones kept",
+                       c.frames == BLOCKS - 1 && c.mismatches == 0 && decoder.lost_blocks == 1 &&
+                           sender.dropped == 1 && c.last_dropped == 1);
+
+    send_all(&sender, STREAM_FORMAT_PACKED12, BLOCK, 3);
+    decode_pipe(&c);
+    failures += report("Bit flip: CRC rejects one frame, next ones kept",
+                       c.frames == BLOCKS - 1 && c.mismatches == 0 && decoder.crc_errors == 1 &&
+                           decoder.lost_blocks == 1);
+
+    send_all(&sender, STREAM_FORMAT_PACKED12, BLOCK, 4);
+    decode_pipe(&c);
+    failures += report("Stray text: skipped, no block lost",
+                       c.frames == BLOCKS && c.mismatches == 0 && decoder.lost_blocks == 0 &&
+                           decoder.skipped_bytes == 14);
+
+    // Device restarted (new channel): sequence back to 0 is not a loss
+    send_all(&sender, STREAM_FORMAT_PACKED12, BLOCK, 0);
+    size_t first = pipe_.length;
+    memcpy(pipe_.data + first, pipe_.data, first / 2 - (first / 2) % STREAM_FRAME_SIZE(STREAM_FORMAT_PACKED12, BLOCK));
+    pipe_.length = first + first / 2 - (first / 2) % STREAM_FRAME_SIZE(STREAM_FORMAT_PACKED12, BLOCK);
+    decode_pipe(&c);
+    failures += report("Restart: sequence back to 0 not counted as lost",
+                       c.frames == BLOCKS + BLOCKS / 2 && c.mismatches == 0 && decoder.lost_blocks == 0);
+
+    uint16_t one[3] = { 1, 2, 3 };
+    uint8_t small[8];
+    stream_frame_header_t header = { .format = STREAM_FORMAT_PACKED12, .count = 3 };
+    int too_long = stream_frame_encode(&(stream_frame_header_t){ .count = STREAM_FRAME_MAX_SAMPLES + 1 }, one,
+                                       pipe_.data, sizeof(pipe_.data));
+    failures += report("Encoder errors (no room, too long, bad format)",
+                       stream_frame_encode(&header, one, small, sizeof(small)) == STREAM_FRAME_NO_ROOM &&
+                           too_long == STREAM_FRAME_TOO_LONG &&
+                           stream_frame_encode(&(stream_frame_header_t){ .format = 7 }, one, small, sizeof(small)) ==
+                               STREAM_FRAME_BAD_FORMAT);
+
+    printf("\n%s\n", failures ? "FAILED" : "All checks passed");
+    return failures ? 1 : 0;
+}
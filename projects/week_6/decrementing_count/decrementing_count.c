@@ -6,6 +6,7 @@
 #include "hardware/i2c.h"               // Includes functions for I2C communication (used by OLED display)
 #include "hardware/gpio.h"              // Includes GPIO functions for pin control and interrupt handling
 #include "inc/ssd1306.h"                // Includes declarations and definitions to control the OLED SSD1306 display
+#include "inc/ssd1306_number.h"         // Draws numbers straight into the OLED buffer (no sprintf)
 #include <string.h>                     // Includes functions for string manipulation (e.g., memset)
 
 // Pin definitions for buttons and I2C (OLED display)
@@ -40,13 +41,11 @@ absolute_time_t last_button_b_time = { 0 };    // Tracks last time Button B was
 // Updates the OLED display with the current counter value and Button B click count
 void update_oled() {
     memset(oled_buffer, 0, sizeof(oled_buffer)); // Clears the display buffer
-    char msg[40];                                // Buffer for message formatting
-    sprintf(msg, "Counter: %d", counter);        // Formats the counter value into the message
-    ssd1306_draw_string(oled_buffer, 5, 10, msg); // Draws the counter message at specified position on the display
-    sprintf(msg, "Clicks B: %d", button_b_clicks); // Formats the Button B click count into the message
-    ssd1306_draw_string(oled_buffer, 5, 30, msg); // Draws the click count message below the counter message
-    sprintf(msg, "restart A");                 // Adds instruction to restart the process
-    ssd1306_draw_string(oled_buffer, 5, 50, msg); // Draws the restart message on the last line
+    int16_t x = ssd1306_draw_text(oled_buffer, 5, 10, "Counter: "); // Draws the counter label at specified position on the display
+    ssd1306_draw_int(oled_buffer, x, 10, counter); // Draws the counter value right after it
+    x = ssd1306_draw_text(oled_buffer, 5, 30, "Clicks B: "); // Draws the click count label below the counter message
+    ssd1306_draw_int(oled_buffer, x, 30, button_b_clicks); // Draws the Button B click count right after it
+    ssd1306_draw_text(oled_buffer, 5, 50, "restart A"); // Draws the restart instruction on the last line
     calculate_render_area_buffer_length(&oled_area); // Recalculates the render area
     render_on_display(oled_buffer, &oled_area);    // Renders the buffer content onto the OLED display
 }
@@ -0,0 +1,95 @@
+// Embarcatech, April 2025 - Divide-free integer formatting
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    weights[i] holds 8, 4, 2 and 1 times 10^(9 - i). The top position
+    (10^9) only needs 4, 2 and 1: a 32-bit value is below 4.3 x 10^9,
+    and 8 x 10^9 would not fit in the table anyway.
+    ======================================================================== */
+
+#include "number_format.h"
+
+static const uint32_t weights[10][4] = {
+    { 0, 4000000000u, 2000000000u, 1000000000u },
+    { 800000000u, 400000000u, 200000000u, 100000000u },
+    { 80000000u, 40000000u, 20000000u, 10000000u },
+    { 8000000u, 4000000u, 2000000u, 1000000u },
+    { 800000u, 400000u, 200000u, 100000u },
+    { 80000u, 40000u, 20000u, 10000u },
+    { 8000u, 4000u, 2000u, 1000u },
+    { 800u, 400u, 200u, 100u },
+    { 80u, 40u, 20u, 10u },
+    { 8u, 4u, 2u, 1u }
+};
+
+// Writes the digits of value, zero-padded to at least min_digits (1..10); returns the count
+static int put_digits(char *out, uint32_t value, int min_digits) {
+    int position = 0;
+    while (position < 9 && value < weights[position][3] && 10 - position > min_digits) {
+        position++;                             // Leading zero
+    }
+    int count = 0;
+    for (; position < 10; position++) {
+        const uint32_t *w = weights[position];
+        char digit = '0';
+        if (w[0] && value >= w[0]) {
+            value -= w[0];
+            digit += 8;
+        }
+        if (value >= w[1]) {
+            value -= w[1];
+            digit += 4;
+        }
+        if (value >= w[2]) {
+            value -= w[2];
+            digit += 2;
+        }
+        if (value >= w[3]) {
+            value -= w[3];
+            digit += 1;
+        }
+        out[count++] = digit;
+    }
+    return count;
+}
+
+int number_format_uint(char *out, uint32_t value) {
+    int count = put_digits(out, value, 1);
+    out[count] = '\0';
+    return count;
+}
+
+int number_format_int(char *out, int32_t value) {
+    int count = 0;
+    uint32_t magnitude = (uint32_t)value;
+    if (value < 0) {
+        out[count++] = '-';
+        magnitude = 0u - magnitude;             // Also right for INT32_MIN
+    }
+    count += put_digits(out + count, magnitude, 1);
+    out[count] = '\0';
+    return count;
+}
+
+int number_format_fixed(char *out, int32_t value, uint8_t decimals) {
+    if (decimals > NUMBER_FORMAT_MAX_DECIMALS) {
+        decimals = NUMBER_FORMAT_MAX_DECIMALS;
+    }
+    int count = 0;
+    uint32_t magnitude = (uint32_t)value;
+    if (value < 0) {
+        out[count++] = '-';
+        magnitude = 0u - magnitude;
+    }
+    int digits = put_digits(out + count, magnitude, decimals + 1); // At least one digit before the point
+    count += digits;
+    if (decimals) {
+        for (int i = 0; i < decimals; i++) {    // Opens a gap for the point before the last `decimals` digits
+            out[count - i] = out[count - i - 1];
+        }
+        out[count - decimals] = '.';
+        count++;
+    }
+    out[count] = '\0';
+    return count;
+}
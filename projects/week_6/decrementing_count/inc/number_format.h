@@ -0,0 +1,55 @@
+// Embarcatech, April 2025 - Divide-free integer formatting
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Turns integers into decimal text without printf and without dividing.
+    Each decimal digit is found by comparing the value with 8, 4, 2 and 1
+    times the digit's power of ten and subtracting the ones that fit (a
+    binary search over the digit), so a digit costs at most four compares
+    and four subtractions: no division, no 64-bit multiply, no float.
+
+    Fixed-point values are integers with a known number of decimals
+    (e.g. 2731 with 2 decimals is "27.31"), which is how the apps keep
+    temperatures (centi-degrees); nothing is converted from float.
+
+    Key Features:
+    - Unsigned, signed and fixed-point formatting into a caller buffer
+    - Exact for the whole 32-bit range (same text as printf "%u", "%d")
+    - No hardware dependency: usable and testable on the host
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUMBER_FORMAT_MAX_DECIMALS 9
+#define NUMBER_FORMAT_MAX_CHARS 13       // "-2147483648" or "-2.147483648", plus the terminator
+
+/**
+ * @brief Writes value as decimal text ("%u")
+ * @return Characters written, not counting the terminator
+ */
+int number_format_uint(char *out, uint32_t value);
+
+/**
+ * @brief Writes value as decimal text with a '-' when negative ("%d")
+ * @return Characters written, not counting the terminator
+ */
+int number_format_int(char *out, int32_t value);
+
+/**
+ * @brief Writes a fixed-point value: value / 10^decimals with exactly `decimals` digits
+ *        after the point (e.g. -5 with 2 decimals is "-0.05")
+ *
+ * @param decimals 0..NUMBER_FORMAT_MAX_DECIMALS (larger is clamped); 0 writes no point
+ * @return Characters written, not counting the terminator
+ */
+int number_format_fixed(char *out, int32_t value, uint8_t decimals);
+
+#ifdef __cplusplus
+}
+#endif
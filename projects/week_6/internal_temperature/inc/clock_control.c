@@ -0,0 +1,93 @@
+// Embarcatech, April 2025 - System clock changes with peripheral retuning
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    set_sys_clock_khz() also moves clk_peri to the new system clock, so
+    I2C, UART and PWM dividers computed at start-up are wrong afterwards.
+    clk_adc comes from the USB PLL and keeps its 48 MHz; its divider is
+    recomputed anyway, which stays right if clk_adc is ever moved.
+    ======================================================================== */
+
+#include "pico/stdlib.h"       // set_sys_clock_khz(), check_sys_clock_khz(), sleep_ms()
+#include "hardware/vreg.h"     // Core voltage regulator
+#include "hardware/clocks.h"   // clock_get_hz()
+#include "hardware/pwm.h"      // PWM dividers
+#include "hardware/adc.h"      // ADC divider
+#include "hardware/uart.h"     // stdio UART baud rate
+#include "clock_control.h"
+
+#define VREG_SETTLE_MS 10      // Settling time after raising the core voltage
+
+typedef struct {
+    i2c_inst_t *i2c;
+    uint32_t baudrate;
+} i2c_entry_t;
+
+typedef struct {
+    uint8_t slice;
+    uint16_t wrap;
+    uint32_t frequency_hz;
+} pwm_entry_t;
+
+static i2c_entry_t i2c_entries[CLOCK_CONTROL_MAX_I2C];
+static pwm_entry_t pwm_entries[CLOCK_CONTROL_MAX_PWM];
+static uint8_t i2c_count, pwm_count;
+static uint32_t adc_rate_hz;
+
+int clock_control_add_i2c(i2c_inst_t *i2c, uint32_t baudrate) {
+    if (i2c_count == CLOCK_CONTROL_MAX_I2C) {
+        return CLOCK_CONTROL_FULL;
+    }
+    i2c_entries[i2c_count++] = (i2c_entry_t){ i2c, baudrate };
+    return CLOCK_CONTROL_OK;
+}
+
+int clock_control_add_pwm(uint8_t slice, uint32_t frequency_hz, uint16_t wrap) {
+    if (pwm_count == CLOCK_CONTROL_MAX_PWM) {
+        return CLOCK_CONTROL_FULL;
+    }
+    pwm_entries[pwm_count++] = (pwm_entry_t){ slice, wrap, frequency_hz };
+    return CLOCK_CONTROL_OK;
+}
+
+void clock_control_set_adc_rate(uint32_t sample_rate_hz) {
+    adc_rate_hz = sample_rate_hz;
+}
+
+void clock_control_retune(void) {
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    for (int i = 0; i < i2c_count; i++) {
+        i2c_set_baudrate(i2c_entries[i].i2c, i2c_entries[i].baudrate);  // Reads clk_peri itself
+    }
+    for (int i = 0; i < pwm_count; i++) {
+        // Divider = clk_sys / (f * (wrap + 1)), 8.4 fixed point, 1 to 255.9375
+        const pwm_entry_t *p = &pwm_entries[i];
+        uint32_t div_q4 = (uint32_t)(((uint64_t)sys_hz * 16) / ((uint64_t)p->frequency_hz * (p->wrap + 1u)));
+        div_q4 = div_q4 < 16 ? 16 : div_q4 > 0xFFF ? 0xFFF : div_q4;
+        pwm_set_clkdiv_int_frac(p->slice, (uint8_t)(div_q4 >> 4), (uint8_t)(div_q4 & 0xF));
+    }
+    if (adc_rate_hz) {
+        float div = (float)clock_get_hz(clk_adc) / adc_rate_hz - 1.0f;  // Below 96: back-to-back
+        adc_set_clkdiv(div < 0 ? 0 : div);
+    }
+#if LIB_PICO_STDIO_UART
+    uart_set_baudrate(uart_default, PICO_DEFAULT_UART_BAUD_RATE);
+#endif
+}
+
+int clock_control_apply(const clock_level_t *from, const clock_level_t *to) {
+    uint vco, postdiv1, postdiv2;
+    if (!check_sys_clock_khz(to->sys_khz, &vco, &postdiv1, &postdiv2)) {
+        return CLOCK_CONTROL_UNREACHABLE;
+    }
+    if (to->vsel > from->vsel) {
+        vreg_set_voltage((enum vreg_voltage)to->vsel);  // Voltage first: the faster clock needs it
+        sleep_ms(VREG_SETTLE_MS);
+    }
+    set_sys_clock_pll(vco, postdiv1, postdiv2);
+    if (to->vsel < from->vsel) {
+        vreg_set_voltage((enum vreg_voltage)to->vsel);  // Clock already down: safe to lower
+    }
+    clock_control_retune();
+    return CLOCK_CONTROL_OK;
+}
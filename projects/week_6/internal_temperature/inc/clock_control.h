@@ -0,0 +1,64 @@
+// Embarcatech, April 2025 - System clock changes with peripheral retuning
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Applies a clock_level_t: core voltage and system clock in a safe
+    order, then recomputes the dividers of the peripherals clocked from
+    clk_sys / clk_peri, which set_sys_clock_khz() changes with it.
+
+    Key Features:
+    - Voltage raised before a faster clock, lowered after a slower one
+    - Registered I2C ports get their baud rate back, PWM slices their
+      frequency, the ADC its sample rate; the stdio UART is retuned too
+    - Unreachable clocks are refused before anything is changed
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool
+#include "hardware/i2c.h"      // i2c_inst_t
+#include "clock_governor.h"    // clock_level_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CLOCK_CONTROL_MAX_I2C 2
+#define CLOCK_CONTROL_MAX_PWM 8
+
+// Return codes
+#define CLOCK_CONTROL_OK 0
+#define CLOCK_CONTROL_UNREACHABLE -1     // The PLL cannot make this clock exactly
+#define CLOCK_CONTROL_FULL -2            // No room to register another peripheral
+
+/**
+ * @brief Keeps an I2C port at `baudrate` across clock changes
+ */
+int clock_control_add_i2c(i2c_inst_t *i2c, uint32_t baudrate);
+
+/**
+ * @brief Keeps a PWM slice at `frequency_hz` (with its wrap value `wrap`) across clock changes
+ */
+int clock_control_add_pwm(uint8_t slice, uint32_t frequency_hz, uint16_t wrap);
+
+/**
+ * @brief Keeps the ADC free-running sample rate across clock changes (0 = not used)
+ */
+void clock_control_set_adc_rate(uint32_t sample_rate_hz);
+
+/**
+ * @brief Switches to `to` from `from` and retunes the registered peripherals
+ *
+ * @return CLOCK_CONTROL_OK or CLOCK_CONTROL_UNREACHABLE (nothing changed)
+ */
+int clock_control_apply(const clock_level_t *from, const clock_level_t *to);
+
+/**
+ * @brief Recomputes the registered dividers for the current clocks (also done by clock_control_apply)
+ */
+void clock_control_retune(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,85 @@
+// Embarcatech, April 2025 - Thermal clock governor (decision logic)
+// Author: Filipe Alves de Sousa
+
+#include "clock_governor.h"
+
+int clock_governor_init(clock_governor_t *governor, const clock_governor_config_t *config, uint8_t start_level,
+                        uint32_t now_ms) {
+    if (config->level_count == 0 || config->level_count > CLOCK_GOVERNOR_MAX_LEVELS) {
+        return CLOCK_GOVERNOR_BAD_LEVELS;
+    }
+    for (int i = 1; i < config->level_count; i++) {
+        const clock_level_t *a = &config->levels[i - 1], *b = &config->levels[i];
+        if (b->sys_khz <= a->sys_khz || (i > 1 && b->max_centi >= a->max_centi)) {
+            return CLOCK_GOVERNOR_BAD_LEVELS;
+        }
+    }
+    if (start_level >= config->level_count) {
+        return CLOCK_GOVERNOR_BAD_START;
+    }
+    if (config->max_hold_ms < config->hold_ms) {
+        return CLOCK_GOVERNOR_BAD_HOLD;
+    }
+    governor->config = *config;
+    governor->level = start_level;
+    governor->primed = false;
+    governor->temp_q8 = 0;
+    governor->last_change_ms = now_ms;
+    governor->hold_ms = config->hold_ms;
+    governor->stepped_up = false;
+    governor->transitions = 0;
+    return CLOCK_GOVERNOR_OK;
+}
+
+int16_t clock_governor_temperature(const clock_governor_t *governor) {
+    return (int16_t)((governor->temp_q8 + 128) >> 8);
+}
+
+bool clock_governor_update(clock_governor_t *governor, int16_t temp_centi, uint32_t now_ms,
+                           clock_transition_t *transition) {
+    const clock_governor_config_t *c = &governor->config;
+    int32_t x_q8 = temp_centi * 256;
+    if (!governor->primed) {
+        governor->temp_q8 = x_q8;
+        governor->primed = true;
+    } else {
+        governor->temp_q8 += (x_q8 - governor->temp_q8) >> c->smoothing_shift;
+    }
+    int16_t temp = clock_governor_temperature(governor);
+
+    int16_t hot = temp_centi - c->emergency_centi;
+    if (hot < temp) {
+        hot = temp;                                  // Smoothed value, unless a raw jump is far worse
+    }
+
+    uint8_t level = governor->level;
+    uint8_t target = level;
+    while (target > 0 && hot > c->levels[target].max_centi) {
+        target--;                                    // Too hot: down to the first level allowed
+    }
+    uint32_t since = now_ms - governor->last_change_ms;
+    if (target < level) {
+        uint32_t hold = governor->hold_ms * 2;       // Back off before trying a faster level again
+        governor->hold_ms = hold > c->max_hold_ms || hold < governor->hold_ms ? c->max_hold_ms : hold;
+    } else if (since >= governor->hold_ms) {
+        if (governor->stepped_up && since >= c->max_hold_ms) {
+            governor->hold_ms = c->hold_ms;          // The level reached is stable: back-off forgiven
+        }
+        if (level + 1 < c->level_count && temp <= c->levels[level + 1].max_centi - c->hysteresis_centi) {
+            target = level + 1;                      // Cool and settled: one level up
+        }
+    }
+    if (target == level) {
+        return false;
+    }
+
+    governor->level = target;
+    governor->stepped_up = target > level;
+    governor->last_change_ms = now_ms;
+    governor->transitions++;
+    transition->from = level;
+    transition->to = target;
+    transition->temp_centi = temp;
+    transition->time_ms = now_ms;
+    return true;
+}
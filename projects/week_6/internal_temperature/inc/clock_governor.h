@@ -0,0 +1,118 @@
+// Embarcatech, April 2025 - Thermal clock governor (decision logic)
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Chooses the system clock level from the chip temperature: overclock
+    while the RP2040 is cool, fall back as it warms up. The logic only
+    sees temperatures and times and returns level changes, so it runs
+    unchanged on the host against recorded temperature traces; applying
+    a level (core voltage, PLL, peripheral dividers) is clock_control.h.
+
+    Levels are ordered from slowest to fastest. Level i may run while the
+    smoothed temperature is at or below its max_centi (level 0 always may):
+    - Too hot for the current level: step down at once, as many levels as
+      needed (no waiting: this is the protective direction). A raw reading
+      more than emergency_centi over a limit counts too, so a sudden jump
+      is not delayed by the smoothing
+    - Cool enough for the next level by hysteresis_centi, and the hold time
+      since the last change: step up one level
+
+    A faster clock heats the chip, often by more than the hysteresis, so
+    an up-step can be undone minutes later. Each thermal step-down doubles
+    the hold time before the next try (up to max_hold_ms); a level held
+    for max_hold_ms after an up-step brings it back to hold_ms.
+
+    Key Features:
+    - Exponential smoothing of the readings (sensor noise ~0.5 C)
+    - Hysteresis band, minimum dwell time and retry back-off against
+      oscillation
+    - Integer only, no Pico SDK dependency
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CLOCK_GOVERNOR_MAX_LEVELS 8
+
+// Return codes
+#define CLOCK_GOVERNOR_OK 0
+#define CLOCK_GOVERNOR_BAD_LEVELS -1     // No levels, too many, or not ordered (clock up, max temperature down)
+#define CLOCK_GOVERNOR_BAD_START -2      // Start level out of range
+#define CLOCK_GOVERNOR_BAD_HOLD -3       // max_hold_ms below hold_ms
+
+/**
+ * @brief One performance level
+ */
+typedef struct {
+    uint32_t sys_khz;                    // System clock (must be reachable by set_sys_clock_khz)
+    uint8_t vsel;                        // Core voltage, an enum vreg_voltage value
+    int16_t max_centi;                   // Highest temperature this level may run at, centi-degrees
+} clock_level_t;
+
+/**
+ * @brief Governor parameters
+ */
+typedef struct {
+    const clock_level_t *levels;         // Slowest first
+    uint8_t level_count;
+    uint8_t smoothing_shift;             // Reading weight 1/2^shift (0 = no smoothing)
+    int16_t hysteresis_centi;            // Margin below the next level's limit before stepping up
+    int16_t emergency_centi;             // Raw reading this far over a limit steps down without smoothing
+    uint32_t hold_ms;                    // Minimum time since the last change before stepping up
+    uint32_t max_hold_ms;                // Longest hold after repeated thermal step-downs
+} clock_governor_config_t;
+
+/**
+ * @brief A level change
+ */
+typedef struct {
+    uint8_t from;
+    uint8_t to;
+    int16_t temp_centi;                  // Smoothed temperature that caused it
+    uint32_t time_ms;
+} clock_transition_t;
+
+/**
+ * @brief Governor state
+ */
+typedef struct {
+    clock_governor_config_t config;
+    uint8_t level;                       // Current level
+    bool primed;                         // Smoothing started
+    int32_t temp_q8;                     // Smoothed temperature, centi-degrees Q8
+    uint32_t last_change_ms;
+    uint32_t hold_ms;                    // Current hold before stepping up (backs off after step-downs)
+    bool stepped_up;                     // The last change was an up-step
+    uint32_t transitions;                // Changes so far
+} clock_governor_t;
+
+/**
+ * @brief Checks the level table and starts at start_level (the level the clock is at now)
+ *
+ * @return CLOCK_GOVERNOR_OK, CLOCK_GOVERNOR_BAD_LEVELS, CLOCK_GOVERNOR_BAD_START or CLOCK_GOVERNOR_BAD_HOLD
+ */
+int clock_governor_init(clock_governor_t *governor, const clock_governor_config_t *config, uint8_t start_level,
+                        uint32_t now_ms);
+
+/**
+ * @brief Feeds one reading
+ *
+ * @return true if the level changed; *transition then says from/to/why
+ */
+bool clock_governor_update(clock_governor_t *governor, int16_t temp_centi, uint32_t now_ms,
+                           clock_transition_t *transition);
+
+/**
+ * @brief Smoothed temperature, centi-degrees
+ */
+int16_t clock_governor_temperature(const clock_governor_t *governor);
+
+#ifdef __cplusplus
+}
+#endif
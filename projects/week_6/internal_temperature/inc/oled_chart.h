@@ -0,0 +1,140 @@
+// Embarcatech, April 2025 - Scrolling chart widget for the SSD1306
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Live chart of the recent history of one value, in a rectangular
+    region of the OLED (whole 8-pixel pages high). The newest sample is
+    the rightmost column; older samples scroll to the left.
+
+    The widget keeps its own pixels for the region, packed in the order
+    render_on_display() sends them (page by page, one byte = 8 vertical
+    pixels of a column), so the region is flushed straight from them.
+    Adding a sample shifts each page one column left with memmove() and
+    draws the new column only; nothing else is recomputed.
+
+    Samples are cheap to add (a ring write); drawing happens in
+    oled_chart_update(), which catches up with everything added since
+    the previous call in one shift. The sample rate is therefore not tied
+    to the display rate: flushing the region over I2C is far slower than
+    drawing it (a 128 x 32 region is 512 bytes, ~46 ms at 100 kHz).
+
+    Key Features:
+    - Fixed circular buffer of the samples on screen (one per column),
+      plus the one before them, so a redraw joins the oldest column
+      exactly as scrolling did
+    - Update in O(pages x width) byte moves plus O(pages) per new column,
+      instead of a full redraw (which is still used after a range change)
+    - Consecutive samples joined by a vertical span, so the line has no
+      gaps; optional filled (area) style
+    - A flat line that stays flat is not redrawn: the update reports no
+      change, so an idle value costs no flush
+    - Fixed range or automatic range with a minimum span
+    - No hardware dependency: usable and testable on the host
+
+    Usage:
+        oled_chart_init(&chart, &config);
+        oled_chart_add(&chart, value);          // At the sample rate
+        if (oled_chart_update(&chart)) {        // At the display rate
+            render_on_display(chart.pixels, &area); // Area = chart region
+        }
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OLED_CHART_MAX_WIDTH 128         // Display width
+#define OLED_CHART_MAX_PAGES 8           // Display height / 8
+
+// Return codes
+#define OLED_CHART_OK 0
+#define OLED_CHART_BAD_REGION -1         // Region empty or off the display
+#define OLED_CHART_BAD_RANGE -2          // Fixed range with max <= min
+
+/**
+ * @brief How a sample is drawn in its column
+ */
+typedef enum {
+    OLED_CHART_LINE,                     // From the previous sample's row to this one
+    OLED_CHART_FILL                      // From the bottom of the region up to the sample
+} oled_chart_style_t;
+
+/**
+ * @brief Chart parameters
+ */
+typedef struct {
+    uint8_t column;                      // Leftmost display column of the region
+    uint8_t page;                        // Top page of the region
+    uint8_t width;                       // Columns (= samples shown)
+    uint8_t pages;                       // Height in pages (8 rows each)
+    oled_chart_style_t style;
+    int16_t min;                         // Value drawn on the bottom row
+    int16_t max;                         // Value drawn on the top row
+    int16_t auto_span;                   // 0: fixed min/max; else range follows the samples, at least this wide
+} oled_chart_config_t;
+
+/**
+ * @brief Chart state
+ */
+typedef struct {
+    oled_chart_config_t config;
+    int16_t min;                         // Current range (follows the samples with auto_span)
+    int16_t max;
+    int16_t samples[OLED_CHART_MAX_WIDTH + 1]; // Ring of the samples on screen, plus the one before them
+    uint8_t head;                        // Slot of the next sample
+    uint8_t count;                       // Samples in the ring (up to width + 1)
+    uint8_t pending;                     // Samples added since the last update (up to width)
+    uint8_t since_fit;                   // Samples since the range was last fitted
+    uint16_t flat;                       // Newest samples in a row with the same value (up to 2 x width + 1)
+    bool redraw;                         // Range changed: next update redraws every column
+    uint8_t last_row;                    // Row of the newest drawn sample (start of the next line span)
+    uint8_t pixels[OLED_CHART_MAX_WIDTH * OLED_CHART_MAX_PAGES]; // Region, width bytes per page
+} oled_chart_t;
+
+/**
+ * @brief Checks the configuration and clears the chart
+ *
+ * @return OLED_CHART_OK, OLED_CHART_BAD_REGION or OLED_CHART_BAD_RANGE
+ */
+int oled_chart_init(oled_chart_t *chart, const oled_chart_config_t *config);
+
+/**
+ * @brief Adds a sample (no drawing). Values outside a fixed range are drawn on
+ *        the top or bottom row; outside an automatic range they widen it
+ */
+void oled_chart_add(oled_chart_t *chart, int16_t value);
+
+/**
+ * @brief Draws the samples added since the previous call
+ *
+ * @return true if the pixels changed (the region needs flushing); false with
+ *         no new sample, or when the line was flat across the region and the
+ *         new samples repeat its value
+ */
+bool oled_chart_update(oled_chart_t *chart);
+
+/**
+ * @brief Clears the pixels and redraws every sample in the ring
+ */
+void oled_chart_redraw(oled_chart_t *chart);
+
+/**
+ * @brief Sets a fixed range (redrawn on the next update)
+ */
+void oled_chart_set_range(oled_chart_t *chart, int16_t min, int16_t max);
+
+/**
+ * @brief Bytes of the region (what one flush sends)
+ */
+static inline uint16_t oled_chart_bytes(const oled_chart_t *chart) {
+    return (uint16_t)(chart->config.width * chart->config.pages);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,32 @@
+// Embarcatech, April 2025 - SSD1306 number drawing without printf
+// Author: Filipe Alves de Sousa
+
+#include "ssd1306.h"         // ssd1306_draw_char()
+#include "number_format.h"   // Divide-free digits
+#include "ssd1306_number.h"
+
+int16_t ssd1306_draw_text(uint8_t *ssd, int16_t x, int16_t y, const char *text) {
+    while (*text) {
+        ssd1306_draw_char(ssd, x, y, (uint8_t)*text++);
+        x += SSD1306_GLYPH_WIDTH;
+    }
+    return x;
+}
+
+int16_t ssd1306_draw_uint(uint8_t *ssd, int16_t x, int16_t y, uint32_t value) {
+    char digits[NUMBER_FORMAT_MAX_CHARS];
+    number_format_uint(digits, value);
+    return ssd1306_draw_text(ssd, x, y, digits);
+}
+
+int16_t ssd1306_draw_int(uint8_t *ssd, int16_t x, int16_t y, int32_t value) {
+    char digits[NUMBER_FORMAT_MAX_CHARS];
+    number_format_int(digits, value);
+    return ssd1306_draw_text(ssd, x, y, digits);
+}
+
+int16_t ssd1306_draw_fixed(uint8_t *ssd, int16_t x, int16_t y, int32_t value, uint8_t decimals) {
+    char digits[NUMBER_FORMAT_MAX_CHARS];
+    number_format_fixed(digits, value, decimals);
+    return ssd1306_draw_text(ssd, x, y, digits);
+}
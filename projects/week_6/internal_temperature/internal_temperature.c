@@ -1,16 +1,26 @@
 // Embarcatech, April 2025 - "RP2040 Internal Temperature Reader"
 // Author: Filipe Alves de Sousa
 // This program reads the internal temperature sensor of the Raspberry Pi Pico (RP2040)
-// and displays the temperature in Celsius on both the serial terminal and an OLED display.
+// and displays the temperature in Celsius on both the serial terminal and an OLED display,
+// together with its running statistics (mean, deviation, min/max, 95th percentile, trend)
+// and, on the OLED, a scrolling chart of the last two minutes.
+// A thermal governor overclocks the chip while it is cool and slows it down as it warms up.
 //----------------------------------------------------------------------------------------------
 
 #include <stdio.h>              // Provides standard input/output functions like printf()
-#include <string.h>            // Includes functions for memory and string operations (e.g., memset, snprintf)
+#include <string.h>            // Includes functions for memory and string operations (e.g., memset)
 #include "pico/stdlib.h"       // Includes Pico SDK utilities (GPIO, sleep, etc.)
 #include "hardware/adc.h"      // Provides functions to interact with the ADC (Analog-to-Digital Converter)
 #include "hardware/gpio.h"     // Enables configuration of GPIO pins
 #include "hardware/i2c.h"      // Used for I2C communication setup and control
 #include "inc/ssd1306.h"       // Custom OLED library to control the SSD1306 display via I2C
+#include "inc/sensor_stats.h"  // Running statistics without sample history (integer, O(1) per reading)
+#include "hardware/clocks.h"   // clock_get_hz(), to find the clock level at startup
+#include "hardware/vreg.h"     // Core voltage levels of the clock table
+#include "inc/clock_governor.h" // Chooses the clock level from the temperature (hysteresis, back-off)
+#include "inc/clock_control.h" // Applies a level: voltage, PLL, I2C divider
+#include "inc/oled_chart.h"    // Scrolling chart: draws only the new column of each reading
+#include "inc/ssd1306_number.h" // Draws numbers straight into the OLED buffer (no snprintf, no float)
 
 // === OLED DISPLAY CONFIGURATION ===
 #define SDA_PIN 14             // Assigns GPIO 14 as the SDA line for I2C communication
@@ -18,6 +28,38 @@
 #define I2C_PORT i2c1          // Specifies the I2C1 hardware peripheral to be used
 #define I2C_SPEED 100000       // Sets I2C communication speed to 100 kHz
 
+// === STATISTICS CONFIGURATION ===
+#define HIST_MIN_CENTI 2000    // Histogram from 20.00 C...
+#define HIST_BIN_CENTI 100     // ...in 1 C bins...
+#define HIST_BINS 16           // ...up to 36.00 C
+#define HIST_PRINT_EVERY 60    // Prints the histogram every 60 readings (1 minute)
+
+sensor_stats_t temp_stats;     // Statistics of the temperature in centi-degrees
+
+// === CLOCK GOVERNOR CONFIGURATION ===
+#define VSEL_MV(v) (850 + ((v) - VREG_VOLTAGE_0_85) * 50) // Core voltage of a vreg level, in mV
+
+// Performance levels, slowest first: clock, core voltage, highest temperature (centi-degrees) allowed
+const clock_level_t clock_levels[] = {
+    { 100000, VREG_VOLTAGE_1_10, 0 },    // Hot: always allowed
+    { 125000, VREG_VOLTAGE_1_10, 7000 }, // SDK default clock, up to 70 C
+    { 200000, VREG_VOLTAGE_1_15, 5500 }, // Overclock, up to 55 C
+    { 250000, VREG_VOLTAGE_1_20, 4500 }  // Overclock, up to 45 C
+};
+
+const clock_governor_config_t governor_config = {
+    .levels = clock_levels,
+    .level_count = 4,
+    .smoothing_shift = 2,              // Reading weight 1/4
+    .hysteresis_centi = 300,           // 3 C under the next level's limit before stepping up
+    .emergency_centi = 500,            // A reading 5 C over a limit steps down at once
+    .hold_ms = 10000,                  // At least 10 s between changes before stepping up...
+    .max_hold_ms = 900000              // ...doubling after each thermal step-down, up to 15 min
+};
+
+clock_governor_t governor;             // Governor state (current level, smoothed temperature)
+bool governor_enabled = false;         // False if a level cannot be reached by the PLL
+
 // Buffer and rendering area for the OLED display
 uint8_t oled_buffer[ssd1306_buffer_length];  // Defines a buffer to store image/text data before sending to display
 
@@ -29,6 +71,30 @@ struct render_area oled_area = {
     .end_page = ssd1306_n_pages - 1           // Last page to be drawn (entire screen height)
 };
 
+// === CHART CONFIGURATION ===
+#define TEXT_PAGES 2                          // Two text lines on top, the chart below them
+
+// Text lines: the first pages of oled_buffer, sent on their own
+struct render_area text_area = {
+    .start_column = 0,
+    .end_column = ssd1306_width - 1,
+    .start_page = 0,
+    .end_page = TEXT_PAGES - 1
+};
+
+// One column per reading (128 s of history), range following the readings but at least 1 C tall
+const oled_chart_config_t chart_config = {
+    .column = 0,
+    .page = TEXT_PAGES,
+    .width = ssd1306_width,
+    .pages = ssd1306_n_pages - TEXT_PAGES,
+    .style = OLED_CHART_LINE,
+    .auto_span = 100                          // Centi-degrees
+};
+
+oled_chart_t temp_chart;                      // Chart state and its own pixels
+struct render_area chart_area;                // Screen area of the chart (from chart_config)
+
 // === FUNCTION: Initializes I2C and OLED display ===
 bool setup_display()
 {
@@ -46,6 +112,14 @@ bool setup_display()
     calculate_render_area_buffer_length(&oled_area); // Calculates the number of bytes to be sent to the display
     render_on_display(oled_buffer, &oled_area);      // Renders the buffer on the OLED screen
     sleep_ms(1000);                            // Displays the message for 1 second
+
+    calculate_render_area_buffer_length(&text_area);
+    oled_chart_init(&temp_chart, &chart_config); // Empty chart (a valid region and range)
+    chart_area.start_column = chart_config.column; // The chart is sent straight from temp_chart.pixels
+    chart_area.end_column = chart_config.column + chart_config.width - 1;
+    chart_area.start_page = chart_config.page;
+    chart_area.end_page = chart_config.page + chart_config.pages - 1;
+    calculate_render_area_buffer_length(&chart_area);
     return true;                               // Returns true to indicate successful initialization
 }
 
@@ -69,20 +143,94 @@ float read_temperature()
     return temp;                                // Returns the temperature in Celsius
 }
 
+// === FUNCTION: Initializes the temperature statistics ===
+void setup_temp_stats()
+{
+    const sensor_stats_config_t config = {
+        .hist_min = HIST_MIN_CENTI,            // Lower edge of the histogram
+        .hist_bin_width = HIST_BIN_CENTI,      // Width of each bin
+        .hist_bins = HIST_BINS,                // Number of bins
+        .rate_shift = 3,                       // Trend smoothed over ~8 readings
+        .percentile_q16 = 62259                // 95th percentile (0.95 * 65536)
+    };
+    sensor_stats_init(&temp_stats, &config);   // Checks the configuration and clears the statistics
+}
+
+// === FUNCTION: Initializes the clock governor ===
+bool setup_governor()
+{
+    uint vco, postdiv1, postdiv2;
+    uint8_t start = 0;
+    uint32_t now_khz = clock_get_hz(clk_sys) / 1000; // Clock the SDK started with (125 MHz)
+    for (uint8_t i = 0; i < governor_config.level_count; i++) {
+        if (!check_sys_clock_khz(clock_levels[i].sys_khz, &vco, &postdiv1, &postdiv2)) {
+            printf("governor: %lu kHz cannot be reached, governor off\n", (unsigned long)clock_levels[i].sys_khz);
+            return false;                      // Checked once here, so a change can never fail later
+        }
+        if (clock_levels[i].sys_khz == now_khz) {
+            start = i;                         // The governor starts from the current clock
+        }
+    }
+    clock_control_add_i2c(I2C_PORT, I2C_SPEED); // The OLED keeps its 100 kHz across clock changes
+    return clock_governor_init(&governor, &governor_config, start, to_ms_since_boot(get_absolute_time())) ==
+           CLOCK_GOVERNOR_OK;
+}
+
+// === FUNCTION: Feeds the governor and applies its decision ===
+void run_governor(int32_t centi, uint32_t now_ms)
+{
+    clock_transition_t change;
+    if (!governor_enabled || !clock_governor_update(&governor, (int16_t)centi, now_ms, &change)) {
+        return;                                // No change
+    }
+    const clock_level_t *from = &clock_levels[change.from], *to = &clock_levels[change.to];
+    clock_control_apply(from, to);             // Voltage and clock in a safe order, then the I2C divider
+    printf("governor: %lu ms, level %u -> %u, %lu -> %lu MHz, %d -> %d mV, at %.2f C (change %lu)\n",
+           (unsigned long)now_ms, change.from, change.to, (unsigned long)from->sys_khz / 1000,
+           (unsigned long)to->sys_khz / 1000, VSEL_MV(from->vsel), VSEL_MV(to->vsel), change.temp_centi / 100.0f,
+           (unsigned long)governor.transitions); // Logs every transition
+}
+
+// Converts a Q8 statistic in centi-degrees to degrees, for printing
+float centi_q8_to_celsius(int32_t value_q8)
+{
+    return value_q8 / (256.0f * 100.0f);
+}
+
+// === FUNCTION: Prints the temperature histogram on the serial monitor ===
+void print_temp_histogram()
+{
+    printf("Histogram (%lu readings, %lu below %d C, %lu above %d C):\n", (unsigned long)temp_stats.count,
+           (unsigned long)temp_stats.below, HIST_MIN_CENTI / 100, (unsigned long)temp_stats.above,
+           (HIST_MIN_CENTI + HIST_BINS * HIST_BIN_CENTI) / 100);
+    for (int i = 0; i < HIST_BINS; i++) {
+        if (temp_stats.hist[i]) {              // Prints only the bins in use
+            printf("  %2d C: %lu\n", (HIST_MIN_CENTI + i * HIST_BIN_CENTI) / 100, (unsigned long)temp_stats.hist[i]);
+        }
+    }
+}
+
 // === FUNCTION: Displays temperature on the OLED screen ===
-void oled_display_temperature(float temp)
+// The text lines are redrawn and sent on every reading; the chart only scrolls and draws its new column.
+// Numbers are drawn from integers (centi-degrees) without snprintf; a line holds 16 characters.
+void oled_display_temperature(int32_t centi)
 {
-    memset(oled_buffer, 0, sizeof(oled_buffer));       // Clears the OLED buffer before drawing
+    memset(oled_buffer, 0, TEXT_PAGES * ssd1306_width); // Clears the text lines only
 
-    char linha1[22], linha2[22];                       // Buffers for holding text strings
-    snprintf(linha1, sizeof(linha1), "internal temp:"); // Prepares the label string
-    snprintf(linha2, sizeof(linha2), "%.2f C", temp);  // Formats the temperature value to two decimal places
+    int16_t x = ssd1306_draw_fixed(oled_buffer, 0, 0, centi, 2); // Temperature with two decimal places
+    x = ssd1306_draw_text(oled_buffer, x, 0, " C ");
+    x = ssd1306_draw_uint(oled_buffer, x, 0, clock_get_hz(clk_sys) / 1000000); // System clock
+    ssd1306_draw_text(oled_buffer, x, 0, " MHz");      // "27.31 C 250 MHz"
 
-    ssd1306_draw_string(oled_buffer, 0, 0, linha1);     // Draws the label on the display at Y=0
-    ssd1306_draw_string(oled_buffer, 0, 30, linha2);    // Draws the temperature value below it at Y=30
+    x = ssd1306_draw_fixed(oled_buffer, 0, 8, temp_chart.min, 2); // Chart scale below it
+    x = ssd1306_draw_text(oled_buffer, x, 8, "-");
+    x = ssd1306_draw_fixed(oled_buffer, x, 8, temp_chart.max, 2);
+    ssd1306_draw_text(oled_buffer, x, 8, " C");        // "26.70-27.90 C"
+    render_on_display(oled_buffer, &text_area);        // Sends the two text pages (256 bytes)
 
-    calculate_render_area_buffer_length(&oled_area);   // Calculates the area of the buffer to be sent
-    render_on_display(oled_buffer, &oled_area);        // Sends the buffer content to be rendered on the OLED screen
+    if (oled_chart_update(&temp_chart)) {              // Scrolls and draws the readings added since the last call
+        render_on_display(temp_chart.pixels, &chart_area); // Sends the chart region only
+    }
 }
 
 // === FUNCTION: General setup ===
@@ -90,6 +238,8 @@ void setup()
 {
     stdio_init_all();                          // Initializes USB serial communication (for printf)
     setup_temp_sensor();                       // Calls the function to set up the temperature sensor
+    setup_temp_stats();                        // Clears the running statistics
+    governor_enabled = setup_governor();       // Checks the clock levels and starts the governor
     if (!setup_display()) {                    // Calls the function to set up the OLED display
         printf("Erro on display initialize!\n"); // Prints an error message if setup failed
     }
@@ -104,8 +254,22 @@ int main()
     while (1)                                  // Infinite loop (runs forever)
     {
         float temp = read_temperature();       // Reads the current internal temperature
-        printf("internal temperature: %.2f C\n", temp); // Prints temperature to serial monitor
-        oled_display_temperature(temp);        // Displays temperature on the OLED screen
+        int32_t centi = (int32_t)(temp * 100.0f + (temp >= 0 ? 0.5f : -0.5f)); // Rounds to centi-degrees
+        uint32_t now_ms = to_ms_since_boot(get_absolute_time()); // Time of the reading
+        sensor_stats_add(&temp_stats, centi, now_ms); // Updates the statistics in O(1)
+        printf("trace,%lu,%.2f\n", (unsigned long)now_ms, temp); // CSV line for replaying on the host
+        run_governor(centi, now_ms);           // May change the clock (and log it)
+        oled_chart_add(&temp_chart, (int16_t)centi); // New chart column (drawn by oled_display_temperature)
+
+        printf("internal temperature: %.2f C | avg %.2f sd %.2f | min %.2f max %.2f | p95 %.2f | %+.2f C/min\n", temp,
+               centi_q8_to_celsius(sensor_stats_mean_q8(&temp_stats)),
+               centi_q8_to_celsius(sensor_stats_stddev_q8(&temp_stats)), temp_stats.min / 100.0f,
+               temp_stats.max / 100.0f, centi_q8_to_celsius(sensor_stats_percentile_q8(&temp_stats)),
+               centi_q8_to_celsius(sensor_stats_rate_q8(&temp_stats) * 60)); // Prints temperature and statistics
+        if (temp_stats.count % HIST_PRINT_EVERY == 0) {
+            print_temp_histogram();            // Telemetry: distribution of the readings so far
+        }
+        oled_display_temperature(centi);       // Displays temperature on the OLED screen
         sleep_ms(1000);                        // Waits 1 second before reading again
     }
 }
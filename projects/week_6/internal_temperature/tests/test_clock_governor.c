@@ -0,0 +1,194 @@
+// Embarcatech, April 2025 - Thermal clock governor check (host)
+// Author: Filipe Alves de Sousa
+// Runs the governor's decision logic against temperature traces:
+// - a closed-loop thermal model (chip heats with its clock, enclosure warms
+//   up and cools down over two hours, sensor noise of +-0.5 C)
+// - readings jittering around a level limit (must not oscillate)
+// - a sudden overheat (must step down at once, several levels if needed)
+// and checks the invariants on each. A trace recorded on the board can be
+// replayed too: one "time_ms,temp_c" line per reading, given as the first
+// argument (internal_temperature prints them as "trace,<ms>,<temp>" lines:
+//   grep '^trace,' serial.log | cut -d, -f2- > trace.csv).
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -Iinc tests/test_clock_governor.c inc/clock_governor.c -o test_clock_governor
+//   ./test_clock_governor [trace.csv]   (exit code 0 when all checks pass)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf(), fopen()
+#include "clock_governor.h"
+
+// Same table as internal_temperature.c (vsel 11/12/13 = 1.10/1.15/1.20 V)
+static const clock_level_t levels[] = {
+    { 100000, 11, 0 },       // Always allowed
+    { 125000, 11, 7000 },
+    { 200000, 12, 5500 },
+    { 250000, 13, 4500 },
+};
+static const clock_governor_config_t config = { levels, 4, 2, 300, 500, 10000, 900000 };
+
+static uint32_t rng = 2025;
+
+static int32_t noise_centi(int32_t amplitude) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (int32_t)(rng % (2 * amplitude + 1)) - amplitude;
+}
+
+static int report(const char *name, int ok) {
+    printf("  %-52s %s\n", name, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// Invariants of every decision: returns the number of violations
+typedef struct {
+    uint32_t violations;
+    uint32_t up_too_soon;
+    uint32_t last_change_ms;
+    uint32_t seconds_at_level[4];
+} audit_t;
+
+static void audit_step(audit_t *a, const clock_governor_t *g, bool changed, const clock_transition_t *t,
+                       uint32_t now_ms) {
+    int16_t temp = clock_governor_temperature(g);
+    if (g->level > 0 && temp > levels[g->level].max_centi) {
+        a->violations++;                       // Running a level while too hot for it
+    }
+    if (changed && t->to > t->from) {
+        if (t->to != t->from + 1 || now_ms - a->last_change_ms < config.hold_ms) {
+            a->up_too_soon++;
+        }
+    }
+    if (changed) {
+        a->last_change_ms = now_ms;
+    }
+    a->seconds_at_level[g->level]++;
+}
+
+// Chip = enclosure + 0.1 C per MHz, first-order lag of 60 s; one reading per second
+static int check_closed_loop(void) {
+    clock_governor_t g;
+    audit_t a = { 0 };
+    clock_transition_t t;
+    int failures = 0;
+    double chip = 30.0;
+    clock_governor_init(&g, &config, 0, 0);
+
+    printf("Closed loop, 2 h (enclosure 25 -> 45 -> 25 C):\n");
+    for (uint32_t s = 0; s < 7200; s++) {
+        double enclosure = s < 3600 ? 25.0 + 20.0 * s / 3600 : 45.0 - 20.0 * (s - 3600) / 3600;
+        double target = enclosure + levels[g.level].sys_khz / 10000.0;
+        chip += (target - chip) / 60.0;
+        int16_t reading = (int16_t)(chip * 100 + noise_centi(50));
+        bool changed = clock_governor_update(&g, reading, s * 1000, &t);
+        if (changed) {
+            printf("    %5lu s: level %u -> %u (%lu MHz) at %.2f C\n", (unsigned long)s, t.from, t.to,
+                   (unsigned long)levels[t.to].sys_khz / 1000, t.temp_centi / 100.0);
+        }
+        audit_step(&a, &g, changed, &t, s * 1000);
+    }
+    printf("    time per level (s): 100 MHz %lu, 125 MHz %lu, 200 MHz %lu, 250 MHz %lu\n",
+           (unsigned long)a.seconds_at_level[0], (unsigned long)a.seconds_at_level[1],
+           (unsigned long)a.seconds_at_level[2], (unsigned long)a.seconds_at_level[3]);
+    failures += report("never above the limit of the running level", a.violations == 0);
+    failures += report("steps up one level at a time, after the hold time", a.up_too_soon == 0);
+    failures += report("overclocks while cool (250 MHz at the start)", a.seconds_at_level[3] > 0);
+    failures += report("no oscillation (at most 20 changes in 2 h)", g.transitions <= 20);
+    return failures;
+}
+
+// Steady 55.00 C +-1 C: right at the 200 MHz limit
+static int check_jitter(void) {
+    clock_governor_t g;
+    clock_transition_t t;
+    clock_governor_init(&g, &config, 2, 0);
+    for (uint32_t s = 0; s < 3600; s++) {
+        clock_governor_update(&g, (int16_t)(5500 + noise_centi(100)), s * 1000, &t);
+    }
+    printf("Readings jittering around a limit (55 C +-1 C, 1 h): %lu changes\n", (unsigned long)g.transitions);
+    return report("at most 2 changes", g.transitions <= 2);
+}
+
+// 40 C, then a jump to 80 C
+static int check_overheat(void) {
+    clock_governor_t g;
+    clock_transition_t t;
+    int failures = 0;
+    clock_governor_init(&g, &config, 3, 0);
+    for (uint32_t s = 0; s < 60; s++) {
+        clock_governor_update(&g, 4000, s * 1000, &t);
+    }
+    uint32_t seconds = 0;
+    bool multi_step = false;
+    for (uint32_t s = 60; s < 80 && g.level > 0; s++, seconds++) {
+        if (clock_governor_update(&g, 8000, s * 1000, &t) && t.from - t.to > 1) {
+            multi_step = true;
+        }
+    }
+    printf("Overheat from 40 to 80 C at 250 MHz: level 0 after %lu readings\n", (unsigned long)seconds + 1);
+    failures += report("back to the slowest level within 3 readings", g.level == 0 && seconds < 3);
+    failures += report("skips levels on the way down", multi_step);
+    return failures;
+}
+
+static int check_config(void) {
+    clock_governor_t g;
+    clock_level_t bad_order[] = { { 125000, 11, 0 }, { 100000, 11, 7000 } };
+    clock_level_t bad_limits[] = { { 100000, 11, 0 }, { 125000, 11, 5000 }, { 200000, 12, 6000 } };
+    clock_governor_config_t c = config;
+    int failures = 0;
+    printf("Configuration:\n");
+    c.levels = bad_order;
+    c.level_count = 2;
+    failures += report("clocks not increasing rejected", clock_governor_init(&g, &c, 0, 0) == CLOCK_GOVERNOR_BAD_LEVELS);
+    c.levels = bad_limits;
+    c.level_count = 3;
+    failures += report("limits not decreasing rejected", clock_governor_init(&g, &c, 0, 0) == CLOCK_GOVERNOR_BAD_LEVELS);
+    failures += report("start level out of range rejected",
+                       clock_governor_init(&g, &config, 4, 0) == CLOCK_GOVERNOR_BAD_START);
+    c = config;
+    c.max_hold_ms = c.hold_ms - 1;
+    failures += report("max hold below hold rejected", clock_governor_init(&g, &c, 0, 0) == CLOCK_GOVERNOR_BAD_HOLD);
+    return failures;
+}
+
+// Open-loop replay of a recorded trace: the recorded temperatures do not react to the decisions
+static int replay(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    clock_governor_t g;
+    audit_t a = { 0 };
+    clock_transition_t t;
+    unsigned long ms;
+    double temp;
+    uint32_t readings = 0;
+    clock_governor_init(&g, &config, 0, 0);
+    printf("Replay of %s:\n", path);
+    while (fscanf(f, " %lu , %lf", &ms, &temp) == 2) {
+        bool changed = clock_governor_update(&g, (int16_t)(temp * 100 + (temp >= 0 ? 0.5 : -0.5)), (uint32_t)ms, &t);
+        if (changed) {
+            printf("    %8lu ms: level %u -> %u at %.2f C\n", ms, t.from, t.to, t.temp_centi / 100.0);
+        }
+        audit_step(&a, &g, changed, &t, (uint32_t)ms);
+        readings++;
+    }
+    fclose(f);
+    printf("    %lu readings, %lu changes\n", (unsigned long)readings, (unsigned long)g.transitions);
+    return report("invariants hold on the recorded trace", a.violations == 0 && a.up_too_soon == 0);
+}
+
+int main(int argc, char **argv) {
+    int failures = check_closed_loop();
+    failures += check_jitter();
+    failures += check_overheat();
+    failures += check_config();
+    if (argc > 1) {
+        failures += replay(argv[1]);
+    }
+    printf("\n%s\n", failures ? "FAILED" : "All checks passed");
+    return failures ? 1 : 0;
+}
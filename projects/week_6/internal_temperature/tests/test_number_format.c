@@ -0,0 +1,189 @@
+// Embarcatech, April 2025 - Divide-free number formatting check and benchmark (host)
+// Author: Filipe Alves de Sousa
+// Compares number_format with snprintf: every value from -1 000 000 to
+// 1 000 000, powers of ten and their neighbours, the 32-bit limits and random
+// values, for "%u", "%d" and fixed point with 0 to 9 decimals (including the
+// "%.2f" of the temperature readings). Then times the OLED lines of the apps
+// formatted both ways.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -Iinc tests/test_number_format.c inc/number_format.c -o test_number_format
+//   ./test_number_format   (exit code 0 when all checks pass)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf(), snprintf()
+#include <string.h>    // strcmp()
+#include <time.h>      // clock_gettime()
+#include "number_format.h"
+
+#define RANDOM_VALUES 2000000
+#define ROUNDS 2000000
+
+static uint32_t rng = 2025;
+
+static uint32_t next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// Monotonic time in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Random value with a random number of significant bits, so short and long numbers are equally covered
+static uint32_t random_value(void) {
+    uint32_t bits = next_random() % 33;
+    return bits == 32 ? next_random() : next_random() & ((1u << bits) - 1);
+}
+
+static int check_value(int32_t value, uint8_t decimals_mask) {
+    char got[NUMBER_FORMAT_MAX_CHARS], want[32];
+    number_format_uint(got, (uint32_t)value);
+    snprintf(want, sizeof(want), "%u", (unsigned)value);
+    if (strcmp(got, want) != 0) {
+        printf("  FAIL: uint %u gave \"%s\"\n", (unsigned)value, got);
+        return 1;
+    }
+    number_format_int(got, value);
+    snprintf(want, sizeof(want), "%d", (int)value);
+    if (strcmp(got, want) != 0) {
+        printf("  FAIL: int %d gave \"%s\"\n", (int)value, got);
+        return 1;
+    }
+    int64_t magnitude = value < 0 ? -(int64_t)value : value;
+    int64_t scale = 1;
+    for (uint8_t decimals = 0; decimals <= NUMBER_FORMAT_MAX_DECIMALS; decimals++, scale *= 10) {
+        if (!(decimals_mask & (1u << decimals % 8))) {
+            continue;
+        }
+        number_format_fixed(got, value, decimals);
+        if (decimals) {
+            snprintf(want, sizeof(want), "%s%lld.%0*lld", value < 0 ? "-" : "", (long long)(magnitude / scale),
+                     decimals, (long long)(magnitude % scale));
+        } else {
+            snprintf(want, sizeof(want), "%d", (int)value);
+        }
+        if (strcmp(got, want) != 0) {
+            printf("  FAIL: fixed %d with %u decimals gave \"%s\", expected \"%s\"\n", (int)value, decimals, got, want);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int check_formatting(void) {
+    int failures = 0;
+    for (int32_t v = -1000000; v <= 1000000 && !failures; v++) {
+        failures += check_value(v, 0x07);            // 0, 1, 2 (and 8, 9) decimals for every value
+    }
+    printf("  %-48s %s\n", "-1 000 000 .. 1 000 000", failures ? "FAIL" : "ok");
+
+    int edge_failures = 0;
+    for (int64_t p = 1; p <= 1000000000; p *= 10) {
+        for (int64_t d = -1; d <= 1; d++) {
+            edge_failures += check_value((int32_t)(p + d), 0xFF);
+            edge_failures += check_value((int32_t)-(p + d), 0xFF);
+        }
+    }
+    const int32_t limits[] = { INT32_MIN, INT32_MIN + 1, INT32_MAX, -1, 0, 2000000000, -2000000000 };
+    for (unsigned i = 0; i < sizeof(limits) / sizeof(limits[0]); i++) {
+        edge_failures += check_value(limits[i], 0xFF);
+    }
+    char got[NUMBER_FORMAT_MAX_CHARS];
+    number_format_uint(got, UINT32_MAX);
+    edge_failures += strcmp(got, "4294967295") != 0;
+    number_format_uint(got, 4000000000u);
+    edge_failures += strcmp(got, "4000000000") != 0;
+    printf("  %-48s %s\n", "powers of ten +-1, 32-bit limits", edge_failures ? "FAIL" : "ok");
+    failures += edge_failures;
+
+    int random_failures = 0;
+    for (int i = 0; i < RANDOM_VALUES && !random_failures; i++) {
+        random_failures += check_value((int32_t)random_value(), 0xFF);
+    }
+    printf("  %-48s %s\n", "random values, 0 to 9 decimals", random_failures ? "FAIL" : "ok");
+    failures += random_failures;
+
+    // The temperature path: centi-degrees with 2 decimals against "%.2f" of the value in degrees
+    int celsius_failures = 0;
+    for (int32_t centi = -5000; centi <= 15000 && !celsius_failures; centi++) {
+        char want[32];
+        number_format_fixed(got, centi, 2);
+        snprintf(want, sizeof(want), "%.2f", centi / 100.0);
+        if (strcmp(got, want) != 0) {
+            printf("  FAIL: %d centi-degrees gave \"%s\", printf \"%s\"\n", (int)centi, got, want);
+            celsius_failures++;
+        }
+    }
+    printf("  %-48s %s\n", "centi-degrees -50 .. 150 C as \"%.2f\"", celsius_failures ? "FAIL" : "ok");
+    return failures + celsius_failures;
+}
+
+// Appends a string, returns the new end
+static char *append(char *out, const char *text) {
+    while (*text) {
+        *out++ = *text++;
+    }
+    *out = '\0';
+    return out;
+}
+
+int main(void) {
+    printf("Against snprintf:\n");
+    int failures = check_formatting();
+
+    // Readings as the apps see them
+    static int32_t centi[1024];
+    static float celsius[1024];
+    static int16_t axis[1024];
+    for (int i = 0; i < 1024; i++) {
+        centi[i] = 2000 + (int32_t)(next_random() % 1600);
+        celsius[i] = centi[i] / 100.0f;
+        axis[i] = (int16_t)((int32_t)(next_random() % 2001) - 1000);
+    }
+
+    char line[32];
+    volatile char sink = 0;                          // Keeps the formatting from being optimized away
+    double t[5];
+    t[0] = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        snprintf(line, sizeof(line), "%.2f C", celsius[r & 1023]);
+        sink ^= line[1];
+    }
+    t[1] = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        char *end = line + number_format_fixed(line, centi[r & 1023], 2);
+        append(end, " C");
+        sink ^= line[1];
+    }
+    t[2] = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        snprintf(line, sizeof(line), "X: %d Y: %d", axis[r & 1023], axis[(r + 7) & 1023]);
+        sink ^= line[4];
+    }
+    t[3] = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        char *end = append(line, "X: ");
+        end += number_format_int(end, axis[r & 1023]);
+        end = append(end, " Y: ");
+        number_format_int(end, axis[(r + 7) & 1023]);
+        sink ^= line[4];
+    }
+    t[4] = now_ns();
+    (void)sink;
+
+    printf("\n===== LINE FORMATTING (host, ns per line) =====\n");
+    printf("%-24s %-14s %-14s %-8s\n", "Line", "snprintf", "number_format", "Speedup");
+    printf("%-24s %-14.1f %-14.1f %-8.1f\n", "\"%.2f C\"", (t[1] - t[0]) / ROUNDS, (t[2] - t[1]) / ROUNDS,
+           (t[1] - t[0]) / (t[2] - t[1]));
+    printf("%-24s %-14.1f %-14.1f %-8.1f\n", "\"X: %d Y: %d\"", (t[3] - t[2]) / ROUNDS, (t[4] - t[3]) / ROUNDS,
+           (t[3] - t[2]) / (t[4] - t[3]));
+
+    printf("\n%s\n", failures ? "Some checks FAILED" : "All checks passed");
+    return failures ? 1 : 0;
+}
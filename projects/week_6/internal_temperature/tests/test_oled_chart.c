@@ -0,0 +1,262 @@
+// Embarcatech, April 2025 - Scrolling chart widget check and benchmark (host)
+// Author: Filipe Alves de Sousa
+// Feeds random walks to oled_chart, updating after a random number of new
+// samples each time, and compares the scrolled pixels with a reference drawn
+// pixel by pixel from the full sample history (line and filled styles, full
+// and partial regions, fixed and automatic ranges), and checks that a held
+// value stops asking for flushes once the line is flat (and is still drawn when
+// more samples than the pending count arrive at once). Then times one update
+// against a full redraw and estimates the I2C flush time of the region.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -Iinc tests/test_oled_chart.c inc/oled_chart.c -o test_oled_chart
+//   ./test_oled_chart   (exit code 0 when all checks pass)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <string.h>    // memset(), memcmp()
+#include <time.h>      // clock_gettime()
+#include "oled_chart.h"
+
+#define SAMPLES 20000
+#define ROUNDS 200000
+
+static int16_t history[SAMPLES];
+static uint8_t expected[OLED_CHART_MAX_WIDTH * OLED_CHART_MAX_PAGES];
+static uint32_t rng = 2025;
+
+static uint32_t next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// Monotonic time in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Row of a value, as specified: min on the bottom row, max on the top row, rounded, clamped
+static int reference_row(const oled_chart_t *chart, int value) {
+    int bottom = chart->config.pages * 8 - 1;
+    if (value <= chart->min) {
+        return bottom;
+    }
+    if (value >= chart->max) {
+        return 0;
+    }
+    int span = chart->max - chart->min;
+    return bottom - ((value - chart->min) * bottom + span / 2) / span;
+}
+
+// Draws the last `shown` samples of the history one pixel at a time
+static void reference_draw(const oled_chart_t *chart, int added) {
+    int width = chart->config.width, rows = chart->config.pages * 8;
+    int shown = added < width ? added : width;
+    memset(expected, 0, sizeof(expected));
+    for (int k = 0; k < shown; k++) {
+        int n = added - shown + k;                   // History index drawn in column width - shown + k
+        int x = width - shown + k;
+        int row = reference_row(chart, history[n]);
+        int top = row, bottom = row;
+        if (chart->config.style == OLED_CHART_FILL) {
+            bottom = rows - 1;
+        } else if (n > 0) {
+            int prev = reference_row(chart, history[n - 1]);
+            top = prev < row ? prev : row;
+            bottom = prev > row ? prev : row;
+        }
+        for (int y = top; y <= bottom; y++) {
+            expected[(y / 8) * width + x] |= (uint8_t)(1u << (y % 8));
+        }
+    }
+}
+
+// Runs one configuration: random walk, random update intervals, compare after every update
+static int check_scrolling(const char *name, const oled_chart_config_t *config, int step) {
+    static oled_chart_t chart;
+    if (oled_chart_init(&chart, config) != OLED_CHART_OK) {
+        printf("  FAIL: %s: init\n", name);
+        return 1;
+    }
+    int32_t value = (config->min + config->max) / 2;
+    int added = 0, updates = 0, redraws = 0;
+    while (added < SAMPLES) {
+        // Mostly 1-3 samples per update, sometimes more than a screen
+        int batch = next_random() % 16 == 0 ? (int)(next_random() % (2 * config->width)) + 1 : (int)(next_random() % 3) + 1;
+        for (int i = 0; i < batch && added < SAMPLES; i++) {
+            value += (int32_t)(next_random() % (2 * step + 1)) - step;
+            if (next_random() % 500 == 0) {
+                value += (next_random() % 2 ? 8 : -8) * step;   // Occasional jump out of the range
+            }
+            history[added++] = (int16_t)value;
+            oled_chart_add(&chart, (int16_t)value);
+        }
+        bool full = chart.redraw || chart.pending >= config->width;
+        oled_chart_update(&chart);
+        updates++;
+        redraws += full;
+        reference_draw(&chart, added);
+        if (memcmp(chart.pixels, expected, oled_chart_bytes(&chart)) != 0) {
+            printf("  FAIL: %s: pixels differ from the reference after %d samples\n", name, added);
+            return 1;
+        }
+        if (config->auto_span) {
+            int shown = added < config->width ? added : config->width;
+            for (int k = added - shown; k < added; k++) {
+                if (history[k] < chart.min || history[k] > chart.max) {
+                    printf("  FAIL: %s: sample %d outside the automatic range %d..%d\n", name, history[k], chart.min,
+                           chart.max);
+                    return 1;
+                }
+            }
+        }
+    }
+    printf("  %-44s ok (%d updates, %d full redraws)\n", name, updates, redraws);
+    return 0;
+}
+
+static int check_config(void) {
+    static oled_chart_t chart;
+    int failures = 0;
+    const oled_chart_config_t off_screen = { 64, 0, 96, 4, OLED_CHART_LINE, 0, 100, 0 };
+    const oled_chart_config_t too_tall = { 0, 4, 128, 5, OLED_CHART_LINE, 0, 100, 0 };
+    const oled_chart_config_t empty = { 0, 0, 0, 4, OLED_CHART_LINE, 0, 100, 0 };
+    const oled_chart_config_t flat = { 0, 0, 128, 4, OLED_CHART_LINE, 50, 50, 0 };
+    const oled_chart_config_t automatic = { 0, 0, 128, 4, OLED_CHART_LINE, 0, 0, 100 };
+    failures += oled_chart_init(&chart, &off_screen) != OLED_CHART_BAD_REGION;
+    failures += oled_chart_init(&chart, &too_tall) != OLED_CHART_BAD_REGION;
+    failures += oled_chart_init(&chart, &empty) != OLED_CHART_BAD_REGION;
+    failures += oled_chart_init(&chart, &flat) != OLED_CHART_BAD_RANGE;
+    failures += oled_chart_init(&chart, &automatic) != OLED_CHART_OK;
+    failures += oled_chart_update(&chart);           // Nothing added: nothing to flush
+    printf("  %-44s %s\n", "bad regions and ranges rejected", failures ? "FAIL" : "ok");
+    return failures;
+}
+
+// A value held long enough to be flat across the region: updates stop reporting changes, pixels stay right
+static int check_flat(const oled_chart_config_t *config) {
+    static oled_chart_t chart;
+    oled_chart_init(&chart, config);
+    int added = 0, changed = 0, failures = 0;
+    for (; added < 200; added++) {
+        history[added] = (int16_t)(config->min + next_random() % (config->max - config->min));
+        oled_chart_add(&chart, history[added]);
+        oled_chart_update(&chart);
+    }
+    int16_t held = history[added - 1];
+    for (int i = 0; i < 3 * config->width; i++, added++) {
+        history[added] = held;
+        oled_chart_add(&chart, held);
+        changed += oled_chart_update(&chart);
+        reference_draw(&chart, added + 1);
+        failures += memcmp(chart.pixels, expected, oled_chart_bytes(&chart)) != 0;
+    }
+    // The column of the first held sample is still joined to the older value until it scrolls out
+    failures += changed != config->width;
+    for (int batch = 1; batch <= config->width; batch += 31) {  // A slow pass: several held samples at once
+        for (int i = 0; i < batch; i++) {
+            history[added++] = held;
+            oled_chart_add(&chart, held);
+        }
+        failures += oled_chart_update(&chart);
+    }
+    history[added++] = (int16_t)(held + 1);                      // Any change is drawn again
+    oled_chart_add(&chart, (int16_t)(held + 1));
+    failures += !oled_chart_update(&chart);
+    reference_draw(&chart, added);
+    failures += memcmp(chart.pixels, expected, oled_chart_bytes(&chart)) != 0;
+    printf("  %-44s %s (%d of %d held samples drawn)\n", "held value: no update once flat", failures ? "FAIL" : "ok",
+           changed, 3 * config->width);
+    return failures;
+}
+
+// More identical samples than the pending count holds, all in one update: they must still be drawn
+static int check_long_batch(void) {
+    static oled_chart_t chart;
+    const oled_chart_config_t small = { 0, 0, 16, 1, OLED_CHART_LINE, 0, 100, 0 };
+    oled_chart_init(&chart, &small);
+    for (int i = 0; i < 40; i++) {
+        history[i] = 60;
+        oled_chart_add(&chart, 60);
+    }
+    int failures = !oled_chart_update(&chart);
+    reference_draw(&chart, 40);
+    failures += memcmp(chart.pixels, expected, oled_chart_bytes(&chart)) != 0;
+    printf("  %-44s %s\n", "40 held samples, then one update (16 wide)", failures ? "FAIL" : "ok");
+    return failures;
+}
+
+// Prints the region as text (one character per pixel)
+static void print_chart(const oled_chart_t *chart) {
+    for (int y = 0; y < chart->config.pages * 8; y++) {
+        printf("  |");
+        for (int x = 0; x < chart->config.width; x++) {
+            putchar((chart->pixels[(y / 8) * chart->config.width + x] >> (y % 8)) & 1 ? '#' : ' ');
+        }
+        printf("|\n");
+    }
+}
+
+int main(void) {
+    int failures = 0;
+    printf("Scrolled pixels against a per-pixel reference (%d samples each):\n", SAMPLES);
+    const oled_chart_config_t temperature = { 0, 2, 128, 6, OLED_CHART_LINE, 2000, 3600, 0 };
+    const oled_chart_config_t partial = { 16, 1, 96, 3, OLED_CHART_LINE, -1000, 1000, 0 };
+    const oled_chart_config_t filled = { 0, 4, 128, 4, OLED_CHART_FILL, -1000, 1000, 0 };
+    const oled_chart_config_t automatic = { 0, 2, 128, 6, OLED_CHART_LINE, 0, 0, 200 };
+    const oled_chart_config_t narrow = { 120, 7, 8, 1, OLED_CHART_LINE, 0, 7, 0 };
+    failures += check_scrolling("line, 128 x 48, fixed range", &temperature, 40);
+    failures += check_scrolling("line, 96 x 24 at column 16, fixed range", &partial, 60);
+    failures += check_scrolling("filled, 128 x 32, fixed range", &filled, 60);
+    failures += check_scrolling("line, 128 x 48, automatic range", &automatic, 15);
+    failures += check_scrolling("line, 8 x 8, one pixel per unit", &narrow, 1);
+    failures += check_config();
+    failures += check_flat(&temperature);
+    failures += check_long_batch();
+
+    static oled_chart_t chart;
+    const oled_chart_config_t preview = { 0, 0, 64, 2, OLED_CHART_LINE, -100, 100, 0 };
+    oled_chart_init(&chart, &preview);
+    const int16_t wave[16] = { 0, 38, 71, 92, 100, 92, 71, 38, 0, -38, -71, -92, -100, -92, -71, -38 };
+    for (int i = 0; i < 80; i++) {
+        oled_chart_add(&chart, wave[i % 16]);
+        oled_chart_update(&chart);
+    }
+    printf("\nPreview (64 x 16, one sample per column):\n");
+    print_chart(&chart);
+
+    // One new sample per update, as at the sample rate, against redrawing the whole region
+    oled_chart_init(&chart, &temperature);
+    for (int i = 0; i < temperature.width; i++) {
+        oled_chart_add(&chart, history[i]);
+    }
+    oled_chart_update(&chart);
+    double t0 = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        oled_chart_add(&chart, history[r % SAMPLES]);
+        oled_chart_update(&chart);
+    }
+    double t1 = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        oled_chart_add(&chart, history[r % SAMPLES]);
+        oled_chart_redraw(&chart);
+    }
+    double t2 = now_ns();
+
+    // I2C: 9 bit times per byte (8 data + ACK) plus a few bytes of addressing per flush
+    double bytes = oled_chart_bytes(&chart), frame = OLED_CHART_MAX_WIDTH * OLED_CHART_MAX_PAGES;
+    printf("\n===== CHART UPDATE (128 x 48 region, one new sample) =====\n");
+    printf("%-30s %-12s\n", "Operation", "ns/update");
+    printf("%-30s %-12.1f\n", "Scroll + new column", (t1 - t0) / ROUNDS);
+    printf("%-30s %-12.1f\n", "Full redraw", (t2 - t1) / ROUNDS);
+    printf("\n%-30s %-8s %-14s %-14s\n", "Flush", "bytes", "ms @ 100 kHz", "ms @ 400 kHz");
+    printf("%-30s %-8.0f %-14.1f %-14.1f\n", "Chart region", bytes, (bytes + 8) * 9 / 100.0, (bytes + 8) * 9 / 400.0);
+    printf("%-30s %-8.0f %-14.1f %-14.1f\n", "Whole display", frame, (frame + 8) * 9 / 100.0, (frame + 8) * 9 / 400.0);
+
+    printf("\n%s\n", failures ? "Some checks FAILED" : "All checks passed");
+    return failures ? 1 : 0;
+}
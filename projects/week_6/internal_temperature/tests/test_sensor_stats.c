@@ -0,0 +1,173 @@
+// Embarcatech, April 2025 - Online sensor statistics check (host)
+// Author: Filipe Alves de Sousa
+// Feeds synthetic readings to sensor_stats and compares every statistic with a
+// reference computed in double precision from the whole stored history
+// (two-pass mean and variance, sorted-array percentile, naive histogram),
+// then times one update.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -Iinc tests/test_sensor_stats.c inc/sensor_stats.c -lm -o test_sensor_stats
+//   ./test_sensor_stats   (exit code 0 when all checks pass)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <stdlib.h>    // qsort()
+#include <math.h>      // sqrt(), fabs()
+#include <time.h>      // clock_gettime()
+#include "sensor_stats.h"
+
+#define SAMPLES 100000
+
+static int32_t history[SAMPLES];
+static uint32_t rng = 2025;
+
+static uint32_t next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static int compare(const void *a, const void *b) {
+    int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int report(const char *name, int ok) {
+    printf("  %-44s %s\n", name, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// Readings around 27.00 C in centi-degrees: 0 uniform, 1 bell-shaped, 2 skewed with rare spikes
+static int32_t make_reading(int shape) {
+    switch (shape) {
+        case 0: return 2500 + (int32_t)(next_random() % 401);
+        case 1: {
+            int32_t sum = 0;
+            for (int k = 0; k < 4; k++) {
+                sum += (int32_t)(next_random() % 101);
+            }
+            return 2500 + sum;
+        }
+        default: {
+            int32_t x = 2650 + (int32_t)(next_random() % 21);
+            uint32_t r = next_random() % 100;
+            return r < 10 ? x + (int32_t)(next_random() % 300) : r < 11 ? x + 2000 : x;
+        }
+    }
+}
+
+static int check_shape(int shape, const char *name) {
+    const sensor_stats_config_t config = { 2400, 50, 12, 3, 62259 };  // 24.00-30.00 C in 0.5 C bins, p95
+    static sensor_stats_t stats;
+    uint32_t hist[SENSOR_STATS_MAX_BINS] = { 0 };
+    uint32_t below = 0, above = 0;
+    int failures = 0;
+
+    sensor_stats_init(&stats, &config);
+    double sum = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        int32_t x = make_reading(shape);
+        history[i] = x;
+        sum += x;
+        sensor_stats_add(&stats, x, (uint32_t)i * 100);
+        if (x < config.hist_min) {
+            below++;
+        } else if ((x - config.hist_min) / config.hist_bin_width >= config.hist_bins) {
+            above++;
+        } else {
+            hist[(x - config.hist_min) / config.hist_bin_width]++;
+        }
+    }
+    double mean = sum / SAMPLES, m2 = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        m2 += (history[i] - mean) * (history[i] - mean);
+    }
+    double stddev = sqrt(m2 / (SAMPLES - 1));
+    qsort(history, SAMPLES, sizeof(history[0]), compare);
+    double p95 = history[(int)(0.95 * (SAMPLES - 1) + 0.5)];
+    double spread = history[SAMPLES - 1] - history[0];
+
+    double got_mean = sensor_stats_mean_q8(&stats) / 256.0;
+    double got_stddev = sensor_stats_stddev_q8(&stats) / 256.0;
+    double got_p95 = sensor_stats_percentile_q8(&stats) / 256.0;
+    int hist_ok = below == stats.below && above == stats.above;
+    for (int b = 0; b < SENSOR_STATS_MAX_BINS; b++) {
+        hist_ok &= hist[b] == stats.hist[b];
+    }
+
+    printf("%s: mean %.3f / %.3f, stddev %.3f / %.3f, p95 %.2f / %.0f (fixed point / reference)\n", name, got_mean,
+           mean, got_stddev, stddev, got_p95, p95);
+    failures += report("min and max", stats.min == history[0] && stats.max == history[SAMPLES - 1]);
+    failures += report("mean within 0.05", fabs(got_mean - mean) < 0.05);
+    failures += report("standard deviation within 0.5%", fabs(got_stddev - stddev) < 0.005 * stddev);
+    failures += report("histogram identical", hist_ok);
+    failures += report("P2 95th percentile within 1% of the range", fabs(got_p95 - p95) < 0.01 * spread);
+    return failures;
+}
+
+int main(void) {
+    int failures = 0;
+    failures += check_shape(0, "Uniform");
+    failures += check_shape(1, "Bell-shaped");
+    failures += check_shape(2, "Skewed with spikes");
+
+    // Ramp of +3 units every 100 ms = 30 units/s, then flat
+    printf("Rate of change and edge cases:\n");
+    static sensor_stats_t stats;
+    const sensor_stats_config_t config = { 0, 10, 4, 2, 32768 };
+    sensor_stats_init(&stats, &config);
+    for (int i = 0; i < 50; i++) {
+        sensor_stats_add(&stats, 1000 + 3 * i, (uint32_t)i * 100);
+    }
+    failures += report("ramp rate 30/s", sensor_stats_rate_q8(&stats) == 30 * 256);
+    for (int i = 50; i < 150; i++) {
+        sensor_stats_add(&stats, 1147, (uint32_t)i * 100);
+    }
+    failures += report("rate decays to 0 when flat", SENSOR_STATS_Q8_ROUND(sensor_stats_rate_q8(&stats)) == 0);
+
+    sensor_stats_reset(&stats);
+    sensor_stats_add(&stats, 30, 0);
+    sensor_stats_add(&stats, 10, 1);
+    sensor_stats_add(&stats, 20, 2);
+    failures += report("median of 3 readings exact", sensor_stats_percentile_q8(&stats) == 20 * 256);
+    failures += report("stddev of 10, 20, 30 = 10", sensor_stats_stddev_q8(&stats) == 10 * 256);
+    failures += report("negative readings", (sensor_stats_reset(&stats), sensor_stats_add(&stats, -500, 0),
+                                             sensor_stats_add(&stats, -700, 1000),
+                                             sensor_stats_mean_q8(&stats) == -600 * 256 && stats.below == 2 &&
+                                                 sensor_stats_rate_q8(&stats) == -200 * 256));
+    sensor_stats_config_t bad = config;
+    bad.hist_bins = 0;
+    int e1 = sensor_stats_init(&stats, &bad);
+    bad = config;
+    bad.percentile_q16 = 0;
+    int e2 = sensor_stats_init(&stats, &bad);
+    bad = config;
+    bad.rate_shift = 13;
+    int e3 = sensor_stats_init(&stats, &bad);
+    failures += report("configuration errors", e1 == SENSOR_STATS_BAD_BINS && e2 == SENSOR_STATS_BAD_PERCENTILE &&
+                                                   e3 == SENSOR_STATS_BAD_SHIFT);
+
+    sensor_stats_init(&stats, &config);
+    for (int i = 0; i < SAMPLES; i++) {
+        history[i] = make_reading(1);
+    }
+    double t0 = now_ns();
+    for (int r = 0; r < 10; r++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            sensor_stats_add(&stats, history[i], (uint32_t)i);
+        }
+    }
+    double t1 = now_ns();
+    printf("\nUpdate cost on this host: %.1f ns per reading (%u bytes of state)\n", (t1 - t0) / (10.0 * SAMPLES),
+           (unsigned)sizeof(sensor_stats_t));
+
+    printf("%s\n", failures ? "FAILED" : "All checks passed");
+    return failures ? 1 : 0;
+}
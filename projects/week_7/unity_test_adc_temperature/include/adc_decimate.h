@@ -0,0 +1,79 @@
+// Embarcatech, April 2025 - ADC Oversampling and Decimation Header
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    This header defines an integer CIC (cascaded integrator-comb)
+    decimator that turns a stream of raw 12-bit ADC samples into fewer,
+    higher-resolution results: averaging 4^k samples with noise on the
+    input gains k bits (256x oversampling: 12 -> 16 bits).
+
+    Key Features:
+    - Order 1 (boxcar average) to 3 (CIC), ratios 2..256 (powers of two)
+    - Integer only: adds and one shift per output, no multiply or divide
+    - Streaming: blocks of any length (e.g. DMA buffers), state kept
+      between calls
+    - Results of 12 to 16 bits, rounded to nearest
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>  // Standard integer types
+#include <stddef.h>  // size_t
+
+#define ADC_DECIMATE_INPUT_BITS 12    // RP2040 ADC resolution
+#define ADC_DECIMATE_MAX_ORDER 3
+#define ADC_DECIMATE_MAX_LOG2_RATIO 8 // Ratio up to 256
+
+// Return codes
+#define ADC_DECIMATE_OK 0
+#define ADC_DECIMATE_BAD_ORDER -1     // Order outside 1..3
+#define ADC_DECIMATE_BAD_RATIO -2     // Ratio outside 2..256
+#define ADC_DECIMATE_BAD_BITS -3      // Output outside 12..16 bits or above the filter gain
+#define ADC_DECIMATE_TOO_WIDE -4      // 12 + order x log2(ratio) does not fit 32 bits
+
+/**
+ * @brief Decimator state
+ */
+typedef struct {
+    uint8_t order;                                // N: integrator and comb stages
+    uint8_t log2_ratio;                           // R = 2^log2_ratio input samples per output
+    uint8_t out_bits;                             // Resolution of the results
+    uint8_t shift;                                // N x log2(R) - (out_bits - 12)
+    uint16_t phase;                               // Input samples since the last output
+    uint32_t integrator[ADC_DECIMATE_MAX_ORDER];  // Running sums (wrap around on purpose)
+    uint32_t comb[ADC_DECIMATE_MAX_ORDER];        // Previous input of each comb stage
+} adc_decimator_t;
+
+/**
+ * @brief Configures a decimator and clears its state
+ *
+ * @param order 1 (boxcar average) to 3; higher orders reject more noise
+ *        above the output rate, and their first order - 1 results are
+ *        still settling
+ * @param log2_ratio Decimation ratio as a power of two (1..8)
+ * @param out_bits Result resolution (12..16); 12 + log2_ratio / 2 is the
+ *        resolution actually gained from white noise
+ * @return ADC_DECIMATE_OK or a negative error code
+ *
+ * @example 256x oversampling of the temperature sensor into 16 bits:
+ * @code
+ * adc_decimator_t dec;
+ * adc_decimator_init(&dec, 1, 8, 16);
+ * size_t n = adc_decimate_block(&dec, dma_buffer, 4096, results); // 16 results
+ * @endcode
+ */
+int adc_decimator_init(adc_decimator_t *dec, unsigned order, unsigned log2_ratio, unsigned out_bits);
+
+/**
+ * @brief Clears the filter state, keeping the configuration
+ */
+void adc_decimator_reset(adc_decimator_t *dec);
+
+/**
+ * @brief Filters a block of raw samples
+ *
+ * @param in Raw 12-bit samples (upper bits ignored)
+ * @param out Room for n / ratio + 1 results
+ * @return Number of results written to out
+ */
+size_t adc_decimate_block(adc_decimator_t *dec, const uint16_t *in, size_t n, uint16_t *out);
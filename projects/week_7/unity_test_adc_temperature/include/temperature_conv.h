@@ -9,11 +9,19 @@
     - Conversion formula based on RP2040 datasheet specifications
     - Pre-calculated constants for optimal performance
     - 12-bit ADC resolution support
+    - Integer fast path in centi-degrees (no soft-float on the M0+)
+    - Batch conversion of DMA buffers, optionally through a 4096-entry
+      LUT baked into flash at compile time (TEMPERATURE_CONV_USE_LUT)
     ======================================================================== */
 
     #pragma once  // Ensures single inclusion of this header file
 
     #include <stdint.h>  // Standard integer types (uint16_t)
+    #include <stddef.h>  // size_t
+
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
     
     // Sensor and ADC Configuration Constants
     #define VREF 3.3f             // Reference voltage (3.3V for Pico)
@@ -41,4 +49,52 @@
      * float temp = adc_to_celsius(reading);
      * @endcode
      */
-    float adc_to_celsius(uint16_t adc_val);
\ No newline at end of file
+    float adc_to_celsius(uint16_t adc_val);
+
+    // Integer conversion: centi-degrees = (adc_val x SLOPE + OFFSET) >> 12, both in Q12,
+    // derived from the constants above so both paths give the same temperature
+    #define TEMP_Q12_ROUND(x) ((int32_t)((x) < 0 ? (x) - 0.5f : (x) + 0.5f))
+    #define TEMP_CENTI_SLOPE_Q12 TEMP_Q12_ROUND(-(VREF * 100.0f * 4096.0f) / (ADC_RESOLUTION * TEMP_COEFFICIENT))
+    #define TEMP_CENTI_OFFSET_Q12 TEMP_Q12_ROUND((27.0f + TEMP_AT_27C / TEMP_COEFFICIENT) * 100.0f * 4096.0f)
+    #define TEMP_CENTI_MIN (-32768)     // Results outside int16_t (far outside the sensor's
+    #define TEMP_CENTI_MAX 32767        // -40..125°C range, e.g. ADC 0 or 4095) saturate
+
+    /**
+     * @brief Integer version of adc_to_celsius(), in hundredths of a degree
+     *
+     * @param adc_val 12-bit ADC reading (clamped to 4095 like adc_to_celsius())
+     * @return int16_t Temperature x 100 (2700 = 27.00°C), within 1 of
+     *         adc_to_celsius() x 100; saturated to the int16_t range
+     *
+     * @note One multiply, one add and one shift: no soft-float call on the M0+
+     */
+    static inline int16_t adc_to_centi_celsius(uint16_t adc_val) {
+        if (adc_val > 4095) {
+            adc_val = 4095;
+        }
+        int32_t centi = ((int32_t)adc_val * TEMP_CENTI_SLOPE_Q12 + TEMP_CENTI_OFFSET_Q12 + 2048) >> 12;
+        return (int16_t)(centi > TEMP_CENTI_MAX ? TEMP_CENTI_MAX : centi < TEMP_CENTI_MIN ? TEMP_CENTI_MIN : centi);
+    }
+
+    /**
+     * @brief Converts a buffer of ADC readings (e.g. filled by DMA) to centi-degrees
+     *
+     * @param in Raw readings (bits above the 12-bit value, such as the FIFO error flag, are ignored)
+     * @param out n results, same values as adc_to_centi_celsius()
+     *
+     * @note Built with TEMPERATURE_CONV_USE_LUT, each sample is one lookup in temperature_lut
+     */
+    void adc_to_celsius_block(const uint16_t *in, int16_t *out, size_t n);
+
+    #ifdef TEMPERATURE_CONV_USE_LUT
+    // adc_to_centi_celsius() of every 12-bit reading, computed by the compiler (src/temperature_lut.cpp)
+    typedef struct {
+        int16_t centi[4096];
+    } temperature_lut_t;
+
+    extern const temperature_lut_t temperature_lut;
+    #endif
+
+    #ifdef __cplusplus
+    }
+    #endif
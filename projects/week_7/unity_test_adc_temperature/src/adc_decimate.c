@@ -0,0 +1,122 @@
+// Embarcatech, April 2025 - ADC Oversampling and Decimation
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    CIC decimator: N integrators run at the input rate, then every R
+    samples N combs (y = x - previous x) run at the output rate. The gain
+    is R^N, removed by one shift. The integrators overflow on purpose:
+    in two's complement the combs still give the exact result as long as
+    it fits the register, i.e. 12 + N x log2(R) <= 32 bits, which
+    adc_decimator_init() checks.
+
+    Order 1 is a plain boxcar average: the sum is restarted at each output,
+    so it needs no comb and its inner loop is a single add.
+    ======================================================================== */
+
+#include <string.h>  // memset()
+#include "adc_decimate.h"
+
+#define SAMPLE_MASK ((1u << ADC_DECIMATE_INPUT_BITS) - 1)  // Drops the FIFO error flag (bit 15)
+
+int adc_decimator_init(adc_decimator_t *dec, unsigned order, unsigned log2_ratio, unsigned out_bits) {
+    if (order < 1 || order > ADC_DECIMATE_MAX_ORDER) {
+        return ADC_DECIMATE_BAD_ORDER;
+    }
+    if (log2_ratio < 1 || log2_ratio > ADC_DECIMATE_MAX_LOG2_RATIO) {
+        return ADC_DECIMATE_BAD_RATIO;
+    }
+    unsigned gain_bits = order * log2_ratio;
+    if (ADC_DECIMATE_INPUT_BITS + gain_bits > 32) {
+        return ADC_DECIMATE_TOO_WIDE;
+    }
+    if (out_bits < ADC_DECIMATE_INPUT_BITS || out_bits > 16 || out_bits > ADC_DECIMATE_INPUT_BITS + gain_bits) {
+        return ADC_DECIMATE_BAD_BITS;
+    }
+    dec->order = (uint8_t)order;
+    dec->log2_ratio = (uint8_t)log2_ratio;
+    dec->out_bits = (uint8_t)out_bits;
+    dec->shift = (uint8_t)(gain_bits - (out_bits - ADC_DECIMATE_INPUT_BITS));
+    adc_decimator_reset(dec);
+    return ADC_DECIMATE_OK;
+}
+
+void adc_decimator_reset(adc_decimator_t *dec) {
+    dec->phase = 0;
+    memset(dec->integrator, 0, sizeof(dec->integrator));
+    memset(dec->comb, 0, sizeof(dec->comb));
+}
+
+// Gain removal with round to nearest
+static inline uint16_t scale(uint32_t value, unsigned shift) {
+    return (uint16_t)(shift ? (value + (1u << (shift - 1))) >> shift : value);
+}
+
+// Order 1: sum R samples, output, restart
+static size_t boxcar_block(adc_decimator_t *dec, const uint16_t *in, size_t n, uint16_t *out) {
+    uint32_t ratio = 1u << dec->log2_ratio;
+    uint32_t sum = dec->integrator[0];
+    uint32_t phase = dec->phase;
+    size_t produced = 0;
+
+    while (n > 0) {
+        size_t take = ratio - phase < n ? ratio - phase : n;
+        for (size_t i = 0; i < take; i++) {
+            sum += in[i] & SAMPLE_MASK;
+        }
+        in += take;
+        n -= take;
+        phase += (uint32_t)take;
+        if (phase == ratio) {
+            out[produced++] = scale(sum, dec->shift);
+            sum = 0;
+            phase = 0;
+        }
+    }
+    dec->integrator[0] = sum;
+    dec->phase = (uint16_t)phase;
+    return produced;
+}
+
+// Orders 2 and 3, with the order a constant so the stage loops unroll
+static inline size_t cic_block(adc_decimator_t *dec, const uint16_t *in, size_t n, uint16_t *out,
+                               const unsigned order) {
+    uint32_t ratio = 1u << dec->log2_ratio;
+    uint32_t acc[ADC_DECIMATE_MAX_ORDER];
+    uint32_t phase = dec->phase;
+    size_t produced = 0;
+
+    memcpy(acc, dec->integrator, sizeof(acc));
+    while (n > 0) {
+        size_t take = ratio - phase < n ? ratio - phase : n;
+        for (size_t i = 0; i < take; i++) {
+            acc[0] += in[i] & SAMPLE_MASK;
+            for (unsigned s = 1; s < order; s++) {
+                acc[s] += acc[s - 1];
+            }
+        }
+        in += take;
+        n -= take;
+        phase += (uint32_t)take;
+        if (phase == ratio) {
+            uint32_t value = acc[order - 1];
+            for (unsigned s = 0; s < order; s++) {
+                uint32_t previous = dec->comb[s];
+                dec->comb[s] = value;
+                value -= previous;
+            }
+            out[produced++] = scale(value, dec->shift);
+            phase = 0;
+        }
+    }
+    memcpy(dec->integrator, acc, sizeof(acc));
+    dec->phase = (uint16_t)phase;
+    return produced;
+}
+
+size_t adc_decimate_block(adc_decimator_t *dec, const uint16_t *in, size_t n, uint16_t *out) {
+    switch (dec->order) {
+        case 1: return boxcar_block(dec, in, n, out);
+        case 2: return cic_block(dec, in, n, out, 2);
+        default: return cic_block(dec, in, n, out, 3);
+    }
+}
@@ -46,6 +46,23 @@
          */
         return 27.0f - (((adc_val * VREF / ADC_RESOLUTION) - TEMP_AT_27C) / TEMP_COEFFICIENT);
     }
+
+    /**
+     * @brief Converts a block of raw ADC readings to centi-degrees
+     *
+     * @details Without the LUT the loop is adc_to_centi_celsius() inlined:
+     *          multiply, add, shift and saturate per sample. With the LUT it is
+     *          one 16-bit load from flash per sample.
+     */
+    void adc_to_celsius_block(const uint16_t *in, int16_t *out, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+    #ifdef TEMPERATURE_CONV_USE_LUT
+            out[i] = temperature_lut.centi[in[i] & 0x0FFF];
+    #else
+            out[i] = adc_to_centi_celsius(in[i] & 0x0FFF);
+    #endif
+        }
+    }
     
     /* ============================== Implementation Notes ==============================
     1. Voltage Calculation:
@@ -60,4 +77,8 @@
     3. Error Handling:
        - Input clamping prevents overflow
        - No division by zero risk (fixed coefficient)
+
+    4. Integer Path:
+       - Slope and offset in Q12 centi-degrees: 4095 x slope < 2^31, no overflow
+       - Rounding error below 1 centi-degree against the float version
     =================================================================================== */
\ No newline at end of file
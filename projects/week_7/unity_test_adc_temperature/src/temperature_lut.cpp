@@ -0,0 +1,32 @@
+// Embarcatech, April 2025 - RP2040 Temperature Lookup Table
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    The 4096 results of adc_to_centi_celsius(), computed by the compiler
+    (C++17 constexpr) from the same Q12 constants. The table is a const
+    object with a constant initializer, so the linker places it in flash
+    (8 KB). Linked only when TEMPERATURE_CONV_USE_LUT is on.
+    ======================================================================== */
+
+#include <stdint.h>             // Standard integer types
+#include "temperature_conv.h"   // Q12 constants and the table type
+
+namespace {
+
+// Same arithmetic as adc_to_centi_celsius(), evaluated at compile time
+constexpr temperature_lut_t build_table() {
+    temperature_lut_t t{};
+    for (int32_t adc = 0; adc < 4096; adc++) {
+        int32_t centi = (adc * TEMP_CENTI_SLOPE_Q12 + TEMP_CENTI_OFFSET_Q12 + 2048) >> 12;
+        t.centi[adc] = static_cast<int16_t>(centi > TEMP_CENTI_MAX ? TEMP_CENTI_MAX
+                                            : centi < TEMP_CENTI_MIN ? TEMP_CENTI_MIN : centi);
+    }
+    return t;
+}
+
+constexpr temperature_lut_t baked = build_table();
+static_assert(baked.centi[875] > 2600 && baked.centi[875] < 2800, "ADC 875 (0.705 V) must read about 27 degrees");
+
+}  // namespace
+
+extern "C" const temperature_lut_t temperature_lut = baked;
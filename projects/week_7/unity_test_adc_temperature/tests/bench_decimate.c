@@ -0,0 +1,185 @@
+// Embarcatech, April 2025 - ADC Decimation Check and Benchmark (host)
+// Author: Filipe Alves de Sousa
+// Checks the CIC decimator against a direct moving-sum reference (every order,
+// block splits, constant inputs, bad configurations), checks the resolution
+// gained on a noisy input, then times 4096-sample blocks.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -Iinclude tests/bench_decimate.c src/adc_decimate.c -o bench_decimate
+//   ./bench_decimate   (exit code 0 when the checks pass and a block takes < 1 ms)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <stdint.h>    // Standard integer types
+#include <string.h>    // memcmp()
+#include <time.h>      // clock_gettime()
+#include "adc_decimate.h"
+
+#define BLOCK 4096            // Samples per block (one DMA buffer)
+#define BENCH_BLOCKS 20000    // Blocks per timing
+#define BLOCK_LIMIT_US 1000.0 // Required: one block in well under a millisecond
+
+static uint16_t samples[BLOCK];
+static uint16_t expected[BLOCK];
+static uint16_t actual[BLOCK];
+static uint32_t rng = 2025;
+
+static uint32_t next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// Monotonic time in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Order N = N cascaded moving sums of R samples (zero history), one result every R samples
+static size_t reference(const uint16_t *in, size_t n, unsigned order, unsigned log2_ratio, unsigned out_bits,
+                        uint16_t *out) {
+    static uint64_t stage[ADC_DECIMATE_MAX_ORDER + 1][BLOCK];
+    size_t ratio = (size_t)1 << log2_ratio;
+    unsigned shift = order * log2_ratio - (out_bits - 12);
+    for (size_t i = 0; i < n; i++) {
+        stage[0][i] = in[i];
+    }
+    for (unsigned s = 1; s <= order; s++) {
+        for (size_t i = 0; i < n; i++) {
+            uint64_t sum = 0;
+            for (size_t k = 0; k < ratio && k <= i; k++) {
+                sum += stage[s - 1][i - k];
+            }
+            stage[s][i] = sum;
+        }
+    }
+    size_t produced = 0;
+    for (size_t i = ratio - 1; i < n; i += ratio) {
+        uint64_t v = stage[order][i];
+        out[produced++] = (uint16_t)(shift ? (v + (1ull << (shift - 1))) >> shift : v);
+    }
+    return produced;
+}
+
+static int check_reference(void) {
+    for (unsigned order = 1; order <= ADC_DECIMATE_MAX_ORDER; order++) {
+        for (unsigned log2_ratio = 1; log2_ratio <= ADC_DECIMATE_MAX_LOG2_RATIO; log2_ratio++) {
+            if (12 + order * log2_ratio > 32) {
+                continue;
+            }
+            unsigned out_bits = 12 + log2_ratio / 2;
+            adc_decimator_t dec;
+            adc_decimator_init(&dec, order, log2_ratio, out_bits);
+
+            size_t n = 1024;
+            for (size_t i = 0; i < n; i++) {
+                samples[i] = (uint16_t)(next_random() & 0x0FFF);
+            }
+            size_t wanted = reference(samples, n, order, log2_ratio, out_bits, expected);
+
+            // Fed in random pieces: the result must not depend on the block boundaries
+            size_t produced = 0;
+            for (size_t done = 0; done < n;) {
+                size_t piece = 1 + next_random() % 97;
+                piece = piece > n - done ? n - done : piece;
+                produced += adc_decimate_block(&dec, &samples[done], piece, &actual[produced]);
+                done += piece;
+            }
+            if (produced != wanted || memcmp(expected, actual, wanted * sizeof(uint16_t)) != 0) {
+                printf("  FAIL: order %u, ratio %u differs from the moving-sum reference\n", order, 1u << log2_ratio);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+// A constant input c settles at exactly c << (out_bits - 12), full scale included
+static int check_constant(void) {
+    static const uint16_t levels[] = { 0, 1, 875, 2048, 4095 };
+    for (unsigned l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+        for (unsigned order = 1; order <= 3; order++) {
+            adc_decimator_t dec;
+            adc_decimator_init(&dec, order, order == 3 ? 6 : 8, 16);
+            for (size_t i = 0; i < BLOCK; i++) {
+                samples[i] = levels[l] | 0x8000;  // FIFO error flag set: must be ignored
+            }
+            size_t produced = adc_decimate_block(&dec, samples, BLOCK, actual);
+            for (size_t i = order - 1; i < produced; i++) {
+                if (actual[i] != (uint16_t)(levels[l] << 4)) {
+                    printf("  FAIL: order %u, constant %u gave %u\n", order, levels[l], actual[i]);
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static int check_config(void) {
+    adc_decimator_t dec;
+    if (adc_decimator_init(&dec, 0, 4, 14) != ADC_DECIMATE_BAD_ORDER ||
+        adc_decimator_init(&dec, 1, 9, 16) != ADC_DECIMATE_BAD_RATIO ||
+        adc_decimator_init(&dec, 1, 2, 17) != ADC_DECIMATE_BAD_BITS ||
+        adc_decimator_init(&dec, 1, 1, 14) != ADC_DECIMATE_BAD_BITS ||
+        adc_decimator_init(&dec, 3, 8, 16) != ADC_DECIMATE_TOO_WIDE ||
+        adc_decimator_init(&dec, 2, 8, 16) != ADC_DECIMATE_OK) {
+        printf("  FAIL: configuration checks\n");
+        return 1;
+    }
+    return 0;
+}
+
+// 1000.3 LSB plus +-2 LSB of noise, quantized: 256x gives 16 bits that resolve the 0.3
+static int check_resolution(void) {
+    adc_decimator_t dec;
+    adc_decimator_init(&dec, 1, 8, 16);
+    for (size_t i = 0; i < BLOCK; i++) {
+        double noisy = 1000.3 + (next_random() % 4001) / 1000.0 - 2.0;
+        samples[i] = (uint16_t)(noisy + 0.5);
+    }
+    size_t produced = adc_decimate_block(&dec, samples, BLOCK, actual);
+    double mean = 0;
+    for (size_t i = 0; i < produced; i++) {
+        mean += actual[i] / 16.0;
+    }
+    mean /= produced;
+    printf("Noisy 1000.3 LSB input: 12-bit samples are whole LSBs, 16-bit results average %.3f LSB\n", mean);
+    if (mean < 1000.2 || mean > 1000.4) {
+        printf("  FAIL: no resolution gained\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    int failures = check_config() + check_reference() + check_constant() + check_resolution();
+    printf("Reference, constant and configuration checks: %s\n\n", failures ? "FAIL" : "ok");
+
+    static const unsigned configs[][3] = { { 1, 8, 16 }, { 1, 4, 14 }, { 2, 6, 15 }, { 3, 6, 15 }, { 3, 4, 14 } };
+    for (size_t i = 0; i < BLOCK; i++) {
+        samples[i] = (uint16_t)(next_random() & 0x0FFF);
+    }
+    printf("===== DECIMATION BENCHMARK (%d-sample block) =====\n", BLOCK);
+    printf("%-8s %-8s %-9s %-9s %-10s %-10s\n", "Order", "Ratio", "Bits", "Results", "us/block", "Msample/s");
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        adc_decimator_t dec;
+        adc_decimator_init(&dec, configs[c][0], configs[c][1], configs[c][2]);
+        size_t produced = 0;
+        double t0 = now_ns();
+        for (int b = 0; b < BENCH_BLOCKS; b++) {
+            produced = adc_decimate_block(&dec, samples, BLOCK, actual);
+        }
+        double us = (now_ns() - t0) / BENCH_BLOCKS / 1000;
+        printf("%-8u %-8u %-9u %-9zu %-10.2f %-10.1f\n", configs[c][0], 1u << configs[c][1], configs[c][2],
+               produced, us, BLOCK / us);
+        if (us > BLOCK_LIMIT_US) {
+            printf("  FAIL: above %.0f us per block\n", BLOCK_LIMIT_US);
+            failures++;
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+// Embarcatech, April 2025 - RP2040 Temperature Conversion Benchmark (host)
+// Author: Filipe Alves de Sousa
+// Times the float adc_to_celsius(), the integer adc_to_centi_celsius() and the
+// block conversion (arithmetic and LUT) on the host, and checks that the
+// integer, block and LUT paths agree on every 12-bit reading. On the RP2040 the
+// Unity runner prints the same comparison in CPU cycles.
+//
+// Build and run on the host (from the project folder):
+//   g++ -std=c++17 -O2 -Iinclude -DTEMPERATURE_CONV_USE_LUT -c src/temperature_lut.cpp -o temperature_lut.o
+//   gcc -O2 -Iinclude -DTEMPERATURE_CONV_USE_LUT tests/bench_temperature_conv.c src/adc_temperature.c temperature_lut.o -o bench_temperature_conv
+//   ./bench_temperature_conv   (exit code 0 when the paths agree)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <time.h>      // clock_gettime()
+#include "temperature_conv.h"
+
+#define SAMPLES 4096          // One DMA buffer
+#define ROUNDS 5000           // Buffers per timing
+
+static uint16_t in[SAMPLES];
+static int16_t out[SAMPLES];
+
+// Monotonic time in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Arithmetic block loop, for comparison with the LUT inside adc_to_celsius_block()
+static void block_arithmetic(const uint16_t *src, int16_t *dst, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = adc_to_centi_celsius(src[i] & 0x0FFF);
+    }
+}
+
+int main(void) {
+    int failures = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        in[i] = (uint16_t)i;
+    }
+    adc_to_celsius_block(in, out, SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) {
+        float reference = adc_to_celsius((uint16_t)i) * 100.0f;
+        int16_t centi = adc_to_centi_celsius((uint16_t)i);
+        if (out[i] != centi || temperature_lut.centi[i] != centi ||
+            (reference > TEMP_CENTI_MIN && reference < TEMP_CENTI_MAX && (centi - reference > 1.0f || reference - centi > 1.0f))) {
+            printf("  FAIL: ADC %d: float %.2f, integer %d, block %d\n", i, reference, centi, out[i]);
+            failures++;
+        }
+    }
+    printf("Integer, block and LUT paths on all 4096 readings: %s\n\n", failures ? "FAIL" : "ok");
+
+    for (int i = 0; i < SAMPLES; i++) {
+        in[i] = (uint16_t)(800 + (i * 7) % 150);  // Around room temperature
+    }
+    volatile float sink_f = 0;
+    volatile int32_t sink_i = 0;
+
+    double t0 = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        float sum = 0;
+        for (int i = 0; i < SAMPLES; i++) {
+            sum += adc_to_celsius(in[i]);
+        }
+        sink_f += sum;
+    }
+    double t1 = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        int32_t sum = 0;
+        for (int i = 0; i < SAMPLES; i++) {
+            sum += adc_to_centi_celsius(in[i]);
+        }
+        sink_i += sum;
+    }
+    double t2 = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        block_arithmetic(in, out, SAMPLES);
+        sink_i += out[r % SAMPLES];
+    }
+    double t3 = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        adc_to_celsius_block(in, out, SAMPLES);
+        sink_i += out[r % SAMPLES];
+    }
+    double t4 = now_ns();
+
+    double per = (double)ROUNDS * SAMPLES;
+    printf("===== CONVERSION BENCHMARK (ns per sample) =====\n");
+    printf("%-34s %.3f\n", "float adc_to_celsius()", (t1 - t0) / per);
+    printf("%-34s %.3f\n", "integer adc_to_centi_celsius()", (t2 - t1) / per);
+    printf("%-34s %.3f\n", "block, arithmetic", (t3 - t2) / per);
+    printf("%-34s %.3f\n", "block, LUT (adc_to_celsius_block)", (t4 - t3) / per);
+    return failures ? 1 : 0;
+}
@@ -9,7 +9,9 @@
 // Include necessary libraries
 #include "unity.h"              // Unity test framework
 #include "temperature_conv.h"   // Header with conversion function
+#include "adc_decimate.h"       // Oversampling and decimation
 #include "pico/stdlib.h"        // Pico SDK standard library
+#include "hardware/clocks.h"    // clock_get_hz() for cycle counts
 #include <stdio.h>              // Standard I/O functions
 #include <math.h>               // Math functions (for fabsf)
 
@@ -137,6 +139,105 @@ void test_max_adc_value() {
     TEST_ASSERT_FLOAT_WITHIN(1.0f, expected_max, actual_max);
 }
 
+// Integer path against the float one on every 12-bit reading
+void test_integer_matches_float() {
+    for (uint16_t adc = 0; adc <= 4095; adc++) {
+        float expected = adc_to_celsius(adc) * 100.0f;
+        int16_t centi = adc_to_centi_celsius(adc);
+        if (expected >= TEMP_CENTI_MIN && expected <= TEMP_CENTI_MAX) {
+            TEST_ASSERT_FLOAT_WITHIN(1.0f, expected, (float)centi);  // Within 0.01°C
+        } else {
+            TEST_ASSERT_EQUAL_INT16(expected > 0 ? TEMP_CENTI_MAX : TEMP_CENTI_MIN, centi);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT16(adc_to_centi_celsius(4095), adc_to_centi_celsius(5000));  // Clamped like the float version
+}
+
+// Batch conversion (LUT or arithmetic) gives the single-sample results
+void test_block_matches_single() {
+    static uint16_t in[4096];
+    static int16_t out[4096];
+    for (int i = 0; i < 4096; i++) {
+        in[i] = (uint16_t)i | (i & 1 ? 0x8000 : 0);  // FIFO error flag on odd samples: ignored
+    }
+    adc_to_celsius_block(in, out, 4096);
+    for (int i = 0; i < 4096; i++) {
+        TEST_ASSERT_EQUAL_INT16(adc_to_centi_celsius((uint16_t)i), out[i]);
+    }
+}
+
+// One line of the cost table: 1024 samples took elapsed_us
+void print_cost(const char *path, uint64_t elapsed_us, uint32_t mhz) {
+    printf("%-32s %6lu ns  %5lu cycles/sample\n", path,
+           (unsigned long)(elapsed_us * 1000 / 1024), (unsigned long)(elapsed_us * mhz / 1024));
+}
+
+// Time per sample of each conversion path, in ns and CPU cycles
+void print_conversion_cost() {
+    static uint16_t in[1024];
+    static int16_t out[1024];
+    volatile float sink_f = 0;
+    volatile int32_t sink_i = 0;
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000;
+
+    for (int i = 0; i < 1024; i++) {
+        in[i] = (uint16_t)(800 + (i & 127));  // Around room temperature
+    }
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < 1024; i++) {
+        sink_f += adc_to_celsius(in[i]);
+    }
+    uint64_t t1 = time_us_64();
+    for (int i = 0; i < 1024; i++) {
+        sink_i += adc_to_centi_celsius(in[i]);
+    }
+    uint64_t t2 = time_us_64();
+    adc_to_celsius_block(in, out, 1024);
+    uint64_t t3 = time_us_64();
+    (void)sink_f;
+    (void)sink_i;
+
+    printf("\n===== CONVERSION COST (1024 samples, %lu MHz) =====\n", (unsigned long)mhz);
+    print_cost("float adc_to_celsius()", t1 - t0, mhz);
+    print_cost("integer adc_to_centi_celsius()", t2 - t1, mhz);
+#ifdef TEMPERATURE_CONV_USE_LUT
+    print_cost("adc_to_celsius_block() (LUT)", t3 - t2, mhz);
+#else
+    print_cost("adc_to_celsius_block()", t3 - t2, mhz);
+#endif
+}
+
+// 256x oversampling: a steady reading becomes the same value with 4 more bits
+void test_decimate_constant() {
+    static uint16_t samples[1024];
+    uint16_t results[5];
+    adc_decimator_t dec;
+    uint16_t adc_val = calculate_adc_value(0.706f);  // Known 27°C voltage
+
+    TEST_ASSERT_EQUAL_INT(ADC_DECIMATE_OK, adc_decimator_init(&dec, 1, 8, 16));
+    for (int i = 0; i < 1024; i++) {
+        samples[i] = adc_val;
+    }
+    TEST_ASSERT_EQUAL_UINT32(4, adc_decimate_block(&dec, samples, 1024, results));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_UINT16(adc_val << 4, results[i]);
+    }
+}
+
+// Readings alternating between two codes average to the half step in between
+void test_decimate_half_step() {
+    static uint16_t samples[256];
+    uint16_t result;
+    adc_decimator_t dec;
+
+    adc_decimator_init(&dec, 1, 8, 16);
+    for (int i = 0; i < 256; i++) {
+        samples[i] = 875 + (i & 1);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, adc_decimate_block(&dec, samples, 256, &result));
+    TEST_ASSERT_EQUAL_UINT16((875 << 4) + 8, result);  // 875.5 in 16-bit units
+}
+
 // Main test runner
 int main() {
     init_serial();  // Initialize communication
@@ -157,7 +258,13 @@ int main() {
     RUN_TEST(test_lower_temperature);
     RUN_TEST(test_min_adc_value);
     RUN_TEST(test_max_adc_value);
+    RUN_TEST(test_integer_matches_float);
+    RUN_TEST(test_block_matches_single);
+    RUN_TEST(test_decimate_constant);
+    RUN_TEST(test_decimate_half_step);
     
+    print_conversion_cost();
+
     // Cleanup and exit
     printf("\n===== TEST COMPLETE =====\n");
     fflush(stdout);  // Ensure all output is flushed
@@ -0,0 +1,133 @@
+// Embarcatech, May 2025 - Layered framebuffer compositor
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Builds an SSD1306 page-format frame (128 x 8 pages, 1 bpp) from
+    separate layers, recomposing only the pages that changed.
+
+    Key Features:
+    - Background layer: rasterized once, changed only on demand
+    - Object layer: cleared and redrawn every frame, but only over the
+      pages that held objects
+    - HUD layer plus a mask: text boxes punch through the layers below,
+      so labels stay readable over moving objects
+    - Per page: frame = ((background | objects) & ~mask) | hud, computed
+      with 32-bit words
+    - Dirty-page tracking: pages are recomposed only when a layer
+      changed, and reported for flushing only when the frame changed
+    - The bottom pages can be left to a client that draws straight into
+      the frame (e.g. the incremental histogram)
+    - No hardware dependency: usable and testable on the host
+
+    Typical frame:
+        compositor_clear_objects(&c);
+        compositor_set_pixel(&c, x, y);         // per object
+        compositor_compose(&c);
+        if (compositor_take_flush(&c, &first, &last)) send pages first..last
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool type
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COMPOSITOR_WIDTH 128                                 // Columns (bytes per page)
+#define COMPOSITOR_PAGES 8                                   // 8-pixel pages (64 rows)
+#define COMPOSITOR_BYTES (COMPOSITOR_WIDTH * COMPOSITOR_PAGES)
+#define COMPOSITOR_PAGE_WORDS (COMPOSITOR_WIDTH / 4)         // 32-bit words per page
+#define COMPOSITOR_ALL_PAGES 0xFFu
+
+/**
+ * @brief One 1-bpp plane in page format, addressable as bytes or words
+ */
+typedef union {
+    uint32_t words[COMPOSITOR_BYTES / 4];
+    uint8_t bytes[COMPOSITOR_BYTES];
+} compositor_plane_t;
+
+/**
+ * @brief Layers, output frame and page bookkeeping
+ */
+typedef struct {
+    compositor_plane_t background;  // Static part of the screen
+    compositor_plane_t objects;     // Redrawn every frame
+    compositor_plane_t hud;         // Text pixels
+    compositor_plane_t hud_mask;    // Pixels hidden behind the HUD boxes
+    compositor_plane_t frame;       // Composed result, sent to the display
+    uint8_t pages;                  // Pages 0..pages-1 are composed; the rest belong to the client
+    uint8_t dirty;                  // Pages to recompose (bit per page)
+    uint8_t object_pages;           // Pages holding object pixels
+    uint8_t flush;                  // Frame pages changed since the last compositor_take_flush()
+
+    // Cost of the last compositor_compose()
+    uint8_t last_pages_composed;
+    uint8_t last_pages_changed;
+} compositor_t;
+
+/**
+ * @brief Clears every layer and the frame
+ * @param pages Number of pages, from the top, built from the layers
+ */
+void compositor_init(compositor_t *c, uint8_t pages);
+
+/**
+ * @brief Changes how many top pages are composed (the rest is left to the client)
+ * @note Marks every page for recomposition and flushing
+ */
+void compositor_set_pages(compositor_t *c, uint8_t pages);
+
+/**
+ * @brief Marks the background as changed (after drawing into c->background.bytes)
+ */
+void compositor_background_changed(compositor_t *c);
+
+/**
+ * @brief Empties the object layer, touching only the pages that held objects
+ */
+void compositor_clear_objects(compositor_t *c);
+
+/**
+ * @brief Sets one pixel of the object layer
+ * @note No bounds check: (x, y) must be on the screen
+ */
+static inline void compositor_set_pixel(compositor_t *c, int x, int y) {
+    uint8_t page = (uint8_t)(1u << (y >> 3));
+    c->objects.bytes[(y >> 3) * COMPOSITOR_WIDTH + x] |= (uint8_t)(1u << (y & 7));
+    c->object_pages |= page;
+    c->dirty |= page;
+}
+
+/**
+ * @brief Clears a HUD box and hides the layers below it
+ *
+ * The text is then drawn into c->hud.bytes inside the box.
+ * @param x First column
+ * @param page Page of the box (boxes are one page high)
+ * @param width Columns covered
+ */
+void compositor_hud_box(compositor_t *c, int x, int page, int width);
+
+/**
+ * @brief Reports frame pages written directly by the client (bit per page)
+ */
+void compositor_mark_flush(compositor_t *c, uint8_t pages);
+
+/**
+ * @brief Recomposes the dirty pages into c->frame
+ * @return Number of pages whose content changed
+ */
+int compositor_compose(compositor_t *c);
+
+/**
+ * @brief Takes the span of frame pages changed since the last call
+ * @return false when nothing changed
+ */
+bool compositor_take_flush(compositor_t *c, uint8_t *first_page, uint8_t *last_page);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,75 @@
+// Embarcatech, May 2025 - Fixed-timestep scheduler
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Accumulator that decouples the simulation rate from the display rate.
+
+    Key Features:
+    - Simulation advances in constant steps whatever the render time
+      (a slow I2C flush is caught up with several substeps)
+    - Substeps per call are capped: time beyond the cap is dropped and
+      counted, so a stall never snowballs into a longer stall
+    - Step and render counters, current and worst lag exported for tuning
+    - Pure logic on a microsecond clock: usable and testable on the host
+
+    Typical loop:
+        int steps = fixed_timestep_advance(&ts, time_us_32());
+        while (steps--) simulate();
+        render(); fixed_timestep_rendered(&ts);
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Scheduler state and tuning counters
+ */
+typedef struct {
+    uint32_t step_us;         // Simulation step period
+    uint32_t last_us;         // Clock value of the previous advance
+    uint32_t accumulator_us;  // Time not yet simulated (lag, always < step_us after advance)
+    uint8_t max_steps;        // Substep cap per advance
+
+    // Counters
+    uint32_t steps;           // Steps handed out since init
+    uint32_t renders;         // Frames rendered since init
+    uint32_t dropped_us;      // Time discarded by the substep cap
+    uint32_t max_lag_us;      // Largest backlog seen before stepping
+    uint8_t last_steps;       // Substeps of the last advance
+} fixed_timestep_t;
+
+/**
+ * @brief Starts the scheduler
+ *
+ * @param step_hz Simulation rate
+ * @param max_steps Substep cap per advance (at least 1)
+ * @param now_us Current clock value
+ */
+void fixed_timestep_init(fixed_timestep_t *ts, uint32_t step_hz, uint8_t max_steps, uint32_t now_us);
+
+/**
+ * @brief Adds the elapsed time and returns how many steps to simulate now
+ * @note Clock wrap-around (uint32 microseconds) is handled
+ */
+int fixed_timestep_advance(fixed_timestep_t *ts, uint32_t now_us);
+
+/**
+ * @brief Counts a rendered frame
+ */
+static inline void fixed_timestep_rendered(fixed_timestep_t *ts) {
+    ts->renders++;
+}
+
+/**
+ * @brief Time until the next step is due (0 if one is already due)
+ */
+uint32_t fixed_timestep_wait_us(const fixed_timestep_t *ts, uint32_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
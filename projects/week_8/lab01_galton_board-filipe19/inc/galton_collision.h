@@ -0,0 +1,101 @@
+// Embarcatech, May 2025 - "Digital Galton Board" pin collision interface
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Grid-indexed collision lookup against the pin lattice.
+
+    The pins sit on a regular hexagonal lattice: row r holds r + 1 pins,
+    shifted by half a spacing from the previous row. The candidate pin
+    of a ball is computed directly from its position with integer
+    arithmetic (nearest row from y, nearest column from x and the row's
+    first pin), so a collision test costs O(1) whatever the number of rows.
+
+    Two tests are provided:
+    - pin_grid_find_hit(): discrete, checks the position at the end of a
+      step; a ball falling more than 2 pixels per step can tunnel through
+    - pin_grid_sweep(): continuous, follows the ballistic path through the
+      step and returns the exact time the ball crosses each row, so no pin
+      is skipped whatever the step length
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool type
+#include "galton_config.h"
+#include "galton_geometry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A ball hits a pin when it is within 1 pixel vertically and a quarter spacing horizontally
+#define PIN_HIT_RADIUS TO_FIXED(1)
+
+/**
+ * @brief Precomputed pin lattice (Q9.7 coordinates)
+ */
+typedef struct {
+    int16_t row_y[MAX_ROWS];        // Vertical position of each row
+    int16_t row_first_x[MAX_ROWS];  // Horizontal position of the leftmost pin of each row
+    uint8_t rows;                   // Rows in use
+    int16_t spacing;                // Pin spacing
+    int16_t half_spacing;           // Half the pin spacing
+    int16_t hit_half_width;         // Horizontal hit tolerance
+} pin_grid_t;
+
+/**
+ * @brief Builds the per-row pin offsets for a board layout
+ */
+void pin_grid_init(pin_grid_t *grid, const galton_geometry_t *geom);
+
+/**
+ * @brief Finds the pin hit by a ball at (x, y), if any
+ *
+ * @param grid Pin lattice
+ * @param x, y Ball position (Q9.7)
+ * @param pin_x, pin_y Receive the pin position on a hit
+ * @return true when the ball is inside the hit window of its nearest pin
+ */
+bool pin_grid_find_hit(const pin_grid_t *grid, int16_t x, int16_t y, int16_t *pin_x, int16_t *pin_y);
+
+/**
+ * @brief Finds the first pin hit along a ballistic path (continuous detection)
+ *
+ * The ball moves from (x0, y0) with velocity (vx, vy) under gravity for
+ * `duration` base steps. A row counts as hit when the ball crosses its line
+ * moving down faster than min_vy and within the hit width of a pin.
+ *
+ * @param x0, y0 Start position (Q9.7)
+ * @param vx, vy Velocity (Q9.7 pixels per base step)
+ * @param gravity Gravity (Q9.7 pixels per base step^2, > 0)
+ * @param min_vy Crossings at or below this downward speed are ignored
+ * @param duration_q8 Length of the path (base steps, Q8)
+ * @param t_q8 Receives the time of impact (Q8, 0..duration_q8)
+ * @param pin_x, pin_y Receive the pin position on a hit
+ * @return true on a hit
+ */
+bool pin_grid_sweep(const pin_grid_t *grid, int16_t x0, int16_t y0, int16_t vx, int16_t vy,
+                    int16_t gravity, int16_t min_vy, int32_t duration_q8,
+                    int32_t *t_q8, int16_t *pin_x, int16_t *pin_y);
+
+/**
+ * @brief Position and speed after t_q8 base steps of ballistic motion (exact for constant gravity)
+ */
+static inline void ballistic_advance(int32_t *x, int32_t *y, int32_t *vy, int32_t vx,
+                                     int32_t gravity, int32_t t_q8) {
+    *x += (vx * t_q8) >> 8;
+    *y += ((*vy * t_q8) >> 8) + (int32_t)(((int64_t)gravity * t_q8 * t_q8) >> 17);  // vy t + g t^2 / 2
+    *vy += (gravity * t_q8) >> 8;
+}
+
+/**
+ * @brief Number of pins in a row
+ */
+static inline int pin_grid_row_count(int row) {
+    return row + 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,76 @@
+// Embarcatech, May 2025 - "Digital Galton Board" configuration
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Configuration and constants shared by the simulation and display layers.
+
+    Key Features:
+    - Hardware pin mapping for the BitDogLab (OLED, buttons)
+    - Board geometry limits (rows, pin spacing, histogram height)
+    - Physics parameters (gravity, bounciness) and simulation step rate
+    - Fixed-point format and capacity of the ball pool
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+// === HARDWARE CONFIGURATION ===
+#define BUTTON_A 5                  // Button A: balls released per cycle
+#define BUTTON_B 6                  // Button B: bias adjustment
+#define BUTTON_JOYSTICK 22          // Joystick push: next board geometry preset
+
+#define I2C_PORT i2c1               // I2C peripheral used by the OLED display
+#define SDA_PIN 14                  // GPIO pin for I2C data (SDA)
+#define SCL_PIN 15                  // GPIO pin for I2C clock (SCL)
+#define I2C_SPEED 400000            // I2C communication speed (400 kHz)
+
+#define DEBOUNCE_TIME_MS 200        // Minimum interval between valid button presses
+
+// === BOARD GEOMETRY ===
+#define DISPLAY_WIDTH 128           // OLED width in pixels
+#define DISPLAY_HEIGHT 64           // OLED height in pixels
+#define BOARD_CENTER_X 64           // Horizontal position of the top pin
+
+// Rows and spacing can change at run time (galton_set_geometry()); the derived
+// coordinates live in galton_geometry_t
+#define DEFAULT_ROWS 6              // Number of pin rows at startup (bins = rows + 1)
+#define DEFAULT_PIN_SPACING 6       // Distance between pins at startup, in pixels
+#define MIN_ROWS 1
+#define MAX_ROWS 10                 // Sizes the per-row and per-bin tables
+#define MAX_BINS (MAX_ROWS + 1)
+#define MIN_PIN_SPACING 4           // Spacing must be even (balls bounce half a spacing sideways)
+#define MAX_PIN_SPACING 14
+#define PIN_TOP_Y 12                // Vertical position of the first pin row
+#define PIN_RADIUS 1                // Hexagonal pin drawn on the board (1 = 5-pixel cross)
+
+#define MAX_HISTOGRAM_HEIGHT 16     // Maximum bar height after normalization (10-20)
+#define MIN_HISTOGRAM_HEIGHT 8      // Layouts leaving less room below the bins are rejected
+
+// === PHYSICS PARAMETERS ===
+#define SIM_STEP_HZ 50              // Physics steps per second, independent of the display rate
+#define MAX_SUBSTEPS 8              // Steps caught up at most per rendered frame
+#define SIM_STEP_SCALE 1            // Base steps advanced per physics step (1..MAX_STEP_SCALE)
+#define MAX_STEP_SCALE 8            // Longest step the swept collision test is validated for
+
+#define GRAVITY 0.2f                // Downward acceleration, in pixels/step^2 (MIN_GRAVITY-MAX_GRAVITY)
+#define BOUNCINESS 0.5f             // Restitution coefficient on pin collisions (MIN_BOUNCINESS-MAX_BOUNCINESS)
+#define MIN_GRAVITY 0.1f            // galton_set_physics() clamps to these ranges
+#define MAX_GRAVITY 0.5f
+#define MIN_BOUNCINESS 0.1f
+#define MAX_BOUNCINESS 0.9f
+
+#define DEFAULT_SIM_MODE GALTON_MODE_PHYSICS // GALTON_MODE_TRAJECTORY replays precomputed arcs
+#define DEFAULT_COLLISION GALTON_COLLISION_SWEPT // GALTON_COLLISION_DISCRETE tests the end of each step only
+
+#define DEFAULT_BIAS 5              // 0 = always left, 5 = balanced, 10 = always right
+#define MAX_BIAS 10                 // Always right (galton_set_bias() clamps to it)
+#define MAX_BALLS_PER_CYCLE 5       // Button A cycles through 1..MAX_BALLS_PER_CYCLE
+#define FRAMES_PER_CYCLE 8          // A new cycle of balls is released every N steps
+
+// === BALL POOL ===
+// Positions and velocities are stored as int16 in Q9.7 fixed point
+// (1/128 pixel resolution, covers the whole 128x64 display).
+#define FIXED_SHIFT 7
+#define TO_FIXED(v) ((int16_t)((v) * (1 << FIXED_SHIFT)))
+#define FROM_FIXED(v) ((v) >> FIXED_SHIFT)
+
+#define BALL_POOL_CAPACITY 2048     // Maximum number of balls in flight (multiple of 32)
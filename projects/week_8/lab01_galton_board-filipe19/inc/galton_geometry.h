@@ -0,0 +1,64 @@
+// Embarcatech, May 2025 - "Digital Galton Board" board geometry
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Board layout derived from the number of rows and the pin spacing.
+
+    Key Features:
+    - Rows and spacing chosen at run time, within the limits of galton_config.h
+    - Every coordinate the frame loop needs (rows, bins, spawn point,
+      histogram area) computed once by galton_geometry_build()
+    - Pixel and Q9.7 copies of the values used in the hot loop, so no
+      conversion or multiplication by the spacing happens per ball
+    - Layouts that do not fit the display are rejected
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include "galton_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Return codes (0 on success, negative on error)
+#define GALTON_GEOMETRY_OK 0
+#define GALTON_GEOMETRY_ERR_RANGE (-1)   // Rows or spacing outside the config limits
+#define GALTON_GEOMETRY_ERR_FIT (-2)     // Board or histogram does not fit the display
+
+/**
+ * @brief Layout of the board, pins and bins
+ */
+typedef struct {
+    uint8_t rows;                 // Pin rows
+    uint8_t bins;                 // Receptacles (rows + 1)
+    uint8_t spacing;              // Distance between pins (pixels, even)
+    uint8_t pin_top_y;            // Row of the first pin
+    uint8_t bin_top_y;            // Balls are counted once they reach this line
+    uint8_t spawn_y;              // Balls are released one spacing above the top pin
+    uint8_t histogram_x;          // Left wall of bin 0
+    uint8_t histogram_first_page; // First display page owned by the histogram
+    uint8_t histogram_height;     // Tallest bar (fits below histogram_first_page)
+
+    // Q9.7 copies for the frame loop
+    int16_t spacing_fixed;
+    int16_t half_spacing_fixed;
+    int16_t bin_top_fixed;
+    int16_t bins_left_fixed;
+    int16_t spawn_x_fixed;
+    int16_t spawn_y_fixed;
+} galton_geometry_t;
+
+/**
+ * @brief Computes the layout for a number of rows and a pin spacing
+ *
+ * @param rows MIN_ROWS..MAX_ROWS
+ * @param spacing MIN_PIN_SPACING..MAX_PIN_SPACING, even
+ * @return GALTON_GEOMETRY_OK, or a negative error code (geom left unchanged)
+ */
+int galton_geometry_build(galton_geometry_t *geom, uint8_t rows, uint8_t spacing);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,139 @@
+// Embarcatech, May 2025 - "Digital Galton Board" record/replay
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Deterministic record and replay of simulation runs.
+
+    A run is fully defined by its seed, its starting parameters and the
+    inputs applied at each frame. The recorder stores them in a compact
+    binary log; the replayer re-runs the log headlessly (host or device)
+    and produces the same histogram bit for bit, plus a per-frame timing
+    profile.
+
+    Log format (little endian):
+    - Header (24 bytes): "GLOG", version, rows, pin spacing, mode,
+      seed (u32), bias, balls per cycle, gravity and bounciness (f32 bits),
+      step scale, collision test
+    - Events: varint frame delta, type (1 byte), varint value
+    - Last event: GALTON_EV_END, whose frame is the total frame count, or
+      the frame of the first lost input when the buffer filled up
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stddef.h>   // size_t
+#include <stdbool.h>  // bool type
+#include "galton_simulation.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GALTON_LOG_VERSION 2
+#define GALTON_LOG_HEADER_BYTES 24
+#define GALTON_LOG_END_BYTES 6          // Largest END event (5-byte frame delta + type), always kept free
+
+// Return codes (0 on success, negative on error)
+#define GALTON_LOG_OK 0
+#define GALTON_LOG_ERR_FULL (-1)        // Recorder buffer is full
+#define GALTON_LOG_ERR_FORMAT (-2)      // Bad magic, version, event type, or a value out of range
+#define GALTON_LOG_ERR_GEOMETRY (-3)    // Board geometry rejected by galton_set_geometry()
+#define GALTON_LOG_ERR_TRUNCATED (-4)   // Log ends before GALTON_EV_END
+
+/**
+ * @brief Inputs that can change a run
+ */
+typedef enum {
+    GALTON_EV_BUTTON_A = 1,     // galton_button_a()
+    GALTON_EV_BUTTON_B,         // galton_button_b()
+    GALTON_EV_SET_BIAS,         // galton_set_bias(value)
+    GALTON_EV_SET_BALLS,        // balls_per_cycle = value
+    GALTON_EV_SET_MODE,         // galton_set_mode(value)
+    GALTON_EV_SET_GRAVITY,      // value = float bits
+    GALTON_EV_SET_BOUNCINESS,   // value = float bits
+    GALTON_EV_SET_GEOMETRY,     // value = rows | spacing << 8
+    GALTON_EV_END = 0xFF        // End of the log (no value)
+} galton_event_type_t;
+
+/**
+ * @brief Log being recorded in a caller-provided buffer
+ */
+typedef struct {
+    uint8_t *buffer;        // Log storage
+    size_t capacity;        // Size of buffer
+    size_t length;          // Bytes written
+    size_t end_offset;      // Offset of the END event when closed (0 otherwise)
+    uint32_t last_frame;    // Frame of the previous event (delta reference)
+    bool overflow;          // Set when an event did not fit (nothing but END is written after it)
+    uint32_t lost_frame;    // Frame of that event: where a truncated log ends
+} galton_recorder_t;
+
+/**
+ * @brief Timing profile of a replay
+ */
+typedef struct {
+    uint32_t frames;            // Frames replayed
+    uint32_t events;            // Events applied
+    uint32_t min_us;            // Fastest frame
+    uint32_t max_us;            // Slowest frame
+    uint64_t total_us;          // Sum of all frame times
+    uint32_t *frame_us;         // Optional per-frame times (may be NULL)
+    uint32_t frame_us_capacity; // Entries available in frame_us
+} galton_profile_t;
+
+/**
+ * @brief Starts a log with the current parameters of sim and its seed
+ * @return GALTON_LOG_OK or GALTON_LOG_ERR_FULL (no room for the header and an END)
+ */
+int galton_recorder_begin(galton_recorder_t *rec, uint8_t *buffer, size_t capacity,
+                          const galton_sim_t *sim, uint32_t seed);
+
+/**
+ * @brief Appends an event applied at the start of the given frame. Room for
+ *        the END event is kept free. Once one event has not fit, every later
+ *        one is refused too, so the log ends at the first lost input instead
+ *        of skipping it
+ * @return GALTON_LOG_OK or GALTON_LOG_ERR_FULL
+ */
+int galton_recorder_event(galton_recorder_t *rec, uint32_t frame, uint8_t type, uint32_t value);
+
+/**
+ * @brief Appends GALTON_EV_END so the log can be replayed. After an overflow
+ *        the END is placed at the frame of the lost input, so the truncated
+ *        log replays exactly up to it
+ */
+int galton_recorder_end(galton_recorder_t *rec, uint32_t frame);
+
+/**
+ * @brief Removes the END event so recording can go on
+ */
+void galton_recorder_reopen(galton_recorder_t *rec);
+
+/**
+ * @brief Applies an input to the simulation (used live and by the replayer)
+ * @return GALTON_LOG_OK, GALTON_LOG_ERR_FORMAT (unknown type or value out of
+ *         range) or GALTON_LOG_ERR_GEOMETRY; the simulation is unchanged on error
+ */
+int galton_apply_event(galton_sim_t *sim, uint8_t type, uint32_t value);
+
+/**
+ * @brief Re-runs a log from galton_init() without rendering
+ *
+ * @param log, length Log bytes
+ * @param sim Simulation to run (reinitialized)
+ * @param profile Receives the timing profile (may be NULL)
+ * @param now_us Microsecond clock used for the profile (may be NULL)
+ * @return GALTON_LOG_OK or a negative error code
+ */
+int galton_replay(const uint8_t *log, size_t length, galton_sim_t *sim,
+                  galton_profile_t *profile, uint32_t (*now_us)(void));
+
+/**
+ * @brief FNV-1a hash of the histogram counts, to compare two runs
+ */
+uint32_t galton_histogram_checksum(const galton_sim_t *sim);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,53 @@
+// Embarcatech, May 2025 - "Digital Galton Board" static screens
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Screens that never change while shown: the splash screen and the
+    board background (pins, entry track, bin walls).
+
+    Key Features:
+    - Splash screen and the background of every geometry preset rendered
+      at compile time (constexpr C++17, src/galton_screens.cpp) into const
+      page-format arrays in flash: showing one is a single copy
+    - Presets that do not fit the display fail the build (static_assert)
+    - Run-time rasterizer for geometries that are not baked (set through a
+      replayed log, for instance), producing the same pixels
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include "galton_geometry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GALTON_SCREEN_BYTES 1024      // 128 x 64 pixels in page format
+#define GALTON_GEOMETRY_PRESETS 4     // Layouts cycled by the joystick button
+
+/**
+ * @brief Board layouts cycled by the joystick button: { rows, pin spacing }
+ */
+extern const uint8_t galton_geometry_presets[GALTON_GEOMETRY_PRESETS][2];
+
+/**
+ * @brief Splash screen shown while the board starts
+ */
+const uint8_t *galton_splash_screen(void);
+
+/**
+ * @brief Background baked for a layout
+ * @return The screen in flash, or NULL when this layout is not a preset
+ */
+const uint8_t *galton_baked_background(uint8_t rows, uint8_t spacing);
+
+/**
+ * @brief Rasterizes the background of any valid layout at run time
+ * @param buffer Page-format framebuffer (GALTON_SCREEN_BYTES, cleared first)
+ */
+void galton_draw_background(uint8_t *buffer, const galton_geometry_t *geom);
+
+#ifdef __cplusplus
+}
+#endif
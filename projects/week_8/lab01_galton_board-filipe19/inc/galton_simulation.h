@@ -0,0 +1,247 @@
+// Embarcatech, May 2025 - "Digital Galton Board" simulation interface
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Simulation layer of the Galton board: ball storage, physics update,
+    collisions with the pins and bin counting.
+
+    Ball storage is a fixed-capacity structure-of-arrays pool:
+    - int16 Q9.7 position and velocity (8 bytes of state per ball)
+    - Active bitmap (1 bit per ball) used to walk the live balls in order
+    - Free list of slot indices for O(1) spawn and retire
+    - No dynamic allocation: the pool lives inside galton_sim_t
+
+    Two update modes share the pool:
+    - GALTON_MODE_PHYSICS: exact ballistic integration and pin collisions,
+      continuous (swept) by default so longer steps cannot tunnel
+    - GALTON_MODE_TRAJECTORY: balls replay the precomputed bounce arc;
+      x/y hold the anchor pin (Q9.7), vx the direction (-1, 0, +1) and
+      vy the frame index within the arc
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool type
+#include "galton_config.h"
+#include "galton_geometry.h"
+#include "galton_collision.h"
+#include "galton_trajectory.h"
+#include "histogram.h"
+#include "galton_stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BALL_POOL_WORDS (BALL_POOL_CAPACITY / 32) // 32-bit words in the active bitmap
+
+/**
+ * @brief Structure-of-arrays ball store
+ *
+ * @note Each array is walked sequentially by the update loop, so the live
+ *       balls stay packed at the low indices (the free list hands out the
+ *       lowest free slot first after galton_init()).
+ */
+typedef struct {
+    int16_t x[BALL_POOL_CAPACITY];            // Horizontal position (Q9.7 pixels)
+    int16_t y[BALL_POOL_CAPACITY];            // Vertical position (Q9.7 pixels)
+    int16_t vx[BALL_POOL_CAPACITY];           // Horizontal velocity (Q9.7 pixels/frame)
+    int16_t vy[BALL_POOL_CAPACITY];           // Vertical velocity (Q9.7 pixels/frame)
+    uint32_t active[BALL_POOL_WORDS];         // Bit i set when slot i holds a live ball
+    uint16_t free_list[BALL_POOL_CAPACITY];   // Stack of free slot indices
+    uint16_t free_count;                      // Number of entries in free_list
+    uint16_t active_count;                    // Number of live balls
+} ball_pool_t;
+
+// Memory cost of one ball slot: 8 bytes of state, 2 bytes of free list, 1 bit of bitmap
+#define BALL_STATE_BYTES (4 * sizeof(int16_t))
+#define BALL_POOL_BYTES_PER_BALL ((float)sizeof(ball_pool_t) / BALL_POOL_CAPACITY)
+
+/**
+ * @brief How balls are animated
+ */
+typedef enum {
+    GALTON_MODE_PHYSICS,     // Integration plus collision every frame
+    GALTON_MODE_TRAJECTORY   // Table lookup every frame, decision at each row
+} galton_mode_t;
+
+/**
+ * @brief Pin collision test of the physics mode
+ */
+typedef enum {
+    GALTON_COLLISION_SWEPT,     // Time of impact along the path (no tunneling)
+    GALTON_COLLISION_DISCRETE   // Position at the end of the step only
+} galton_collision_t;
+
+/**
+ * @brief Complete simulation state
+ */
+typedef struct {
+    ball_pool_t balls;                // Balls in flight
+    galton_geometry_t geom;           // Rows, spacing and the coordinates derived from them
+    pin_grid_t pins;                  // Pin lattice used for collisions and drawing
+    histogram_t histogram;            // Balls collected per bin (counts, total and bar state)
+    galton_stats_t stats;             // Running moments and fit to Binomial(rows, p)
+    uint8_t bias;                     // 0 = always left, 5 = balanced, 10 = always right
+    uint8_t balls_per_cycle;          // Balls released by galton_release_cycle()
+    int16_t gravity;                  // GRAVITY in Q9.7
+    int16_t bounce_vx;                // Horizontal speed after a bounce (Q9.7)
+    int16_t bounce_vy;                // Upward speed after a bounce (Q9.7)
+    galton_mode_t mode;               // Current update mode
+    trajectory_table_t arc;           // Bounce arc used by the trajectory mode
+    float gravity_setting;            // Last values given to galton_set_physics()
+    float bounciness_setting;
+    uint32_t rng;                     // xorshift32 state (never 0)
+    uint32_t frame;                   // Frames advanced by galton_frame()
+    uint32_t ticks;                   // Base steps simulated (frame * step_scale)
+    uint8_t step_scale;               // Base steps per galton_update() (1..MAX_STEP_SCALE)
+    galton_collision_t collision;     // Collision test of the physics mode
+    uint32_t pin_hits;                // Pin impacts since galton_reset() (rows per landed ball when none is missed)
+} galton_sim_t;
+
+/**
+ * @brief Empties the pool and rebuilds the free list
+ * @param pool Pool to reset
+ */
+void ball_pool_init(ball_pool_t *pool);
+
+/**
+ * @brief Takes a free slot and marks it active (O(1))
+ * @return Slot index, or -1 when the pool is full
+ */
+int ball_pool_spawn(ball_pool_t *pool, int16_t x, int16_t y, int16_t vx, int16_t vy);
+
+/**
+ * @brief Returns a slot to the free list (O(1))
+ * @warning idx must refer to an active slot
+ */
+void ball_pool_retire(ball_pool_t *pool, uint16_t idx);
+
+/**
+ * @brief Checks whether a slot holds a live ball
+ */
+static inline bool ball_pool_is_active(const ball_pool_t *pool, uint16_t idx) {
+    return (pool->active[idx >> 5] >> (idx & 31)) & 1u;
+}
+
+/**
+ * @brief Initializes the simulation (pins, bounce arcs, empty pool and histogram)
+ */
+void galton_init(galton_sim_t *sim);
+
+/**
+ * @brief Seeds the random generator; the same seed and inputs give the same run
+ */
+void galton_seed(galton_sim_t *sim, uint32_t seed);
+
+/**
+ * @brief Changes gravity and bounciness, rebuilding the bounce speeds and arc table
+ * @param gravity Pixels/frame^2 (0.1-0.5, clamped; NaN gives the minimum)
+ * @param bounciness Restitution coefficient (0.1-0.9, clamped; NaN gives the minimum)
+ */
+void galton_set_physics(galton_sim_t *sim, float gravity, float bounciness);
+
+/**
+ * @brief Changes the number of rows and the pin spacing
+ *
+ * Rebuilds the layout, pin lattice, bounce speeds, arc table, histogram
+ * geometry and theoretical distribution once, then restarts the run
+ * (galton_reset()). Nothing is recomputed per frame afterwards.
+ *
+ * @return GALTON_GEOMETRY_OK, or a negative error code (board unchanged)
+ */
+int galton_set_geometry(galton_sim_t *sim, uint8_t rows, uint8_t spacing);
+
+/**
+ * @brief Changes the bias and rebuilds the theoretical distribution
+ * @param bias 0 (always left) to 10 (always right); larger values give 10
+ */
+void galton_set_bias(galton_sim_t *sim, uint8_t bias);
+
+/**
+ * @brief Updates the histogram markers with the expected (theoretical) bar heights
+ * @note Call once per displayed frame, before histogram_draw()
+ */
+void galton_update_theory_overlay(galton_sim_t *sim);
+
+/**
+ * @brief Sets how many base steps each galton_update() advances
+ * @note Physics constants stay expressed per base step; only the step length changes
+ */
+void galton_set_step_scale(galton_sim_t *sim, uint8_t scale);
+
+/**
+ * @brief Selects the pin collision test of the physics mode
+ */
+void galton_set_collision(galton_sim_t *sim, galton_collision_t collision);
+
+/**
+ * @brief Switches the update mode
+ * @note Balls in flight are removed, since each mode stores them differently
+ */
+void galton_set_mode(galton_sim_t *sim, galton_mode_t mode);
+
+/**
+ * @brief Clears the histogram and removes every ball in flight
+ */
+void galton_reset(galton_sim_t *sim);
+
+/**
+ * @brief Releases up to n new balls at the top of the board
+ * @return Number of balls actually released (limited by the pool capacity)
+ */
+int galton_spawn(galton_sim_t *sim, int n);
+
+/**
+ * @brief Releases sim->balls_per_cycle balls
+ */
+int galton_release_cycle(galton_sim_t *sim);
+
+/**
+ * @brief Advances the physics by step_scale base steps
+ */
+void galton_update(galton_sim_t *sim);
+
+/**
+ * @brief One frame of a run: releases a cycle every FRAMES_PER_CYCLE base steps, then updates
+ * @note Live loop and replayer both step through here, so they stay in lockstep
+ */
+void galton_frame(galton_sim_t *sim);
+
+/**
+ * @brief Button A action: cycles the balls per cycle through 1..MAX_BALLS_PER_CYCLE
+ */
+void galton_button_a(galton_sim_t *sim);
+
+/**
+ * @brief Button B action: cycles the bias through 0..10
+ */
+void galton_button_b(galton_sim_t *sim);
+
+/**
+ * @brief Pixel position of a live ball, whatever the update mode
+ */
+static inline void galton_ball_pixel(const galton_sim_t *sim, uint16_t idx, int *x, int *y) {
+    const ball_pool_t *pool = &sim->balls;
+    if (sim->mode == GALTON_MODE_TRAJECTORY) {
+        int frame = pool->vy[idx];
+        *x = FROM_FIXED(pool->x[idx]) + pool->vx[idx] * sim->arc.dx[frame];
+        *y = FROM_FIXED(pool->y[idx]) + sim->arc.dy[frame];
+    } else {
+        *x = FROM_FIXED(pool->x[idx]);
+        *y = FROM_FIXED(pool->y[idx]);
+    }
+}
+
+/**
+ * @brief Biased left/right decision taken at each pin
+ * @param rng xorshift32 state, advanced by one step
+ * @param bias 0 (always left) to 10 (always right)
+ * @return true for a right bounce
+ */
+bool random_decision_with_bias(uint32_t *rng, uint8_t bias);
+
+#ifdef __cplusplus
+}
+#endif
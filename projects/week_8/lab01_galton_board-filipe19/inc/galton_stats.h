@@ -0,0 +1,100 @@
+// Embarcatech, May 2025 - "Digital Galton Board" online statistics
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Running statistics of the bin distribution, compared with the
+    theoretical Binomial(N, p) of the current bias.
+
+    Key Features:
+    - O(1) integer update per ball (power sums of the bin index)
+    - Theoretical probabilities kept as a Q16 table, rebuilt only when
+      the bias changes
+    - Chi-square distance maintained incrementally from sum(O^2 / p)
+    - Mean, variance, skewness and chi-square derived on demand (once
+      per displayed frame, not per ball)
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include "galton_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STATS_Q16_ONE 65536u      // 1.0 in Q16
+#define STATS_INV_P_SHIFT 16      // Fractional bits of the 1/p table
+
+/**
+ * @brief Accumulators and theoretical tables
+ */
+typedef struct {
+    uint32_t n;                          // Balls counted
+    uint64_t sum1;                       // sum(k)
+    uint64_t sum2;                       // sum(k^2)
+    uint64_t sum3;                       // sum(k^3)
+    uint64_t sum_o2_inv_p;               // sum over bins of O_k^2 / p_k (Q16, saturating)
+    uint32_t theory_q16[MAX_BINS];       // Binomial probabilities p_k (Q16)
+    uint32_t inv_theory[MAX_BINS];       // 1 / p_k (Q16, saturated for p_k < 2^-16)
+    uint8_t rows;                        // Number of trials N (bins = N + 1)
+    uint8_t bias;                        // Bias the tables were built for
+} galton_stats_t;
+
+/**
+ * @brief Values derived from the accumulators
+ */
+typedef struct {
+    float mean;              // Mean bin index
+    float variance;          // Variance of the bin index
+    float skewness;          // Skewness (0 for a symmetric distribution)
+    float chi_square;        // Chi-square distance to Binomial(N, p)
+    float theory_mean;       // N * p
+    float theory_variance;   // N * p * (1 - p)
+} galton_stats_summary_t;
+
+/**
+ * @brief Clears the accumulators and builds the tables for a board and a bias
+ * @param rows Pin rows of the board (MAX_ROWS at most)
+ */
+void galton_stats_init(galton_stats_t *st, uint8_t rows, uint8_t bias);
+
+/**
+ * @brief Rebuilds the theoretical tables for a new bias
+ *
+ * @param counts Current bin counts, used to recompute the chi-square sum once
+ */
+void galton_stats_set_bias(galton_stats_t *st, uint8_t bias, const uint32_t *counts);
+
+/**
+ * @brief Accounts for one ball (O(1))
+ *
+ * @param bin Bin the ball landed in
+ * @param count Count of that bin after the ball was added
+ */
+void galton_stats_add(galton_stats_t *st, uint8_t bin, uint32_t count);
+
+/**
+ * @brief Derives mean, variance, skewness and chi-square
+ */
+void galton_stats_summary(const galton_stats_t *st, galton_stats_summary_t *out);
+
+/**
+ * @brief Expected bar height for a bin, with the histogram's normalization
+ *
+ * @param max_count Largest observed count (histogram maximum)
+ * @param max_height Bar height that max_count maps to
+ */
+uint8_t galton_stats_expected_height(const galton_stats_t *st, uint8_t bin,
+                                     uint32_t max_count, uint8_t max_height);
+
+/**
+ * @brief Probability of a right bounce for a bias setting, in percent
+ */
+static inline int galton_bias_percent(uint8_t bias) {
+    return 5 + bias * 9;  // map(bias, 0, 10, 5, 95)
+}
+
+#ifdef __cplusplus
+}
+#endif
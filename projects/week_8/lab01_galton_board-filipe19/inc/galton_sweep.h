@@ -0,0 +1,109 @@
+// Embarcatech, May 2025 - "Digital Galton Board" parameter sweep
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Headless experiment runner: drops a fixed number of balls for every
+    combination of a parameter grid and reports the outcome.
+
+    Key Features:
+    - Grid of rows x bias x ball count x update mode, enumerated by index
+      (no table of configurations in memory)
+    - Each configuration runs the normal simulation core with rendering
+      bypassed and a seed derived from its index, so results are reproducible
+    - Work split by worker (index % workers): one worker per RP2040 core on
+      the device, one per thread on the host
+    - One CSV line per configuration: histogram, moments, chi-square,
+      balls per second and wall time
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stddef.h>   // size_t
+#include "galton_simulation.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GALTON_SWEEP_SPAWN_PER_STEP 16   // Balls released per step while a run is feeding the board
+#define GALTON_SWEEP_CSV_LINE 160        // Buffer size that fits any CSV line
+
+/**
+ * @brief Values swept; the grid is their Cartesian product
+ */
+typedef struct {
+    const uint8_t *rows;     // Pin rows (MIN_ROWS..MAX_ROWS)
+    uint8_t num_rows;
+    const uint8_t *bias;     // Bias settings (0..10)
+    uint8_t num_bias;
+    const uint32_t *balls;   // Balls dropped per run
+    uint8_t num_balls;
+    const uint8_t *modes;    // galton_mode_t values
+    uint8_t num_modes;
+} galton_sweep_grid_t;
+
+/**
+ * @brief One point of the grid
+ */
+typedef struct {
+    uint8_t rows;
+    uint8_t spacing;         // Largest spacing (<= DEFAULT_PIN_SPACING) that fits the display
+    uint8_t bias;
+    uint8_t mode;
+    uint32_t balls;
+} galton_sweep_config_t;
+
+/**
+ * @brief Outcome of one configuration
+ */
+typedef struct {
+    galton_sweep_config_t config;
+    uint32_t counts[MAX_BINS];       // Final histogram
+    galton_stats_summary_t summary;  // Moments and chi-square
+    uint32_t steps;                  // Simulation steps until the last ball landed
+    uint32_t wall_us;                // Wall time of the run
+    int status;                      // GALTON_GEOMETRY_OK, or why the run was skipped
+} galton_sweep_result_t;
+
+/**
+ * @brief Number of configurations in the grid
+ */
+uint32_t galton_sweep_count(const galton_sweep_grid_t *grid);
+
+/**
+ * @brief Decodes configuration `index` (rows vary slowest, mode fastest)
+ */
+void galton_sweep_config(const galton_sweep_grid_t *grid, uint32_t index, galton_sweep_config_t *config);
+
+/**
+ * @brief Runs one configuration headlessly
+ *
+ * @param sim Scratch simulation (one per worker)
+ * @param now_us Microsecond clock for the wall time
+ */
+void galton_sweep_run(const galton_sweep_config_t *config, uint32_t seed, galton_sim_t *sim,
+                      galton_sweep_result_t *result, uint32_t (*now_us)(void));
+
+/**
+ * @brief Runs every configuration whose index % workers == worker
+ *
+ * @param results Array of galton_sweep_count() entries, filled at the configuration's index
+ */
+void galton_sweep_worker(const galton_sweep_grid_t *grid, uint32_t worker, uint32_t workers,
+                         galton_sim_t *sim, galton_sweep_result_t *results, uint32_t (*now_us)(void));
+
+/**
+ * @brief Column names matching galton_sweep_csv()
+ */
+const char *galton_sweep_csv_header(void);
+
+/**
+ * @brief Formats a result as one CSV line (histogram counts separated by ';')
+ * @return Characters written, as snprintf()
+ */
+int galton_sweep_csv(const galton_sweep_result_t *result, char *line, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,51 @@
+// Embarcatech, May 2025 - "Digital Galton Board" trajectory tables
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Precomputed bounce arcs for the trajectory mode of the simulation.
+
+    Between two rows every ball follows the same arc, mirrored for a left
+    bounce, because the bounce speed only depends on gravity, bounciness
+    and the pin spacing. The arc is integrated once with the same fixed-point
+    physics as galton_update() and stored as per-frame pixel offsets from
+    the pin the ball left. Animating a ball is then a table lookup.
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include "galton_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRAJECTORY_MAX_FRAMES 64  // Longest arc stored (slow gravity, high bounciness)
+
+/**
+ * @brief Arc of a right bounce, frame by frame
+ *
+ * @note Frame 0 is the bounce itself; after `length` frames the ball sits
+ *       on the next row, half a spacing to the side. A left bounce uses -dx.
+ */
+typedef struct {
+    int8_t dx[TRAJECTORY_MAX_FRAMES];  // Horizontal offset from the anchor pin (pixels)
+    int8_t dy[TRAJECTORY_MAX_FRAMES];  // Vertical offset from the anchor pin (pixels)
+    uint8_t length;                    // Frames from one row to the next
+} trajectory_table_t;
+
+/**
+ * @brief Integrates the bounce arc and fills the table
+ *
+ * @param table Table to fill
+ * @param gravity Gravity (Q9.7 pixels/frame^2)
+ * @param bounce_vx Horizontal speed after a bounce (Q9.7)
+ * @param bounce_vy Upward speed after a bounce (Q9.7)
+ * @param spacing Pin spacing (pixels)
+ */
+void trajectory_build(trajectory_table_t *table, int16_t gravity, int16_t bounce_vx, int16_t bounce_vy,
+                      uint8_t spacing);
+
+#ifdef __cplusplus
+}
+#endif
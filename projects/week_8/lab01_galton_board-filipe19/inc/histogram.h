@@ -0,0 +1,109 @@
+// Embarcatech, May 2025 - Incremental bar-chart histogram
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Auto-normalized histogram that redraws only what changed.
+
+    Key Features:
+    - Maximum count tracked incrementally (no rescan of the bins)
+    - Last drawn pixel height kept per bar; each draw only touches the
+      rows between the old and the new height
+    - Writes straight into an SSD1306 page-format buffer (128 x 8 pages)
+    - Optional per-bar marker line (XOR-drawn), e.g. a theoretical curve
+    - Draw cost (bars and bytes touched) exposed for profiling
+    - Not tied to the Galton board: any bar-chart display can use it
+
+    The histogram owns its screen area: nothing else may draw over the
+    bars between two calls to histogram_draw(), otherwise call
+    histogram_invalidate() so every bar is redrawn.
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool type
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HISTOGRAM_MAX_BINS 32  // One dirty bit per bin in a 32-bit mask
+
+/**
+ * @brief Histogram counts plus the drawing state of its bars
+ */
+typedef struct {
+    uint32_t counts[HISTOGRAM_MAX_BINS];  // Samples per bin
+    uint8_t drawn[HISTOGRAM_MAX_BINS];    // Bar height currently in the buffer (pixels)
+    uint8_t marker[HISTOGRAM_MAX_BINS];   // Requested marker height (0 = no marker)
+    uint8_t marker_drawn[HISTOGRAM_MAX_BINS]; // Marker height currently in the buffer
+    uint32_t dirty;                       // Bins whose height must be checked on the next draw
+    uint32_t max;                         // Largest count (normalization reference)
+    uint32_t total;                       // Sum of all counts
+
+    // Geometry
+    uint8_t num_bins;      // Number of bars
+    uint8_t x;             // Left edge of bin 0 (pixels)
+    uint8_t bin_width;     // Horizontal distance between bars
+    uint8_t bar_width;     // Width of each bar (<= bin_width)
+    uint8_t base_y;        // Row of the bar bases (bars grow upwards from here)
+    uint8_t max_height;    // Height of the tallest bar
+
+    // Cost of the last histogram_draw()
+    uint16_t last_bars_drawn;   // Bars whose height changed
+    uint16_t last_bytes_drawn;  // Framebuffer bytes written
+} histogram_t;
+
+/**
+ * @brief Configures the geometry and clears the counts
+ *
+ * @param num_bins Number of bars (1..HISTOGRAM_MAX_BINS)
+ * @param x Left edge of bin 0
+ * @param bin_width Horizontal distance between bars
+ * @param bar_width Width of each bar
+ * @param base_y Row of the bar bases
+ * @param max_height Height of the tallest bar
+ */
+void histogram_init(histogram_t *h, uint8_t num_bins, uint8_t x, uint8_t bin_width,
+                    uint8_t bar_width, uint8_t base_y, uint8_t max_height);
+
+/**
+ * @brief Clears the counts; the bars shrink to zero on the next draw
+ */
+void histogram_reset(histogram_t *h);
+
+/**
+ * @brief Adds one sample to a bin (O(1))
+ */
+void histogram_add(histogram_t *h, uint8_t bin);
+
+/**
+ * @brief Sets the marker line of a bar (0 removes it)
+ *
+ * @param height Marker height in pixels, clamped to max_height
+ * @note The marker is drawn with XOR so it stays visible inside the bar
+ */
+void histogram_set_marker(histogram_t *h, uint8_t bin, uint8_t height);
+
+/**
+ * @brief Forces every bar to be redrawn (after the buffer area was cleared)
+ */
+void histogram_invalidate(histogram_t *h);
+
+/**
+ * @brief Scaled height of a bin with the current normalization
+ */
+uint8_t histogram_bar_height(const histogram_t *h, uint8_t bin);
+
+/**
+ * @brief Updates the bars whose scaled height (or marker) changed
+ *
+ * @param h Histogram
+ * @param buffer SSD1306 page-format framebuffer
+ * @return Number of framebuffer bytes written (also kept in last_bytes_drawn)
+ */
+int histogram_draw(histogram_t *h, uint8_t *buffer);
+
+#ifdef __cplusplus
+}
+#endif
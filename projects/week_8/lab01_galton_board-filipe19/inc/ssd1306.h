@@ -1,4 +1,7 @@
 #include "ssd1306_i2c.h"
+#include "ssd1306_raster.h"
+#include "ssd1306_transpose.h"
+#include "ssd1306_dither.h"
 extern void calculate_render_area_buffer_length(struct render_area *area);
 extern void ssd1306_send_command(uint8_t cmd);
 extern void ssd1306_send_command_list(uint8_t *ssd, int number);
@@ -6,6 +9,7 @@ extern void ssd1306_send_buffer(uint8_t ssd[], int buffer_length);
 extern void ssd1306_init();
 extern void ssd1306_scroll(bool set);
 extern void render_on_display(uint8_t *ssd, struct render_area *area);
+extern void render_on_display_rotated(const uint8_t *portrait, ssd1306_rotation_t rotation);
 extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
 extern void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set);
 extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
@@ -0,0 +1,209 @@
+// Embarcatech, May 2025 - Compile-time SSD1306 renderer (C++17)
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    constexpr version of the SSD1306 drawing functions, for screens that
+    never change: they are rendered by the compiler into const page-format
+    arrays, which the linker places in flash.
+
+    Key Features:
+    - Pixels, lines, text (same font and placement as ssd1306_draw_string),
+      vertical spans, circles, hexagons and convex polygons
+    - Same pixels as the run-time library: the shape rules are those of
+      ssd1306_raster.c (dx^2 + dy^2 <= r^2 + r, polygon edges rounded inwards)
+    - Everything clipped to the screen; no dependency on the Pico SDK
+
+    Usage:
+        constexpr ssd1306_ce::canvas splash = [] {
+            ssd1306_ce::canvas c{};
+            c.draw_string(16, 8, "GALTON BOARD");
+            return c;
+        }();
+        // splash.bytes: 1024 bytes in flash, ready for render_on_display()
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include "ssd1306_raster.h"
+#include "ssd1306_font.h"
+
+namespace ssd1306_ce {
+
+constexpr int width = SSD1306_RASTER_WIDTH;
+constexpr int height = SSD1306_RASTER_HEIGHT;
+constexpr int bytes = width * height / 8;
+
+/**
+ * @brief Page-format framebuffer that can be drawn into at compile time
+ */
+struct canvas {
+    uint8_t bytes[ssd1306_ce::bytes] = {};
+
+    constexpr void set_pixel(int x, int y, bool set = true) {
+        if (x < 0 || x >= width || y < 0 || y >= height) {
+            return;
+        }
+        uint8_t mask = static_cast<uint8_t>(1u << (y & 7));
+        uint8_t &byte = bytes[(y >> 3) * width + x];
+        byte = set ? static_cast<uint8_t>(byte | mask) : static_cast<uint8_t>(byte & ~mask);
+    }
+
+    // Bresenham, as ssd1306_draw_line()
+    constexpr void draw_line(int x0, int y0, int x1, int y1, bool set = true) {
+        int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+        int dy = y1 > y0 ? y0 - y1 : y1 - y0;
+        int sx = x0 < x1 ? 1 : -1;
+        int sy = y0 < y1 ? 1 : -1;
+        int error = dx + dy;
+        while (true) {
+            set_pixel(x0, y0, set);
+            if (x0 == x1 && y0 == y1) {
+                break;
+            }
+            int error_2 = 2 * error;
+            if (error_2 >= dy) {
+                error += dy;
+                x0 += sx;
+            }
+            if (error_2 <= dx) {
+                error += dx;
+                y0 += sy;
+            }
+        }
+    }
+
+    constexpr void fill_vspan(int x, int y0, int y1, bool set = true) {
+        for (int y = y0 < y1 ? y0 : y1; y <= (y0 < y1 ? y1 : y0); y++) {
+            set_pixel(x, y, set);
+        }
+    }
+
+    // Glyph index, as ssd1306_get_font() (letters, digits, blank for the rest)
+    static constexpr int glyph(char c) {
+        if (c >= 'a' && c <= 'z') {
+            c = static_cast<char>(c - 'a' + 'A');
+        }
+        if (c >= 'A' && c <= 'Z') {
+            return c - 'A' + 1;
+        }
+        if (c >= '0' && c <= '9') {
+            return c - '0' + 27;
+        }
+        return 0;
+    }
+
+    // Same placement as ssd1306_draw_char(): y is rounded down to its page
+    constexpr void draw_char(int x, int y, char c) {
+        if (x < 0 || y < 0 || x > width - 8 || y > height - 8) {
+            return;
+        }
+        int index = glyph(c) * 8;
+        for (int i = 0; i < 8; i++) {
+            bytes[(y / 8) * width + x + i] = font[index + i];
+        }
+    }
+
+    constexpr void draw_string(int x, int y, const char *text) {
+        for (; *text && x <= width - 8; text++, x += 8) {
+            draw_char(x, y, *text);
+        }
+    }
+
+    constexpr void fill_circle(int cx, int cy, int r, bool set = true) {
+        for (int dx = -r; dx <= r; dx++) {
+            int limit = r * r + r - dx * dx;
+            int dy = r;
+            while (dy > 0 && dy * dy > limit) {
+                dy--;
+            }
+            fill_vspan(cx + dx, cy - dy, cy + dy, set);
+        }
+    }
+
+    constexpr void draw_circle(int cx, int cy, int r, bool set = true) {
+        int x = r;
+        int y = 0;
+        int error = 1 - r;
+        while (x >= y) {
+            set_pixel(cx + x, cy + y, set);
+            set_pixel(cx - x, cy + y, set);
+            set_pixel(cx + x, cy - y, set);
+            set_pixel(cx - x, cy - y, set);
+            set_pixel(cx + y, cy + x, set);
+            set_pixel(cx - y, cy + x, set);
+            set_pixel(cx + y, cy - x, set);
+            set_pixel(cx - y, cy - x, set);
+            y++;
+            if (error < 0) {
+                error += 2 * y + 1;
+            } else {
+                x--;
+                error += 2 * (y - x) + 1;
+            }
+        }
+    }
+
+    // Convex polygon, one vertical span per column (xy = x0, y0, x1, y1, ...)
+    constexpr void fill_polygon(const int16_t *xy, int n, bool set = true) {
+        int left = xy[0];
+        int right = xy[0];
+        for (int i = 1; i < n; i++) {
+            left = xy[2 * i] < left ? xy[2 * i] : left;
+            right = xy[2 * i] > right ? xy[2 * i] : right;
+        }
+        for (int x = left; x <= right; x++) {
+            int top = 0x7FFF;
+            int bottom = -0x7FFF;
+            for (int i = 0; i < n; i++) {
+                int j = (i + 1) % n;
+                int ax = xy[2 * i], ay = xy[2 * i + 1], bx = xy[2 * j], by = xy[2 * j + 1];
+                if (ax > bx) {
+                    int t = ax; ax = bx; bx = t;
+                    t = ay; ay = by; by = t;
+                }
+                if (x < ax || x > bx) {
+                    continue;
+                }
+                int y0 = ay < by ? ay : by;
+                int y1 = ay < by ? by : ay;
+                if (ax != bx) {
+                    // Rounded up as a top, down as a bottom
+                    int num = (by - ay) * (x - ax);
+                    int den = bx - ax;
+                    y1 = ay + (num >= 0 ? num / den : -((-num + den - 1) / den));
+                    y0 = ay + (num >= 0 ? (num + den - 1) / den : -(-num / den));
+                }
+                top = y0 < top ? y0 : top;
+                bottom = y1 > bottom ? y1 : bottom;
+            }
+            if (top <= bottom) {
+                fill_vspan(x, top, bottom, set);
+            }
+        }
+    }
+
+    constexpr void draw_polygon(const int16_t *xy, int n, bool set = true) {
+        for (int i = 0; i < n; i++) {
+            int j = (i + 1) % n;
+            draw_line(xy[2 * i], xy[2 * i + 1], xy[2 * j], xy[2 * j + 1], set);
+        }
+    }
+
+    // Pointy-top hexagon of circumradius r, as ssd1306_fill_hexagon()
+    constexpr void fill_hexagon(int cx, int cy, int r, bool set = true) {
+        int w = (r * 222 + 128) >> 8;
+        int h = r >> 1;
+        const int16_t xy[12] = {
+            static_cast<int16_t>(cx), static_cast<int16_t>(cy - r),
+            static_cast<int16_t>(cx + w), static_cast<int16_t>(cy - h),
+            static_cast<int16_t>(cx + w), static_cast<int16_t>(cy + h),
+            static_cast<int16_t>(cx), static_cast<int16_t>(cy + r),
+            static_cast<int16_t>(cx - w), static_cast<int16_t>(cy + h),
+            static_cast<int16_t>(cx - w), static_cast<int16_t>(cy - h)
+        };
+        fill_polygon(xy, 6, set);
+    }
+};
+
+}  // namespace ssd1306_ce
@@ -0,0 +1,94 @@
+// Embarcatech, May 2025 - SSD1306 streaming dither
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Floyd-Steinberg with one row of error: at column x the error of row y
+    is read from error[x] and that slot is free again, so the shares for
+    row y + 1 go into the same array. Slots x and x + 1 are still unread,
+    so their shares (5/16 and 1/16) wait in two locals; the 3/16 share
+    completes slot x - 1, which is stored.
+    ======================================================================== */
+
+#include <string.h>   // memset()
+#include "ssd1306_dither.h"
+
+#define LEVEL_SHIFT 4                        // Error in 1/16 gray levels
+#define THRESHOLD (128 << LEVEL_SHIFT)
+#define WHITE (255 << LEVEL_SHIFT)
+
+// 8x8 Bayer matrix, index * 4 + 2: level 0 lights nothing, level 255 lights everything
+static const uint8_t bayer[8][8] = {
+    {   2, 130,  34, 162,  10, 138,  42, 170 },
+    { 194,  66, 226,  98, 202,  74, 234, 106 },
+    {  50, 178,  18, 146,  58, 186,  26, 154 },
+    { 242, 114, 210,  82, 250, 122, 218,  90 },
+    {  14, 142,  46, 174,   6, 134,  38, 166 },
+    { 206,  78, 238, 110, 198,  70, 230, 102 },
+    {  62, 190,  30, 158,  54, 182,  22, 150 },
+    { 254, 126, 222,  94, 246, 118, 214,  86 }
+};
+
+int ssd1306_dither_init(ssd1306_dither_t *dither, uint8_t *pages, int width, int height,
+                        ssd1306_dither_mode_t mode) {
+    if (width < 1 || width > SSD1306_DITHER_MAX_WIDTH || height < 1 || height > 0x7FFF) {
+        return SSD1306_DITHER_BAD_SIZE;
+    }
+    dither->pages = pages;
+    dither->width = (int16_t)width;
+    dither->height = (int16_t)height;
+    dither->y = 0;
+    dither->mode = mode;
+    memset(dither->error, 0, sizeof(dither->error));
+    return SSD1306_DITHER_OK;
+}
+
+// Ordered: the threshold row repeats every 8 columns
+static void bayer_row(uint8_t *out, const uint8_t *gray, int width, int y, uint8_t bit) {
+    const uint8_t *threshold = bayer[y & 7];
+    if (bit == 1) {
+        for (int x = 0; x < width; x++) {
+            out[x] = gray[x] > threshold[x & 7];
+        }
+        return;
+    }
+    for (int x = 0; x < width; x++) {
+        out[x] |= gray[x] > threshold[x & 7] ? bit : 0;
+    }
+}
+
+static void floyd_row(uint8_t *out, const uint8_t *gray, int width, int16_t *error, uint8_t bit) {
+    int16_t *below = error + 1;    // below[x]: error of this row in, next row out
+    int right = 0;                 // 7/16 share for x + 1 on this row
+    int pending = 0;               // Next row, column x - 1 (5/16 from x - 1, 1/16 from x - 2)
+    int pending_next = 0;          // Next row, column x (1/16 from x - 1)
+    uint8_t keep = bit == 1 ? 0 : 0xFF;
+
+    for (int x = 0; x < width; x++) {
+        int value = (gray[x] << LEVEL_SHIFT) + below[x] + right;
+        int lit = value >= THRESHOLD;
+        int e = lit ? value - WHITE : value;
+        out[x] = (uint8_t)((out[x] & keep) | (lit ? bit : 0));
+
+        right = (e * 7) >> 4;
+        below[x - 1] = (int16_t)(pending + ((e * 3) >> 4));   // x - 1 is complete (below[-1] is the pad)
+        pending = pending_next + ((e * 5) >> 4);
+        pending_next = e >> 4;
+    }
+    below[width - 1] = (int16_t)pending;
+}
+
+int ssd1306_dither_row(ssd1306_dither_t *dither, const uint8_t *gray) {
+    if (dither->y >= dither->height) {
+        return SSD1306_DITHER_FULL;
+    }
+    int y = dither->y++;
+    uint8_t *out = &dither->pages[(y >> 3) * dither->width];
+    uint8_t bit = (uint8_t)(1u << (y & 7));
+
+    if (dither->mode == SSD1306_DITHER_BAYER) {
+        bayer_row(out, gray, dither->width, y, bit);
+    } else {
+        floyd_row(out, gray, dither->width, dither->error, bit);
+    }
+    return SSD1306_DITHER_OK;
+}
@@ -0,0 +1,83 @@
+// Embarcatech, May 2025 - SSD1306 streaming dither
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Turns 8-bit grayscale data (sensor heatmaps, images) into the 1-bpp
+    page format of the SSD1306, one row at a time: the grayscale frame
+    never has to be held in RAM.
+
+    Key Features:
+    - Ordered mode: 8x8 Bayer threshold matrix, one compare per pixel,
+      no state between rows
+    - Error-diffusion mode: Floyd-Steinberg in 1/16 gray-level fixed
+      point, with a single row of error (2 bytes per column)
+    - Output in the page format used by ssd1306_draw_bitmap(): row y sets
+      bit y % 8 of page y / 8, so 8 rows complete one page
+    - No hardware dependency: usable and testable on the host
+
+    Usage:
+        ssd1306_dither_t d;
+        ssd1306_dither_init(&d, frame, 128, 64, SSD1306_DITHER_FLOYD);
+        for (int y = 0; y < 64; y++) {
+            ssd1306_dither_row(&d, gray_row(y));  // 128 bytes, 0 = black
+        }
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_DITHER_MAX_WIDTH 128   // Widest row (the panel width)
+
+// Return codes
+#define SSD1306_DITHER_OK 0
+#define SSD1306_DITHER_BAD_SIZE -1     // Width or height out of range
+#define SSD1306_DITHER_FULL -2         // Every row of the image was already written
+
+/**
+ * @brief Dithering method
+ */
+typedef enum {
+    SSD1306_DITHER_BAYER,    // Ordered, fastest; regular cross-hatch pattern
+    SSD1306_DITHER_FLOYD     // Error diffusion; smoother gradients, serial per row
+} ssd1306_dither_mode_t;
+
+/**
+ * @brief Streaming dither state (one image)
+ */
+typedef struct {
+    uint8_t *pages;                // Output, width bytes per page
+    int16_t width;
+    int16_t height;
+    int16_t y;                     // Next row to be written
+    ssd1306_dither_mode_t mode;
+    int16_t error[SSD1306_DITHER_MAX_WIDTH + 1];  // Error pushed down to row y, 1/16 levels (entry 0 is a pad)
+} ssd1306_dither_t;
+
+/**
+ * @brief Starts an image of width x height pixels at pages
+ *
+ * @param pages Output, width bytes per page, (height + 7) / 8 pages
+ *              (a 128 x 64 image is the full-screen framebuffer)
+ * @return SSD1306_DITHER_OK or SSD1306_DITHER_BAD_SIZE
+ */
+int ssd1306_dither_init(ssd1306_dither_t *dither, uint8_t *pages, int width, int height,
+                        ssd1306_dither_mode_t mode);
+
+/**
+ * @brief Dithers the next grayscale row (width bytes, 0 = off, 255 = lit)
+ *
+ * The first row of each page overwrites its bytes, so the output does not
+ * need to be cleared first.
+ *
+ * @return SSD1306_DITHER_OK or SSD1306_DITHER_FULL
+ */
+int ssd1306_dither_row(ssd1306_dither_t *dither, const uint8_t *gray);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,10 @@
 
-static uint8_t font[] = {
+// constexpr in C++, so compile-time renderers (ssd1306_constexpr.hpp) can read the glyphs
+#ifdef __cplusplus
+static constexpr uint8_t font[] = {
+#else
+static const uint8_t font[] = {
+#endif
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Nothing
     0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, // A
     0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, // B
@@ -7,6 +7,7 @@
 #include "hardware/i2c.h"
 #include "ssd1306_font.h"
 #include "ssd1306_i2c.h"
+#include "ssd1306_transpose.h"
 
 // Calcular quanto do buffer será destinado à área de renderização
 void calculate_render_area_buffer_length(struct render_area *area) {
@@ -85,6 +86,21 @@ void render_on_display(uint8_t *ssd, struct render_area *area) {
     ssd1306_send_buffer(ssd, area->buffer_length);
 }
 
+// Envia um quadro retrato (64 x 128, 16 páginas de 64 bytes) para o display montado de lado
+void render_on_display_rotated(const uint8_t *portrait, ssd1306_rotation_t rotation) {
+    static uint8_t panel[ssd1306_buffer_length];
+    struct render_area area = {
+        .start_column = 0,
+        .end_column = ssd1306_width - 1,
+        .start_page = 0,
+        .end_page = ssd1306_n_pages - 1
+    };
+
+    ssd1306_rotate_frame(panel, portrait, rotation); // Blocos 8x8 transpostos, sem laço por pixel
+    calculate_render_area_buffer_length(&area);
+    render_on_display(panel, &area);
+}
+
 // Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
 void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
     assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
@@ -0,0 +1,367 @@
+// Embarcatech, May 2025 - SSD1306 shape rasterizer
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Every filled shape is described by its extent in each column (top and
+    bottom row), computed with integers only:
+    - circle: largest dy with dx^2 + dy^2 <= r^2 + r (rounder than r^2
+      for small radii)
+    - convex polygon: highest and lowest edge crossing of the column,
+      rounded inwards, so mirrored shapes stay symmetric
+    The same extents feed the framebuffer (one vertical span per column)
+    and the sprite builder (one column byte per column).
+    ======================================================================== */
+
+#include "ssd1306_raster.h"
+
+#define PAGE_OFFSET(x, y) (((y) >> 3) * SSD1306_RASTER_WIDTH + (x))
+
+// Sets or clears the `mask` bits of one framebuffer byte
+static inline void write_bits(uint8_t *byte, uint8_t mask, bool set) {
+    *byte = set ? (uint8_t)(*byte | mask) : (uint8_t)(*byte & ~mask);
+}
+
+// One clipped pixel, shifts only
+static inline void plot(uint8_t *ssd, int x, int y, bool set) {
+    if ((unsigned)x < SSD1306_RASTER_WIDTH && (unsigned)y < SSD1306_RASTER_HEIGHT) {
+        write_bits(&ssd[PAGE_OFFSET(x, y)], (uint8_t)(1u << (y & 7)), set);
+    }
+}
+
+void ssd1306_fill_vspan(uint8_t *ssd, int x, int y0, int y1, bool set) {
+    if (y0 > y1) {
+        int t = y0;
+        y0 = y1;
+        y1 = t;
+    }
+    if ((unsigned)x >= SSD1306_RASTER_WIDTH || y1 < 0 || y0 >= SSD1306_RASTER_HEIGHT) {
+        return;
+    }
+    if (y0 < 0) {
+        y0 = 0;
+    }
+    if (y1 >= SSD1306_RASTER_HEIGHT) {
+        y1 = SSD1306_RASTER_HEIGHT - 1;
+    }
+
+    int first = y0 >> 3;
+    int last = y1 >> 3;
+    uint8_t top_mask = (uint8_t)(0xFFu << (y0 & 7));
+    uint8_t bottom_mask = (uint8_t)(0xFFu >> (7 - (y1 & 7)));
+    uint8_t *byte = &ssd[first * SSD1306_RASTER_WIDTH + x];
+
+    if (first == last) {
+        write_bits(byte, top_mask & bottom_mask, set);
+        return;
+    }
+    write_bits(byte, top_mask, set);
+    for (int page = first + 1; page < last; page++) {
+        byte += SSD1306_RASTER_WIDTH;
+        *byte = set ? 0xFF : 0x00;  // Whole byte
+    }
+    write_bits(byte + SSD1306_RASTER_WIDTH, bottom_mask, set);
+}
+
+void ssd1306_fill_hspan(uint8_t *ssd, int x0, int x1, int y, bool set) {
+    if (x0 > x1) {
+        int t = x0;
+        x0 = x1;
+        x1 = t;
+    }
+    if ((unsigned)y >= SSD1306_RASTER_HEIGHT || x1 < 0 || x0 >= SSD1306_RASTER_WIDTH) {
+        return;
+    }
+    if (x0 < 0) {
+        x0 = 0;
+    }
+    if (x1 >= SSD1306_RASTER_WIDTH) {
+        x1 = SSD1306_RASTER_WIDTH - 1;
+    }
+    uint8_t mask = (uint8_t)(1u << (y & 7));
+    uint8_t *byte = &ssd[PAGE_OFFSET(x0, y)];
+    for (int x = x0; x <= x1; x++) {
+        write_bits(byte++, mask, set);
+    }
+}
+
+// === CIRCLES ===
+
+// Half-height of a filled circle in column dx (dx^2 + dy^2 <= r^2 + r)
+static int circle_extent(int r, int dx) {
+    int limit = r * r + r - dx * dx;
+    int dy = r;
+    while (dy > 0 && dy * dy > limit) {
+        dy--;
+    }
+    return dy;
+}
+
+void ssd1306_fill_circle(uint8_t *ssd, int cx, int cy, int r, bool set) {
+    for (int dx = -r; dx <= r; dx++) {
+        int dy = circle_extent(r, dx < 0 ? -dx : dx);
+        ssd1306_fill_vspan(ssd, cx + dx, cy - dy, cy + dy, set);
+    }
+}
+
+void ssd1306_draw_circle(uint8_t *ssd, int cx, int cy, int r, bool set) {
+    // Midpoint algorithm, one octant mirrored eight times
+    int x = r;
+    int y = 0;
+    int error = 1 - r;
+    while (x >= y) {
+        plot(ssd, cx + x, cy + y, set);
+        plot(ssd, cx - x, cy + y, set);
+        plot(ssd, cx + x, cy - y, set);
+        plot(ssd, cx - x, cy - y, set);
+        plot(ssd, cx + y, cy + x, set);
+        plot(ssd, cx - y, cy + x, set);
+        plot(ssd, cx + y, cy - x, set);
+        plot(ssd, cx - y, cy - x, set);
+        y++;
+        if (error < 0) {
+            error += 2 * y + 1;
+        } else {
+            x--;
+            error += 2 * (y - x) + 1;
+        }
+    }
+}
+
+// === POLYGONS ===
+
+// Floor division for a positive divisor
+static int floor_div(int num, int den) {
+    return num >= 0 ? num / den : -((-num + den - 1) / den);
+}
+
+// Rows covered by a convex polygon in column x; false when the column misses it
+static bool polygon_extent(const int16_t *xy, int n, int x, int *top, int *bottom) {
+    int lo = 0x7FFF;
+    int hi = -0x7FFF;
+    for (int i = 0; i < n; i++) {
+        int ax = xy[2 * i], ay = xy[2 * i + 1];
+        int j = (i + 1) % n;
+        int bx = xy[2 * j], by = xy[2 * j + 1];
+        if (ax > bx) {
+            int t = ax; ax = bx; bx = t;
+            t = ay; ay = by; by = t;
+        }
+        if (x < ax || x > bx) {
+            continue;
+        }
+        int y0, y1;
+        if (ax == bx) {
+            y0 = ay < by ? ay : by;
+            y1 = ay < by ? by : ay;
+        } else {
+            // Rows inside the edge at column x: rounded up as a top, down as a bottom
+            int num = (by - ay) * (x - ax);
+            y1 = ay + floor_div(num, bx - ax);
+            y0 = ay - floor_div(-num, bx - ax);
+        }
+        if (y0 < lo) {
+            lo = y0;
+        }
+        if (y1 > hi) {
+            hi = y1;
+        }
+    }
+    *top = lo;
+    *bottom = hi;
+    return lo <= hi;
+}
+
+// Column range of a vertex list
+static void polygon_columns(const int16_t *xy, int n, int *left, int *right) {
+    *left = *right = xy[0];
+    for (int i = 1; i < n; i++) {
+        if (xy[2 * i] < *left) {
+            *left = xy[2 * i];
+        }
+        if (xy[2 * i] > *right) {
+            *right = xy[2 * i];
+        }
+    }
+}
+
+void ssd1306_fill_polygon(uint8_t *ssd, const int16_t *xy, int n, bool set) {
+    if (n < 1 || n > SSD1306_POLYGON_MAX_VERTICES) {
+        return;
+    }
+    int left, right;
+    polygon_columns(xy, n, &left, &right);
+    if (left < 0) {
+        left = 0;
+    }
+    if (right >= SSD1306_RASTER_WIDTH) {
+        right = SSD1306_RASTER_WIDTH - 1;
+    }
+    for (int x = left; x <= right; x++) {
+        int top, bottom;
+        if (polygon_extent(xy, n, x, &top, &bottom)) {
+            ssd1306_fill_vspan(ssd, x, top, bottom, set);
+        }
+    }
+}
+
+// Bresenham line through the clipped plot()
+static void draw_segment(uint8_t *ssd, int x0, int y0, int x1, int y1, bool set) {
+    int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    int dy = y1 > y0 ? y0 - y1 : y1 - y0;
+    int sx = x0 < x1 ? 1 : -1;
+    int sy = y0 < y1 ? 1 : -1;
+    int error = dx + dy;
+    while (true) {
+        plot(ssd, x0, y0, set);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int error_2 = 2 * error;
+        if (error_2 >= dy) {
+            error += dy;
+            x0 += sx;
+        }
+        if (error_2 <= dx) {
+            error += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void ssd1306_draw_polygon(uint8_t *ssd, const int16_t *xy, int n, bool set) {
+    for (int i = 0; i < n; i++) {
+        int j = (i + 1) % n;
+        draw_segment(ssd, xy[2 * i], xy[2 * i + 1], xy[2 * j], xy[2 * j + 1], set);
+    }
+}
+
+// Vertices of a pointy-top hexagon (half-width r * sqrt(3)/2, shoulders at r/2)
+static void hexagon_vertices(int16_t *xy, int cx, int cy, int r) {
+    int w = (r * 222 + 128) >> 8;
+    int h = r >> 1;
+    const int16_t v[12] = {
+        (int16_t)cx, (int16_t)(cy - r), (int16_t)(cx + w), (int16_t)(cy - h),
+        (int16_t)(cx + w), (int16_t)(cy + h), (int16_t)cx, (int16_t)(cy + r),
+        (int16_t)(cx - w), (int16_t)(cy + h), (int16_t)(cx - w), (int16_t)(cy - h)
+    };
+    for (int i = 0; i < 12; i++) {
+        xy[i] = v[i];
+    }
+}
+
+void ssd1306_draw_hexagon(uint8_t *ssd, int cx, int cy, int r, bool set) {
+    int16_t xy[12];
+    hexagon_vertices(xy, cx, cy, r);
+    ssd1306_draw_polygon(ssd, xy, 6, set);
+}
+
+void ssd1306_fill_hexagon(uint8_t *ssd, int cx, int cy, int r, bool set) {
+    int16_t xy[12];
+    hexagon_vertices(xy, cx, cy, r);
+    ssd1306_fill_polygon(ssd, xy, 6, set);
+}
+
+// === SPRITES ===
+
+// Fills the 8 shifted copies from the unshifted column bytes
+static void sprite_shift(ssd1306_sprite_t *sprite, const uint8_t *columns) {
+    for (int s = 0; s < 8; s++) {
+        for (int c = 0; c < SSD1306_SPRITE_MAX_SIZE; c++) {
+            uint16_t bits = c < sprite->width ? (uint16_t)(columns[c] << s) : 0;
+            sprite->shifted[s][0][c] = (uint8_t)bits;
+            sprite->shifted[s][1][c] = (uint8_t)(bits >> 8);
+        }
+    }
+}
+
+// Column bits of a shape given by its extent in each column
+static void set_column(uint8_t *columns, const ssd1306_sprite_t *sprite, int x, int top, int bottom) {
+    for (int y = top; y <= bottom; y++) {
+        columns[x - sprite->left] |= (uint8_t)(1u << (y - sprite->top));
+    }
+}
+
+bool ssd1306_sprite_circle(ssd1306_sprite_t *sprite, int r) {
+    if (r < 0 || 2 * r + 1 > SSD1306_SPRITE_MAX_SIZE) {
+        return false;
+    }
+    uint8_t columns[SSD1306_SPRITE_MAX_SIZE] = { 0 };
+    sprite->width = sprite->height = (uint8_t)(2 * r + 1);
+    sprite->left = sprite->top = (int8_t)-r;
+    for (int dx = -r; dx <= r; dx++) {
+        int dy = circle_extent(r, dx < 0 ? -dx : dx);
+        set_column(columns, sprite, dx, -dy, dy);
+    }
+    sprite_shift(sprite, columns);
+    return true;
+}
+
+bool ssd1306_sprite_polygon(ssd1306_sprite_t *sprite, const int16_t *xy, int n) {
+    if (n < 1 || n > SSD1306_POLYGON_MAX_VERTICES) {
+        return false;
+    }
+    int left, right, top = xy[1], bottom = xy[1];
+    polygon_columns(xy, n, &left, &right);
+    for (int i = 1; i < n; i++) {
+        top = xy[2 * i + 1] < top ? xy[2 * i + 1] : top;
+        bottom = xy[2 * i + 1] > bottom ? xy[2 * i + 1] : bottom;
+    }
+    if (right - left + 1 > SSD1306_SPRITE_MAX_SIZE || bottom - top + 1 > SSD1306_SPRITE_MAX_SIZE) {
+        return false;
+    }
+
+    uint8_t columns[SSD1306_SPRITE_MAX_SIZE] = { 0 };
+    sprite->width = (uint8_t)(right - left + 1);
+    sprite->height = (uint8_t)(bottom - top + 1);
+    sprite->left = (int8_t)left;
+    sprite->top = (int8_t)top;
+    for (int x = left; x <= right; x++) {
+        int y0, y1;
+        if (polygon_extent(xy, n, x, &y0, &y1)) {
+            set_column(columns, sprite, x, y0, y1);
+        }
+    }
+    sprite_shift(sprite, columns);
+    return true;
+}
+
+bool ssd1306_sprite_hexagon(ssd1306_sprite_t *sprite, int r) {
+    int16_t xy[12];
+    hexagon_vertices(xy, 0, 0, r);
+    return ssd1306_sprite_polygon(sprite, xy, 6);
+}
+
+void ssd1306_draw_sprite(uint8_t *ssd, const ssd1306_sprite_t *sprite, int x, int y, bool set) {
+    int left = x + sprite->left;
+    int top = y + sprite->top;
+    int shift = top & 7;
+    int page = (top - shift) / 8;  // Floor, also above the screen
+    const uint8_t *upper = sprite->shifted[shift][0];
+    const uint8_t *lower = sprite->shifted[shift][1];
+    int width = sprite->width;
+
+    // Fast path: both pages on screen, no column clipping
+    if (page >= 0 && page + 1 < SSD1306_RASTER_HEIGHT / 8 && left >= 0 && left + width <= SSD1306_RASTER_WIDTH) {
+        uint8_t *row = &ssd[page * SSD1306_RASTER_WIDTH + left];
+        for (int c = 0; c < width; c++) {
+            write_bits(&row[c], upper[c], set);
+            write_bits(&row[c + SSD1306_RASTER_WIDTH], lower[c], set);
+        }
+        return;
+    }
+
+    bool upper_visible = page >= 0 && page < SSD1306_RASTER_HEIGHT / 8;
+    bool lower_visible = page + 1 >= 0 && page + 1 < SSD1306_RASTER_HEIGHT / 8;
+    for (int c = 0; c < width; c++) {
+        int column = left + c;
+        if ((unsigned)column >= SSD1306_RASTER_WIDTH) {
+            continue;
+        }
+        if (upper_visible) {
+            write_bits(&ssd[page * SSD1306_RASTER_WIDTH + column], upper[c], set);
+        }
+        if (lower_visible && lower[c]) {
+            write_bits(&ssd[(page + 1) * SSD1306_RASTER_WIDTH + column], lower[c], set);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+// Embarcatech, May 2025 - SSD1306 shape rasterizer
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Filled and outlined shapes for the SSD1306 page-format framebuffer
+    (128 x 64, one byte = 8 vertical pixels of a column).
+
+    Key Features:
+    - Filled shapes are cut into vertical spans, the axis along which the
+      page format packs pixels: a span writes one masked byte at each end
+      and whole bytes in between
+    - Circles, hexagons and convex polygons, filled or outlined
+    - Shifts and masks only (no divide, modulo or assert per pixel);
+      everything is clipped to the screen
+    - Sprites: a small shape rasterized once into 8 pre-shifted copies
+      (one per y mod 8), so stamping it costs two masked byte writes per
+      column
+    - No hardware dependency: usable and testable on the host
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool type
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_RASTER_WIDTH 128
+#define SSD1306_RASTER_HEIGHT 64
+#define SSD1306_SPRITE_MAX_SIZE 8        // Sprite width and height limit (pixels)
+#define SSD1306_POLYGON_MAX_VERTICES 16  // Vertex limit of the polygon functions
+
+/**
+ * @brief Small shape with one copy per vertical bit offset
+ */
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    int8_t left;     // Column of the first sprite column, relative to the stamp point
+    int8_t top;      // Row of the first sprite row, relative to the stamp point
+    uint8_t shifted[8][2][SSD1306_SPRITE_MAX_SIZE];  // [top row mod 8][upper/lower page][column]
+} ssd1306_sprite_t;
+
+/**
+ * @brief Sets or clears rows y0..y1 of column x (whole bytes where possible)
+ */
+void ssd1306_fill_vspan(uint8_t *ssd, int x, int y0, int y1, bool set);
+
+/**
+ * @brief Sets or clears columns x0..x1 of row y
+ */
+void ssd1306_fill_hspan(uint8_t *ssd, int x0, int x1, int y, bool set);
+
+/**
+ * @brief Draws a circle outline of radius r centered at (cx, cy)
+ */
+void ssd1306_draw_circle(uint8_t *ssd, int cx, int cy, int r, bool set);
+
+/**
+ * @brief Fills a circle of radius r centered at (cx, cy)
+ */
+void ssd1306_fill_circle(uint8_t *ssd, int cx, int cy, int r, bool set);
+
+/**
+ * @brief Draws the outline of a polygon
+ * @param xy Vertices as x0, y0, x1, y1, ...
+ * @param n Number of vertices (any count)
+ */
+void ssd1306_draw_polygon(uint8_t *ssd, const int16_t *xy, int n, bool set);
+
+/**
+ * @brief Fills a convex polygon
+ * @param xy Vertices as x0, y0, x1, y1, ... (any winding)
+ * @param n Number of vertices (1..SSD1306_POLYGON_MAX_VERTICES)
+ */
+void ssd1306_fill_polygon(uint8_t *ssd, const int16_t *xy, int n, bool set);
+
+/**
+ * @brief Pointy-top hexagon of circumradius r centered at (cx, cy)
+ */
+void ssd1306_draw_hexagon(uint8_t *ssd, int cx, int cy, int r, bool set);
+void ssd1306_fill_hexagon(uint8_t *ssd, int cx, int cy, int r, bool set);
+
+/**
+ * @brief Builds a sprite of a filled circle, anchored at its center
+ * @return false when the shape does not fit SSD1306_SPRITE_MAX_SIZE
+ */
+bool ssd1306_sprite_circle(ssd1306_sprite_t *sprite, int r);
+
+/**
+ * @brief Builds a sprite of a filled hexagon, anchored at its center
+ * @return false when the shape does not fit SSD1306_SPRITE_MAX_SIZE
+ */
+bool ssd1306_sprite_hexagon(ssd1306_sprite_t *sprite, int r);
+
+/**
+ * @brief Builds a sprite of a filled convex polygon, anchored at (0, 0)
+ * @return false when the shape does not fit SSD1306_SPRITE_MAX_SIZE
+ */
+bool ssd1306_sprite_polygon(ssd1306_sprite_t *sprite, const int16_t *xy, int n);
+
+/**
+ * @brief Stamps a sprite with its anchor at (x, y), setting or clearing its pixels
+ */
+void ssd1306_draw_sprite(uint8_t *ssd, const ssd1306_sprite_t *sprite, int x, int y, bool set);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,93 @@
+// Embarcatech, May 2025 - SSD1306 bit-matrix transpose
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    The 8 bytes of a block are packed into two words, row r in byte r
+    (lo = rows 0-3, hi = rows 4-7), so bit c of row r sits at 8r + c.
+    Transposing swaps bits 8r + c and 8c + r, done as three delta swaps
+    on ever larger sub-blocks: 1x1 cells inside 2x2 blocks (distance 7),
+    2x2 inside 4x4 (distance 14), then 4x4 inside 8x8 (distance 28, the
+    only one that crosses from lo to hi).
+    ======================================================================== */
+
+#include <string.h>   // memcpy()
+#include "ssd1306_transpose.h"
+
+void ssd1306_transpose8x8(const uint8_t *in, int in_stride, uint8_t *out, int out_stride) {
+    uint32_t lo = (uint32_t)in[0] | (uint32_t)in[in_stride] << 8 |
+                  (uint32_t)in[2 * in_stride] << 16 | (uint32_t)in[3 * in_stride] << 24;
+    uint32_t hi = (uint32_t)in[4 * in_stride] | (uint32_t)in[5 * in_stride] << 8 |
+                  (uint32_t)in[6 * in_stride] << 16 | (uint32_t)in[7 * in_stride] << 24;
+    uint32_t t;
+
+    t = (lo ^ (lo >> 7)) & 0x00AA00AAu;
+    lo ^= t ^ (t << 7);
+    t = (hi ^ (hi >> 7)) & 0x00AA00AAu;
+    hi ^= t ^ (t << 7);
+
+    t = (lo ^ (lo >> 14)) & 0x0000CCCCu;
+    lo ^= t ^ (t << 14);
+    t = (hi ^ (hi >> 14)) & 0x0000CCCCu;
+    hi ^= t ^ (t << 14);
+
+    t = (lo ^ (hi << 4)) & 0xF0F0F0F0u;
+    lo ^= t;
+    hi ^= t >> 4;
+
+    out[0] = (uint8_t)lo;
+    out[out_stride] = (uint8_t)(lo >> 8);
+    out[2 * out_stride] = (uint8_t)(lo >> 16);
+    out[3 * out_stride] = (uint8_t)(lo >> 24);
+    out[4 * out_stride] = (uint8_t)hi;
+    out[5 * out_stride] = (uint8_t)(hi >> 8);
+    out[6 * out_stride] = (uint8_t)(hi >> 16);
+    out[7 * out_stride] = (uint8_t)(hi >> 24);
+}
+
+void ssd1306_import_rows(uint8_t *pages, const uint8_t *rows, int width, int height, bool msb_first) {
+    int row_bytes = (width + 7) / 8;
+    for (int page = 0; page < (height + 7) / 8; page++) {
+        int block_rows = height - page * 8 < 8 ? height - page * 8 : 8;
+        for (int j = 0; j < row_bytes; j++) {
+            const uint8_t *in = &rows[page * 8 * row_bytes + j];
+            uint8_t *out = &pages[page * width + j * 8];
+
+            if (block_rows == 8 && j * 8 + 8 <= width) {
+                // Whole block: straight from the image into the page, mirrored for MSB-first rows
+                if (msb_first) {
+                    ssd1306_transpose8x8(in, row_bytes, out + 7, -1);
+                } else {
+                    ssd1306_transpose8x8(in, row_bytes, out, 1);
+                }
+                continue;
+            }
+
+            // Image edge: missing rows read as 0, columns past the width are not stored
+            uint8_t block[8] = { 0 };
+            uint8_t columns[8];
+            for (int r = 0; r < block_rows; r++) {
+                block[r] = in[r * row_bytes];
+            }
+            ssd1306_transpose8x8(block, 1, msb_first ? columns + 7 : columns, msb_first ? -1 : 1);
+            int count = width - j * 8 < 8 ? width - j * 8 : 8;
+            memcpy(out, columns, count);
+        }
+    }
+}
+
+void ssd1306_rotate_frame(uint8_t *panel, const uint8_t *portrait, ssd1306_rotation_t rotation) {
+    // Panel block (page p, columns 8j..8j+7) comes from portrait page j (270 degrees) or 15 - j (90),
+    // columns 8p..8p+7 (270 degrees: read backwards from 63 - 8p)
+    for (int p = 0; p < SSD1306_PANEL_HEIGHT / 8; p++) {
+        for (int j = 0; j < SSD1306_PANEL_WIDTH / 8; j++) {
+            uint8_t *out = &panel[p * SSD1306_PANEL_WIDTH + j * 8];
+            if (rotation == SSD1306_ROTATE_270) {
+                const uint8_t *in = &portrait[j * SSD1306_PORTRAIT_WIDTH + SSD1306_PORTRAIT_WIDTH - 1 - 8 * p];
+                ssd1306_transpose8x8(in, -1, out, 1);
+            } else {
+                const uint8_t *in = &portrait[(SSD1306_PORTRAIT_HEIGHT / 8 - 1 - j) * SSD1306_PORTRAIT_WIDTH + 8 * p];
+                ssd1306_transpose8x8(in, 1, out + 7, -1);
+            }
+        }
+    }
+}
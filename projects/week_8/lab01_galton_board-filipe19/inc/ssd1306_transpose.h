@@ -0,0 +1,69 @@
+// Embarcatech, May 2025 - SSD1306 bit-matrix transpose
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Conversions between the SSD1306 page format (one byte = 8 vertical
+    pixels of a column) and row-major or rotated images, 8x8 pixels at a
+    time.
+
+    Key Features:
+    - 8x8 bit transpose in three delta swaps on two 32-bit words (no
+      per-pixel loop, no table)
+    - Strided loads and stores, so blocks are read and written in place in
+      framebuffers and images; a negative stride mirrors the block
+    - Row-major import (XBM: leftmost pixel in the LSB; PBM P4: in the MSB)
+      into the page format used by ssd1306_draw_bitmap()
+    - 90 / 270 degree rotation of a 64 x 128 portrait frame into the
+      128 x 64 panel frame, for displays mounted on their side
+    - No hardware dependency: usable and testable on the host
+    ======================================================================== */
+
+#pragma once  // Ensures single inclusion of this header file
+
+#include <stdint.h>   // Fixed-width integer types
+#include <stdbool.h>  // bool type
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_PANEL_WIDTH 128
+#define SSD1306_PANEL_HEIGHT 64
+#define SSD1306_PORTRAIT_WIDTH SSD1306_PANEL_HEIGHT    // Logical size of a rotated panel
+#define SSD1306_PORTRAIT_HEIGHT SSD1306_PANEL_WIDTH
+
+/**
+ * @brief Panel mounting relative to the logical image
+ */
+typedef enum {
+    SSD1306_ROTATE_90,    // Logical top edge on the panel's right side
+    SSD1306_ROTATE_270    // Logical top edge on the panel's left side
+} ssd1306_rotation_t;
+
+/**
+ * @brief Transposes an 8x8 bit block: bit c of in[r] becomes bit r of out[c]
+ *
+ * @param in First of 8 input bytes, in_stride bytes apart
+ * @param out First of 8 output bytes, out_stride bytes apart (may be negative)
+ */
+void ssd1306_transpose8x8(const uint8_t *in, int in_stride, uint8_t *out, int out_stride);
+
+/**
+ * @brief Converts a row-major 1-bpp image into the page format
+ *
+ * @param pages Output, `width` bytes per page, (height + 7) / 8 pages
+ *              (a 128 x 64 image gives the full-screen ssd1306_draw_bitmap() layout)
+ * @param rows Input, (width + 7) / 8 bytes per row
+ * @param msb_first true for PBM (leftmost pixel in bit 7), false for XBM (bit 0)
+ */
+void ssd1306_import_rows(uint8_t *pages, const uint8_t *rows, int width, int height, bool msb_first);
+
+/**
+ * @brief Rotates a 64 x 128 portrait frame (page format, 16 pages of 64 bytes)
+ *        into the 128 x 64 panel frame (8 pages of 128 bytes)
+ */
+void ssd1306_rotate_frame(uint8_t *panel, const uint8_t *portrait, ssd1306_rotation_t rotation);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,108 @@
+// Embarcatech, May 2025 - Layered framebuffer compositor
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Page bookkeeping:
+    - dirty: pages whose layers changed; the object layer adds the pages
+      it drew into and the pages it was cleared from
+    - compositor_compose() merges the dirty pages word by word and keeps
+      in `flush` only those whose frame words actually differ, so a ball
+      redrawn on the same pixel costs no display transfer
+    ======================================================================== */
+
+#include <string.h>   // memset()
+#include "inc/compositor.h"
+
+#define PAGE_BIT(p) ((uint8_t)(1u << (p)))
+#define PAGE_MASK(n) ((uint8_t)((1u << (n)) - 1u))  // Pages 0..n-1
+
+void compositor_init(compositor_t *c, uint8_t pages) {
+    memset(c, 0, sizeof(*c));
+    compositor_set_pages(c, pages);
+}
+
+void compositor_set_pages(compositor_t *c, uint8_t pages) {
+    c->pages = pages > COMPOSITOR_PAGES ? COMPOSITOR_PAGES : pages;
+    c->dirty = COMPOSITOR_ALL_PAGES;
+    c->flush = COMPOSITOR_ALL_PAGES;
+}
+
+void compositor_background_changed(compositor_t *c) {
+    c->dirty = COMPOSITOR_ALL_PAGES;
+}
+
+void compositor_clear_objects(compositor_t *c) {
+    uint8_t pages = c->object_pages;
+    while (pages) {
+        int p = __builtin_ctz(pages);
+        pages &= pages - 1;
+        memset(&c->objects.bytes[p * COMPOSITOR_WIDTH], 0, COMPOSITOR_WIDTH);
+    }
+    c->dirty |= c->object_pages;
+    c->object_pages = 0;
+}
+
+void compositor_hud_box(compositor_t *c, int x, int page, int width) {
+    if (page < 0 || page >= COMPOSITOR_PAGES || x >= COMPOSITOR_WIDTH) {
+        return;
+    }
+    if (x < 0) {
+        width += x;
+        x = 0;
+    }
+    if (x + width > COMPOSITOR_WIDTH) {
+        width = COMPOSITOR_WIDTH - x;
+    }
+    if (width <= 0) {
+        return;
+    }
+    memset(&c->hud.bytes[page * COMPOSITOR_WIDTH + x], 0, width);
+    memset(&c->hud_mask.bytes[page * COMPOSITOR_WIDTH + x], 0xFF, width);
+    c->dirty |= PAGE_BIT(page);
+}
+
+void compositor_mark_flush(compositor_t *c, uint8_t pages) {
+    c->flush |= pages;
+}
+
+int compositor_compose(compositor_t *c) {
+    uint8_t pages = c->dirty & PAGE_MASK(c->pages);
+    c->dirty = 0;
+    c->last_pages_composed = 0;
+    c->last_pages_changed = 0;
+
+    while (pages) {
+        int p = __builtin_ctz(pages);
+        pages &= pages - 1;
+
+        const uint32_t *bg = &c->background.words[p * COMPOSITOR_PAGE_WORDS];
+        const uint32_t *obj = &c->objects.words[p * COMPOSITOR_PAGE_WORDS];
+        const uint32_t *hud = &c->hud.words[p * COMPOSITOR_PAGE_WORDS];
+        const uint32_t *mask = &c->hud_mask.words[p * COMPOSITOR_PAGE_WORDS];
+        uint32_t *out = &c->frame.words[p * COMPOSITOR_PAGE_WORDS];
+
+        uint32_t changed = 0;
+        for (int i = 0; i < COMPOSITOR_PAGE_WORDS; i++) {
+            uint32_t word = ((bg[i] | obj[i]) & ~mask[i]) | hud[i];
+            changed |= word ^ out[i];
+            out[i] = word;
+        }
+
+        c->last_pages_composed++;
+        if (changed) {
+            c->flush |= PAGE_BIT(p);
+            c->last_pages_changed++;
+        }
+    }
+    return c->last_pages_changed;
+}
+
+bool compositor_take_flush(compositor_t *c, uint8_t *first_page, uint8_t *last_page) {
+    if (!c->flush) {
+        return false;
+    }
+    *first_page = (uint8_t)__builtin_ctz(c->flush);
+    *last_page = (uint8_t)(31 - __builtin_clz(c->flush));
+    c->flush = 0;
+    return true;
+}
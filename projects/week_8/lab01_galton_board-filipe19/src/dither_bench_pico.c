@@ -0,0 +1,90 @@
+// Embarcatech, May 2025 - SSD1306 dither benchmark (RP2040) --- Author: Filipe Alves de Sousa
+// Dithers a synthetic heatmap streamed row by row (never a grayscale frame in RAM), prints the
+// time per frame of each mode on USB serial and shows the result on the OLED.
+// Send 'r' on the serial port to run the measurement again.
+//----------------------------------------------------------------------------------------------
+
+#include <stdio.h>             // printf()
+#include "pico/stdlib.h"       // Pico SDK utilities (time, stdio)
+#include "hardware/i2c.h"      // I2C communication with the display
+#include "hardware/clocks.h"   // clock_get_hz()
+#include "inc/ssd1306.h"       // OLED display library
+#include "inc/ssd1306_dither.h"
+#include "inc/galton_config.h"
+
+#define BENCH_FRAMES 200       // Frames per measurement
+#define SHOW_MS 2000           // Time each mode stays on the display
+
+static uint8_t frame[ssd1306_buffer_length];
+static uint8_t row[ssd1306_width];
+
+struct render_area bench_area = {
+    .start_column = 0,
+    .end_column = ssd1306_width - 1,
+    .start_page = 0,
+    .end_page = ssd1306_n_pages - 1
+};
+
+// === FUNCTION: Heatmap row: horizontal ramp plus a bright blob ===
+void make_row(int y, uint32_t phase) {
+    for (int x = 0; x < ssd1306_width; x++) {
+        int dx = x - 40 - (int)(phase % 48), dy = y - 28;
+        int blob = 180 - (dx * dx + dy * dy) / 6;
+        int value = x * 2 + (blob > 0 ? blob : 0);
+        row[x] = (uint8_t)(value > 255 ? 255 : value);
+    }
+}
+
+// === FUNCTION: Time of BENCH_FRAMES frames, row generation included when dither is false ===
+uint32_t run_frames(ssd1306_dither_mode_t mode, bool dither) {
+    ssd1306_dither_t d;
+    uint32_t start = time_us_32();
+    for (uint32_t f = 0; f < BENCH_FRAMES; f++) {
+        ssd1306_dither_init(&d, frame, ssd1306_width, ssd1306_height, mode);
+        for (int y = 0; y < ssd1306_height; y++) {
+            make_row(y, f);
+            if (dither) {
+                ssd1306_dither_row(&d, row);
+            }
+        }
+    }
+    return time_us_32() - start;
+}
+
+// === FUNCTION: Measures both modes and shows each one ===
+void run_bench() {
+    static const char *names[] = { "Bayer", "Floyd-Steinberg" };
+    uint32_t generate = run_frames(SSD1306_DITHER_BAYER, false);
+
+    printf("===== DITHER BENCHMARK (128 x 64, %d frames, %lu MHz) =====\n", BENCH_FRAMES,
+           (unsigned long)(clock_get_hz(clk_sys) / 1000000));
+    for (int m = 0; m < 2; m++) {
+        ssd1306_dither_mode_t mode = m ? SSD1306_DITHER_FLOYD : SSD1306_DITHER_BAYER;
+        uint32_t elapsed = run_frames(mode, true) - generate;
+        printf("%-16s %6lu us/frame  %5lu kpixel/s\n", names[m], (unsigned long)(elapsed / BENCH_FRAMES),
+               (unsigned long)((uint64_t)ssd1306_width * ssd1306_height * BENCH_FRAMES * 1000 / elapsed));
+        render_on_display(frame, &bench_area);  // Last frame of this mode
+        sleep_ms(SHOW_MS);
+    }
+}
+
+// === MAIN FUNCTION ===
+int main() {
+    stdio_init_all();
+    sleep_ms(2000);  // Time for the USB serial port to be opened
+
+    i2c_init(I2C_PORT, I2C_SPEED);
+    gpio_set_function(SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(SDA_PIN);
+    gpio_pull_up(SCL_PIN);
+    ssd1306_init();
+    calculate_render_area_buffer_length(&bench_area);
+
+    run_bench();
+    while (true) {
+        if (getchar_timeout_us(100000) == 'r') {
+            run_bench();
+        }
+    }
+}
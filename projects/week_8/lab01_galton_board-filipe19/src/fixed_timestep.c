@@ -0,0 +1,48 @@
+// Embarcatech, May 2025 - Fixed-timestep scheduler
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Implementation notes:
+    - Elapsed time is now - last in uint32 arithmetic, correct across the
+      ~71 minute wrap of the microsecond clock
+    - The accumulator keeps the remainder below one step, which is the
+      lag between the simulated state and wall-clock time
+    ======================================================================== */
+
+#include "inc/fixed_timestep.h"
+
+void fixed_timestep_init(fixed_timestep_t *ts, uint32_t step_hz, uint8_t max_steps, uint32_t now_us) {
+    ts->step_us = 1000000u / (step_hz ? step_hz : 1);
+    ts->last_us = now_us;
+    ts->accumulator_us = 0;
+    ts->max_steps = max_steps ? max_steps : 1;
+    ts->steps = 0;
+    ts->renders = 0;
+    ts->dropped_us = 0;
+    ts->max_lag_us = 0;
+    ts->last_steps = 0;
+}
+
+int fixed_timestep_advance(fixed_timestep_t *ts, uint32_t now_us) {
+    uint32_t lag = ts->accumulator_us + (now_us - ts->last_us);
+    ts->last_us = now_us;
+    if (lag > ts->max_lag_us) {
+        ts->max_lag_us = lag;
+    }
+
+    uint32_t steps = lag / ts->step_us;
+    ts->accumulator_us = lag - steps * ts->step_us;
+    if (steps > ts->max_steps) {
+        ts->dropped_us += (steps - ts->max_steps) * ts->step_us;  // Catching up would only fall further behind
+        steps = ts->max_steps;
+    }
+
+    ts->steps += steps;
+    ts->last_steps = (uint8_t)steps;
+    return (int)steps;
+}
+
+uint32_t fixed_timestep_wait_us(const fixed_timestep_t *ts, uint32_t now_us) {
+    uint32_t pending = ts->accumulator_us + (now_us - ts->last_us);
+    return pending >= ts->step_us ? 0 : ts->step_us - pending;
+}
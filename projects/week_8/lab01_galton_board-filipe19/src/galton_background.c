@@ -0,0 +1,33 @@
+// Embarcatech, May 2025 - "Digital Galton Board" background (run time)
+// Author: Filipe Alves de Sousa
+// Rasterizes the pins, the entry track and the bin walls of any layout.
+// The presets are baked at compile time (src/galton_screens.cpp); this path
+// only runs for the other geometries and must produce the same pixels.
+//----------------------------------------------------------------------------------------------
+
+#include <string.h>   // memset()
+#include "inc/galton_screens.h"
+#include "inc/ssd1306_raster.h"
+
+void galton_draw_background(uint8_t *buffer, const galton_geometry_t *geom) {
+    ssd1306_sprite_t pin;
+    ssd1306_sprite_hexagon(&pin, PIN_RADIUS);  // Rasterized once, pre-shifted for every y mod 8
+    memset(buffer, 0, GALTON_SCREEN_BYTES);
+
+    // Pin positions as pin_grid_init(): row r holds r + 1 pins, centered on the board
+    for (int row = 0; row < geom->rows; row++) {
+        int y = geom->pin_top_y + row * geom->spacing;
+        int first_x = BOARD_CENTER_X - row * (geom->spacing / 2);
+        for (int col = 0; col <= row; col++) {
+            ssd1306_draw_sprite(buffer, &pin, first_x + col * geom->spacing, y, true);
+        }
+    }
+
+    // Entry track above the top pin
+    ssd1306_fill_vspan(buffer, BOARD_CENTER_X - 2, geom->spawn_y - 2, geom->spawn_y + 2, true);
+    ssd1306_fill_vspan(buffer, BOARD_CENTER_X + 2, geom->spawn_y - 2, geom->spawn_y + 2, true);
+
+    for (int b = 0; b <= geom->bins; b++) {
+        ssd1306_fill_vspan(buffer, geom->histogram_x + b * geom->spacing, geom->bin_top_y, DISPLAY_HEIGHT - 1, true);
+    }
+}
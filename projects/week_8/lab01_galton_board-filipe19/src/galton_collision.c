@@ -0,0 +1,143 @@
+// Embarcatech, May 2025 - "Digital Galton Board" pin collision
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    O(1) collision lookup against the hexagonal pin lattice:
+    - Row index from the ball height (row = (y - top) / spacing, rounded)
+    - Column index from the row's first pin, which alternates by half a
+      spacing between even and odd rows
+    - A single candidate pin is tested per ball
+    - Swept test: on the falling part of the path y(t) is monotonic, so the
+      rows crossed during the step are a contiguous range; for each one the
+      crossing time solves y0 + vy t + g t^2 / 2 = row_y with an integer
+      square root, and x(t) picks the candidate pin
+    ======================================================================== */
+
+#include "inc/galton_collision.h"
+
+void pin_grid_init(pin_grid_t *grid, const galton_geometry_t *geom) {
+    grid->rows = geom->rows;
+    grid->spacing = geom->spacing_fixed;
+    grid->half_spacing = geom->half_spacing_fixed;
+    grid->hit_half_width = TO_FIXED(geom->spacing / 4);
+    for (int row = 0; row < geom->rows; row++) {
+        grid->row_y[row] = TO_FIXED(geom->pin_top_y + row * geom->spacing);
+        grid->row_first_x[row] = TO_FIXED(BOARD_CENTER_X - row * (geom->spacing / 2));
+    }
+}
+
+bool pin_grid_find_hit(const pin_grid_t *grid, int16_t x, int16_t y, int16_t *pin_x, int16_t *pin_y) {
+    // Nearest row (offset by half a spacing so the division rounds)
+    int ry = y - grid->row_y[0] + grid->half_spacing;
+    if (ry < 0) {
+        return false;  // Above the first row
+    }
+    int row = ry / grid->spacing;
+    if (row >= grid->rows) {
+        return false;  // Below the last row
+    }
+
+    int dy = y - grid->row_y[row];
+    if (dy < -PIN_HIT_RADIUS || dy > PIN_HIT_RADIUS) {
+        return false;
+    }
+
+    // Nearest column within the row
+    int cx = x - grid->row_first_x[row] + grid->half_spacing;
+    if (cx < 0) {
+        return false;  // Left of the first pin
+    }
+    int col = cx / grid->spacing;
+    if (col >= pin_grid_row_count(row)) {
+        return false;  // Right of the last pin
+    }
+
+    int px = grid->row_first_x[row] + col * grid->spacing;
+    int dx = x - px;
+    if (dx < -grid->hit_half_width || dx > grid->hit_half_width) {
+        return false;
+    }
+
+    *pin_x = (int16_t)px;
+    *pin_y = grid->row_y[row];
+    return true;
+}
+
+// Integer square root (bit by bit, no division)
+static uint32_t isqrt32(uint32_t n) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+bool pin_grid_sweep(const pin_grid_t *grid, int16_t x0, int16_t y0, int16_t vx, int16_t vy,
+                    int16_t gravity, int16_t min_vy, int32_t duration_q8,
+                    int32_t *t_q8, int16_t *pin_x, int16_t *pin_y) {
+    // Speed only grows, so a ball too slow at the end of the step cannot hit anything
+    int32_t ve = vy + ((gravity * duration_q8) >> 8);
+    if (gravity <= 0 || ve <= min_vy) {
+        return false;
+    }
+
+    // Part of the step where the ball is fast enough: from t_start (y = ys) to the end (y = ye)
+    int32_t ys = y0;
+    if (vy <= min_vy) {
+        int32_t t_start = (((int32_t)(min_vy - vy) << 8) + gravity - 1) / gravity;
+        int32_t xs = x0, vs = vy;
+        ballistic_advance(&xs, &ys, &vs, vx, gravity, t_start);
+    }
+    int32_t ye = y0 + ((((int32_t)vy + ve) * duration_q8) >> 9);  // Mean speed times duration
+
+    // Rows strictly below ys and not below ye; most steps cross none
+    int32_t from_top = ys - grid->row_y[0];
+    int row = from_top < 0 ? 0 : from_top / grid->spacing + 1;
+    if (row >= grid->rows || grid->row_y[row] > ye) {
+        return false;
+    }
+
+    for (; row < grid->rows && grid->row_y[row] <= ye; row++) {
+        // Falling root of y(t) = row_y
+        int32_t drop = grid->row_y[row] - y0;
+        int32_t disc = (int32_t)vy * vy + 2 * gravity * drop;
+        if (disc < 0) {
+            continue;
+        }
+        int32_t t = (((int32_t)isqrt32((uint32_t)disc) - vy) << 8) / gravity;
+        if (t > duration_q8) {
+            break;
+        }
+
+        // Nearest pin of the row at the crossing time
+        int32_t x = x0 + ((vx * t) >> 8);
+        int cx = x - grid->row_first_x[row] + grid->half_spacing;
+        if (cx < 0) {
+            continue;
+        }
+        int col = cx / grid->spacing;
+        if (col >= pin_grid_row_count(row)) {
+            continue;
+        }
+        int px = grid->row_first_x[row] + col * grid->spacing;
+        if (x - px < -grid->hit_half_width || x - px > grid->hit_half_width) {
+            continue;
+        }
+
+        *t_q8 = t < 0 ? 0 : t;
+        *pin_x = (int16_t)px;
+        *pin_y = grid->row_y[row];
+        return true;
+    }
+    return false;
+}
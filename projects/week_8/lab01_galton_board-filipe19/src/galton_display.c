@@ -0,0 +1,305 @@
+// Embarcatech, May 2025 - "Digital Galton Board" --- Author: Filipe Alves de Sousa
+// Initializes the hardware, reads the buttons and renders the simulation on the OLED display.
+//----------------------------------------------------------------------------------------------
+
+#include <stdio.h>             // printf()
+#include <string.h>            // memset(), snprintf()
+#include "pico/stdlib.h"       // Pico SDK utilities (GPIO, sleep, time)
+#include "hardware/i2c.h"      // I2C communication with the display
+#include "hardware/gpio.h"     // Buttons and interrupts
+#include "inc/ssd1306.h"       // OLED display library
+#include "inc/galton_config.h"
+#include "inc/galton_simulation.h"
+#include "inc/galton_replay.h"
+#include "inc/fixed_timestep.h"
+#include "inc/compositor.h"
+#include "inc/galton_screens.h"
+
+#define HUD_FIT_X 88           // "C:XXX" (chi-square to the theoretical curve), right of "T:XXXX"
+#define STATS_PRINT_FRAMES SIM_STEP_HZ // Statistics are printed on the serial port every N steps (1 s)
+#define LOG_BUFFER_SIZE 4096   // Record/replay log (~3 bytes per button press)
+
+// Rendering area for the OLED display (its pages are set per flush)
+struct render_area oled_area = {
+    .start_column = 0,
+    .end_column = ssd1306_width - 1,
+    .start_page = 0,
+    .end_page = ssd1306_n_pages - 1
+};
+
+static galton_sim_t sim;                      // Simulation state (ball pool lives inside)
+static uint8_t log_buffer[LOG_BUFFER_SIZE];   // Inputs of the current run, dumped with 'd'
+static galton_recorder_t recorder;
+static fixed_timestep_t timestep;             // Physics steps vs rendered frames
+
+// Screen layers: pins, track and bin walls (background), balls (objects) and labels (HUD).
+// The pages below the board belong to the histogram, which draws straight into the frame.
+static compositor_t screen;
+
+// HUD labels: values currently drawn in the HUD layer (HUD_STALE forces a redraw)
+enum { HUD_BALLS, HUD_BIAS, HUD_TOTAL, HUD_FIT, HUD_LABELS };
+#define HUD_STALE -1
+static int hud_shown[HUD_LABELS];
+static uint32_t pages_flushed;                // Display pages sent since the last statistics line
+
+static uint8_t geometry_preset = 0;           // Index in galton_geometry_presets
+
+// Button flags set by the interrupt handler and consumed by the main loop
+volatile bool button_a_pressed = false;
+volatile bool button_b_pressed = false;
+volatile bool button_joystick_pressed = false;
+absolute_time_t last_button_a_time = { 0 };
+absolute_time_t last_button_b_time = { 0 };
+absolute_time_t last_button_joystick_time = { 0 };
+
+// === FUNCTION: Button interrupt handler (with debounce) ===
+void gpio_callback(uint gpio, uint32_t events) {
+    absolute_time_t now = get_absolute_time();
+
+    if (gpio == BUTTON_A && absolute_time_diff_us(last_button_a_time, now) > DEBOUNCE_TIME_MS * 1000) {
+        last_button_a_time = now;
+        button_a_pressed = true;
+    } else if (gpio == BUTTON_B && absolute_time_diff_us(last_button_b_time, now) > DEBOUNCE_TIME_MS * 1000) {
+        last_button_b_time = now;
+        button_b_pressed = true;
+    } else if (gpio == BUTTON_JOYSTICK && absolute_time_diff_us(last_button_joystick_time, now) > DEBOUNCE_TIME_MS * 1000) {
+        last_button_joystick_time = now;
+        button_joystick_pressed = true;
+    }
+}
+
+// === FUNCTION: Initializes I2C and OLED display ===
+bool setup_display() {
+    i2c_init(I2C_PORT, I2C_SPEED);
+    gpio_set_function(SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(SDA_PIN);
+    gpio_pull_up(SCL_PIN);
+    sleep_ms(200);
+
+    ssd1306_init();
+    compositor_init(&screen, ssd1306_n_pages);
+    calculate_render_area_buffer_length(&oled_area);
+    // Baked in flash at compile time; render_on_display() only reads the buffer
+    render_on_display((uint8_t *)galton_splash_screen(), &oled_area);
+    sleep_ms(1000);
+    return true;
+}
+
+// === FUNCTION: Initializes the buttons with falling-edge interrupts ===
+void setup_buttons() {
+    gpio_init(BUTTON_A);
+    gpio_set_dir(BUTTON_A, GPIO_IN);
+    gpio_pull_up(BUTTON_A);
+    gpio_init(BUTTON_B);
+    gpio_set_dir(BUTTON_B, GPIO_IN);
+    gpio_pull_up(BUTTON_B);
+    gpio_init(BUTTON_JOYSTICK);
+    gpio_set_dir(BUTTON_JOYSTICK, GPIO_IN);
+    gpio_pull_up(BUTTON_JOYSTICK);
+
+    gpio_set_irq_enabled_with_callback(BUTTON_A, GPIO_IRQ_EDGE_FALL, true, &gpio_callback);
+    gpio_set_irq_enabled(BUTTON_B, GPIO_IRQ_EDGE_FALL, true);
+    gpio_set_irq_enabled(BUTTON_JOYSTICK, GPIO_IRQ_EDGE_FALL, true);
+}
+
+// === FUNCTION: Loads the pins, the track and the bin walls into the background ===
+// Runs once per geometry change; frames then only recompose the pages where something moved.
+// The presets were rendered at compile time and are copied from flash; other layouts are rasterized.
+void build_background() {
+    const galton_geometry_t *g = &sim.geom;
+    uint8_t *background = screen.background.bytes;
+    const uint8_t *baked = galton_baked_background(g->rows, g->spacing);
+    if (baked) {
+        memcpy(background, baked, COMPOSITOR_BYTES);
+    } else {
+        galton_draw_background(background, g);
+    }
+
+    // The layers cover the board; the histogram area starts over with empty bars
+    // (galton_set_geometry() reset the histogram) and the HUD row moves with it
+    compositor_set_pages(&screen, g->histogram_first_page);
+    compositor_background_changed(&screen);
+    memcpy(screen.frame.bytes, background, COMPOSITOR_BYTES);
+    memset(screen.hud.bytes, 0, COMPOSITOR_BYTES);
+    memset(screen.hud_mask.bytes, 0, COMPOSITOR_BYTES);
+    for (int i = 0; i < HUD_LABELS; i++) {
+        hud_shown[i] = HUD_STALE;
+    }
+}
+
+// === FUNCTION: Records an input and applies it to the simulation ===
+void apply_input(uint8_t type, uint32_t value) {
+    galton_recorder_event(&recorder, sim.frame, type, value);
+    galton_apply_event(&sim, type, value);
+}
+
+// === FUNCTION: Applies pending button actions ===
+void handle_buttons() {
+    if (button_a_pressed) {
+        button_a_pressed = false;
+        apply_input(GALTON_EV_BUTTON_A, 0);  // Balls per cycle 1..5
+    }
+    if (button_b_pressed) {
+        button_b_pressed = false;
+        apply_input(GALTON_EV_BUTTON_B, 0);  // Bias 0..10
+    }
+    if (button_joystick_pressed) {
+        button_joystick_pressed = false;
+        geometry_preset = (geometry_preset + 1) % GALTON_GEOMETRY_PRESETS;
+        const uint8_t *preset = galton_geometry_presets[geometry_preset];
+        apply_input(GALTON_EV_SET_GEOMETRY, preset[0] | preset[1] << 8);
+        build_background();
+    }
+}
+
+// === FUNCTION: Prints the log as hex on the serial port (for tests/replay_log.c) ===
+void dump_log() {
+    if (galton_recorder_end(&recorder, sim.frame) != GALTON_LOG_OK) {
+        printf("Log buffer too small for a header\n");
+        return;
+    }
+    if (recorder.overflow) {
+        printf("LOG %u bytes (truncated at frame %lu)\n", (unsigned)recorder.length, (unsigned long)recorder.lost_frame);
+    } else {
+        printf("LOG %u bytes\n", (unsigned)recorder.length);
+    }
+    for (size_t i = 0; i < recorder.length; i++) {
+        printf("%02x%s", log_buffer[i], (i % 32 == 31) ? "\n" : "");
+    }
+    printf("\nEND LOG\n");
+    galton_recorder_reopen(&recorder);
+}
+
+// === FUNCTION: Draws every ball in flight into the object layer ===
+void draw_balls() {
+    const ball_pool_t *pool = &sim.balls;
+    compositor_clear_objects(&screen);
+    for (int w = 0; w < BALL_POOL_WORDS; w++) {
+        uint32_t bits = pool->active[w];
+        while (bits) {
+            int i = w * 32 + __builtin_ctz(bits);
+            bits &= bits - 1;
+            int x, y;
+            galton_ball_pixel(&sim, (uint16_t)i, &x, &y);
+            if (x >= 0 && x < DISPLAY_WIDTH && y >= 0 && y < DISPLAY_HEIGHT) {
+                compositor_set_pixel(&screen, x, y);
+            }
+        }
+    }
+}
+
+// === FUNCTION: Redraws one HUD label if its value changed ===
+// The box is as wide as the longest text of the label, so a shorter value erases the old one.
+void draw_label(int label, int value, int x, int y, int chars, const char *format) {
+    if (hud_shown[label] == value) {
+        return;
+    }
+    hud_shown[label] = value;
+    char text[12];
+    snprintf(text, sizeof(text), format, value);
+    compositor_hud_box(&screen, x, y / 8, chars * 8);
+    ssd1306_draw_string(screen.hud.bytes, x, y, text);
+}
+
+// === FUNCTION: Draws the "A:X", "B:X", "T:XXXX" and "C:XXX" labels ===
+void draw_hud() {
+    draw_label(HUD_BALLS, sim.balls_per_cycle, 0, 0, 3, "A:%d");
+    draw_label(HUD_BIAS, sim.bias, DISPLAY_WIDTH - 32, 0, 4, "B:%d");
+    int hud_y = (sim.geom.histogram_first_page - 1) * 8;  // Last page above the histogram
+    draw_label(HUD_TOTAL, (int)(sim.histogram.total % 10000), 0, hud_y, 6, "T:%d");
+
+    galton_stats_summary_t summary;
+    galton_stats_summary(&sim.stats, &summary);
+    int chi = summary.chi_square > 999.0f ? 999 : (int)summary.chi_square;
+    draw_label(HUD_FIT, chi, HUD_FIT_X, hud_y, 5, "C:%d");
+}
+
+// === FUNCTION: Prints the live statistics on the serial port ===
+void print_stats() {
+    galton_stats_summary_t summary;
+    galton_stats_summary(&sim.stats, &summary);
+    printf("n=%lu mean=%.3f (%.3f) var=%.3f (%.3f) skew=%.3f chi2=%.2f\n",
+           (unsigned long)sim.stats.n, summary.mean, summary.theory_mean,
+           summary.variance, summary.theory_variance, summary.skewness, summary.chi_square);
+    printf("steps=%lu renders=%lu lag=%lu us (max %lu) dropped=%lu us\n",
+           (unsigned long)timestep.steps, (unsigned long)timestep.renders,
+           (unsigned long)timestep.accumulator_us, (unsigned long)timestep.max_lag_us,
+           (unsigned long)timestep.dropped_us);
+    printf("pages sent=%lu (of %lu) composed=%u changed=%u\n", (unsigned long)pages_flushed,
+           (unsigned long)(timestep.renders * ssd1306_n_pages), screen.last_pages_composed,
+           screen.last_pages_changed);
+    pages_flushed = 0;
+}
+
+// === FUNCTION: Sends the frame pages that changed to the display ===
+void flush_display() {
+    uint8_t first, last;
+    if (!compositor_take_flush(&screen, &first, &last)) {
+        return;
+    }
+    oled_area.start_page = first;
+    oled_area.end_page = last;
+    calculate_render_area_buffer_length(&oled_area);
+    render_on_display(&screen.frame.bytes[first * ssd1306_width], &oled_area);
+    pages_flushed += last - first + 1;
+}
+
+// === FUNCTION: Renders one frame ===
+// The board pages are recomposed from the layers where they changed; the histogram
+// keeps its bars in the frame and redraws just the ones whose normalized height changed.
+void render_frame() {
+    draw_hud();
+    draw_balls();
+    compositor_compose(&screen);
+    galton_update_theory_overlay(&sim);
+    if (histogram_draw(&sim.histogram, screen.frame.bytes) > 0) {
+        compositor_mark_flush(&screen, (uint8_t)(COMPOSITOR_ALL_PAGES << screen.pages));
+    }
+    flush_display();
+}
+
+// === FUNCTION: General setup ===
+void setup() {
+    stdio_init_all();
+    setup_buttons();
+    if (!setup_display()) {
+        printf("Error initializing display\n");
+    }
+    galton_init(&sim);
+    uint32_t seed = time_us_32();
+    galton_seed(&sim, seed);
+    galton_recorder_begin(&recorder, log_buffer, sizeof(log_buffer), &sim, seed);
+    build_background();
+}
+
+// === MAIN FUNCTION ===
+int main() {
+    setup();
+    printf("Galton board: %u ball slots, %.2f bytes per ball\n",
+           BALL_POOL_CAPACITY, BALL_POOL_BYTES_PER_BALL);
+
+    // Physics runs at SIM_STEP_HZ; rendering shows the latest state as fast as the I2C bus allows
+    fixed_timestep_init(&timestep, SIM_STEP_HZ, MAX_SUBSTEPS, time_us_32());
+    while (true) {
+        handle_buttons();
+        if (getchar_timeout_us(0) == 'd') {
+            dump_log();
+        }
+
+        int steps = fixed_timestep_advance(&timestep, time_us_32());
+        if (steps == 0) {
+            sleep_us(fixed_timestep_wait_us(&timestep, time_us_32()));
+            continue;
+        }
+        while (steps--) {
+            galton_frame(&sim);
+            if (sim.frame % STATS_PRINT_FRAMES == 0) {
+                print_stats();
+            }
+        }
+
+        render_frame();
+        fixed_timestep_rendered(&timestep);
+    }
+}
@@ -0,0 +1,46 @@
+// Embarcatech, May 2025 - "Digital Galton Board" board geometry
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Layout rules:
+    - The board is centered on BOARD_CENTER_X, first pin row at PIN_TOP_Y
+    - Bins start one spacing below the last row of pins
+    - The histogram owns the whole pages below the bin line, so the board
+      above it can be redrawn without touching the bars
+    ======================================================================== */
+
+#include "inc/galton_geometry.h"
+
+int galton_geometry_build(galton_geometry_t *geom, uint8_t rows, uint8_t spacing) {
+    if (rows < MIN_ROWS || rows > MAX_ROWS || spacing < MIN_PIN_SPACING ||
+        spacing > MAX_PIN_SPACING || (spacing & 1)) {
+        return GALTON_GEOMETRY_ERR_RANGE;
+    }
+
+    int bins = rows + 1;
+    int bin_top_y = PIN_TOP_Y + rows * spacing;
+    int first_page = (bin_top_y + 7) / 8;
+    int height = DISPLAY_HEIGHT - first_page * 8;
+    int histogram_x = BOARD_CENTER_X - (bins * spacing) / 2;
+    if (height < MIN_HISTOGRAM_HEIGHT || histogram_x < 0) {
+        return GALTON_GEOMETRY_ERR_FIT;
+    }
+
+    geom->rows = (uint8_t)rows;
+    geom->bins = (uint8_t)bins;
+    geom->spacing = spacing;
+    geom->pin_top_y = PIN_TOP_Y;
+    geom->bin_top_y = (uint8_t)bin_top_y;
+    geom->spawn_y = (uint8_t)(PIN_TOP_Y - spacing > 0 ? PIN_TOP_Y - spacing : 0);
+    geom->histogram_x = (uint8_t)histogram_x;
+    geom->histogram_first_page = (uint8_t)first_page;
+    geom->histogram_height = (uint8_t)(height > MAX_HISTOGRAM_HEIGHT ? MAX_HISTOGRAM_HEIGHT : height);
+
+    geom->spacing_fixed = TO_FIXED(spacing);
+    geom->half_spacing_fixed = TO_FIXED(spacing / 2);
+    geom->bin_top_fixed = TO_FIXED(bin_top_y);
+    geom->bins_left_fixed = TO_FIXED(histogram_x);
+    geom->spawn_x_fixed = TO_FIXED(BOARD_CENTER_X);
+    geom->spawn_y_fixed = TO_FIXED(geom->spawn_y);
+    return GALTON_GEOMETRY_OK;
+}
@@ -0,0 +1,300 @@
+// Embarcatech, May 2025 - "Digital Galton Board" record/replay
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Binary log writer and headless replayer.
+    - Frame deltas and values are LEB128 varints: a button press costs 3 bytes
+    - Floats are stored as raw IEEE-754 bits, so parameters replay exactly
+    - The replayer applies the events of a frame, then times galton_frame()
+    ======================================================================== */
+
+#include <string.h>   // memcpy()
+#include "inc/galton_replay.h"
+
+static const uint8_t log_magic[4] = { 'G', 'L', 'O', 'G' };
+
+// === ENCODING HELPERS ===
+
+static uint32_t float_bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float bits_float(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void put_u32(uint8_t *out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t get_u32(const uint8_t *in) {
+    return in[0] | (in[1] << 8) | (in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+// Writes a varint; returns the number of bytes (0 if it does not fit)
+static size_t put_varint(uint8_t *out, size_t room, uint32_t value) {
+    size_t n = 0;
+    do {
+        if (n == room) {
+            return 0;
+        }
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        out[n++] = value ? (byte | 0x80) : byte;
+    } while (value);
+    return n;
+}
+
+// Reads a varint; returns the number of bytes consumed (0 if truncated)
+static size_t get_varint(const uint8_t *in, size_t room, uint32_t *value) {
+    uint32_t result = 0;
+    for (size_t n = 0; n < room && n < 5; n++) {
+        result |= (uint32_t)(in[n] & 0x7F) << (7 * n);
+        if (!(in[n] & 0x80)) {
+            *value = result;
+            return n + 1;
+        }
+    }
+    return 0;
+}
+
+// True when the float stored in bits lies in lo..hi (false for NaN)
+static bool float_in_range(uint32_t bits, float lo, float hi) {
+    float value = bits_float(bits);
+    return value >= lo && value <= hi;
+}
+
+// === RECORDER ===
+
+int galton_recorder_begin(galton_recorder_t *rec, uint8_t *buffer, size_t capacity,
+                          const galton_sim_t *sim, uint32_t seed) {
+    rec->buffer = buffer;
+    rec->capacity = capacity;
+    rec->length = 0;
+    rec->end_offset = 0;
+    rec->last_frame = sim->frame;
+    rec->overflow = false;
+    rec->lost_frame = 0;
+
+    if (capacity < GALTON_LOG_HEADER_BYTES + GALTON_LOG_END_BYTES) {
+        rec->overflow = true;
+        return GALTON_LOG_ERR_FULL;
+    }
+
+    memcpy(buffer, log_magic, sizeof(log_magic));
+    buffer[4] = GALTON_LOG_VERSION;
+    buffer[5] = sim->geom.rows;
+    buffer[6] = sim->geom.spacing;
+    buffer[7] = (uint8_t)sim->mode;
+    put_u32(buffer + 8, seed);
+    buffer[12] = sim->bias;
+    buffer[13] = sim->balls_per_cycle;
+    put_u32(buffer + 14, float_bits(sim->gravity_setting));
+    put_u32(buffer + 18, float_bits(sim->bounciness_setting));
+    buffer[22] = sim->step_scale;
+    buffer[23] = (uint8_t)sim->collision;
+    rec->length = GALTON_LOG_HEADER_BYTES;
+    return GALTON_LOG_OK;
+}
+
+int galton_recorder_event(galton_recorder_t *rec, uint32_t frame, uint8_t type, uint32_t value) {
+    bool end = type == GALTON_EV_END;
+    if (rec->overflow && !end) {
+        return GALTON_LOG_ERR_FULL;  // A smaller event must not skip over the lost one
+    }
+    uint8_t event[11];
+    size_t n = put_varint(event, sizeof(event), frame - rec->last_frame);
+    event[n++] = type;
+    if (!end) {
+        n += put_varint(event + n, sizeof(event) - n, value);
+    }
+
+    // Ordinary events leave room for the END, which may use it
+    if (rec->length + n + (end ? 0 : GALTON_LOG_END_BYTES) > rec->capacity) {
+        if (!rec->overflow) {
+            rec->overflow = true;
+            rec->lost_frame = frame;
+        }
+        return GALTON_LOG_ERR_FULL;
+    }
+    memcpy(rec->buffer + rec->length, event, n);
+    rec->length += n;
+    rec->last_frame = frame;
+    return GALTON_LOG_OK;
+}
+
+int galton_recorder_end(galton_recorder_t *rec, uint32_t frame) {
+    size_t offset = rec->length;
+    uint32_t last_frame = rec->last_frame;
+    int result = galton_recorder_event(rec, rec->overflow ? rec->lost_frame : frame, GALTON_EV_END, 0);
+    if (result == GALTON_LOG_OK) {
+        rec->end_offset = offset;
+        rec->last_frame = last_frame;  // Restored by galton_recorder_reopen()
+    }
+    return result;
+}
+
+void galton_recorder_reopen(galton_recorder_t *rec) {
+    if (rec->end_offset) {
+        rec->length = rec->end_offset;
+        rec->end_offset = 0;
+    }
+}
+
+// === REPLAY ===
+
+int galton_apply_event(galton_sim_t *sim, uint8_t type, uint32_t value) {
+    switch (type) {
+    case GALTON_EV_BUTTON_A:
+        galton_button_a(sim);
+        return GALTON_LOG_OK;
+    case GALTON_EV_BUTTON_B:
+        galton_button_b(sim);
+        return GALTON_LOG_OK;
+    case GALTON_EV_SET_BIAS:
+        if (value > MAX_BIAS) {
+            return GALTON_LOG_ERR_FORMAT;
+        }
+        galton_set_bias(sim, (uint8_t)value);
+        return GALTON_LOG_OK;
+    case GALTON_EV_SET_BALLS:
+        if (value < 1 || value > MAX_BALLS_PER_CYCLE) {
+            return GALTON_LOG_ERR_FORMAT;
+        }
+        sim->balls_per_cycle = (uint8_t)value;
+        return GALTON_LOG_OK;
+    case GALTON_EV_SET_MODE:
+        if (value > GALTON_MODE_TRAJECTORY) {
+            return GALTON_LOG_ERR_FORMAT;
+        }
+        galton_set_mode(sim, (galton_mode_t)value);
+        return GALTON_LOG_OK;
+    case GALTON_EV_SET_GRAVITY:
+        if (!float_in_range(value, MIN_GRAVITY, MAX_GRAVITY)) {
+            return GALTON_LOG_ERR_FORMAT;
+        }
+        galton_set_physics(sim, bits_float(value), sim->bounciness_setting);
+        return GALTON_LOG_OK;
+    case GALTON_EV_SET_BOUNCINESS:
+        if (!float_in_range(value, MIN_BOUNCINESS, MAX_BOUNCINESS)) {
+            return GALTON_LOG_ERR_FORMAT;
+        }
+        galton_set_physics(sim, sim->gravity_setting, bits_float(value));
+        return GALTON_LOG_OK;
+    case GALTON_EV_SET_GEOMETRY:
+        if (value >> 16) {
+            return GALTON_LOG_ERR_FORMAT;
+        }
+        if (galton_set_geometry(sim, (uint8_t)value, (uint8_t)(value >> 8)) != GALTON_GEOMETRY_OK) {
+            return GALTON_LOG_ERR_GEOMETRY;
+        }
+        return GALTON_LOG_OK;
+    default:
+        return GALTON_LOG_ERR_FORMAT;
+    }
+}
+
+// Every starting parameter of the header in the range its setter expects
+static bool header_valid(const uint8_t *log) {
+    return log[7] <= GALTON_MODE_TRAJECTORY && log[12] <= MAX_BIAS &&
+           log[13] >= 1 && log[13] <= MAX_BALLS_PER_CYCLE &&
+           float_in_range(get_u32(log + 14), MIN_GRAVITY, MAX_GRAVITY) &&
+           float_in_range(get_u32(log + 18), MIN_BOUNCINESS, MAX_BOUNCINESS) &&
+           log[22] >= 1 && log[22] <= MAX_STEP_SCALE && log[23] <= GALTON_COLLISION_DISCRETE;
+}
+
+int galton_replay(const uint8_t *log, size_t length, galton_sim_t *sim,
+                  galton_profile_t *profile, uint32_t (*now_us)(void)) {
+    if (length < GALTON_LOG_HEADER_BYTES || memcmp(log, log_magic, sizeof(log_magic)) != 0 ||
+        log[4] != GALTON_LOG_VERSION || !header_valid(log)) {
+        return GALTON_LOG_ERR_FORMAT;
+    }
+
+    // Starting state
+    galton_init(sim);
+    if (galton_set_geometry(sim, log[5], log[6]) != GALTON_GEOMETRY_OK) {
+        return GALTON_LOG_ERR_GEOMETRY;
+    }
+    galton_set_mode(sim, (galton_mode_t)log[7]);
+    galton_seed(sim, get_u32(log + 8));
+    galton_set_bias(sim, log[12]);
+    sim->balls_per_cycle = log[13];
+    galton_set_physics(sim, bits_float(get_u32(log + 14)), bits_float(get_u32(log + 18)));
+    galton_set_step_scale(sim, log[22]);
+    galton_set_collision(sim, (galton_collision_t)log[23]);
+
+    if (profile) {
+        profile->frames = 0;
+        profile->events = 0;
+        profile->min_us = UINT32_MAX;
+        profile->max_us = 0;
+        profile->total_us = 0;
+    }
+
+    size_t pos = GALTON_LOG_HEADER_BYTES;
+    uint32_t event_frame = 0;
+    while (true) {
+        // Next event
+        uint32_t delta, value = 0;
+        size_t n = get_varint(log + pos, length - pos, &delta);
+        if (n == 0 || pos + n >= length) {
+            return GALTON_LOG_ERR_TRUNCATED;
+        }
+        pos += n;
+        uint8_t type = log[pos++];
+        if (type != GALTON_EV_END) {
+            n = get_varint(log + pos, length - pos, &value);
+            if (n == 0) {
+                return GALTON_LOG_ERR_TRUNCATED;
+            }
+            pos += n;
+        }
+        event_frame += delta;
+
+        // Frames up to the event
+        while (sim->frame < event_frame) {
+            uint32_t start = now_us ? now_us() : 0;
+            galton_frame(sim);
+            if (profile) {
+                uint32_t elapsed = now_us ? now_us() - start : 0;
+                if (profile->frame_us && profile->frames < profile->frame_us_capacity) {
+                    profile->frame_us[profile->frames] = elapsed;
+                }
+                profile->frames++;
+                profile->total_us += elapsed;
+                profile->min_us = elapsed < profile->min_us ? elapsed : profile->min_us;
+                profile->max_us = elapsed > profile->max_us ? elapsed : profile->max_us;
+            }
+        }
+
+        if (type == GALTON_EV_END) {
+            return GALTON_LOG_OK;
+        }
+        int result = galton_apply_event(sim, type, value);
+        if (result != GALTON_LOG_OK) {
+            return result;
+        }
+        if (profile) {
+            profile->events++;
+        }
+    }
+}
+
+uint32_t galton_histogram_checksum(const galton_sim_t *sim) {
+    uint32_t hash = 2166136261u;  // FNV-1a offset basis
+    for (int b = 0; b < sim->geom.bins; b++) {
+        uint32_t count = sim->histogram.counts[b];
+        for (int i = 0; i < 4; i++) {
+            hash ^= (count >> (8 * i)) & 0xFF;
+            hash *= 16777619u;   // FNV prime
+        }
+    }
+    return hash;
+}
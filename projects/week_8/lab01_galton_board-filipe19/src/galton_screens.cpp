@@ -0,0 +1,109 @@
+// Embarcatech, May 2025 - "Digital Galton Board" static screens (compile time)
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    The splash screen and the preset backgrounds are constexpr objects:
+    the compiler runs the drawing code and emits only the resulting bytes,
+    in .rodata (flash). The layout rules repeat galton_geometry_build()
+    and pin_grid_init(); tests/test_baked_screens.c checks that every
+    baked background matches galton_draw_background() pixel for pixel.
+    ======================================================================== */
+
+#include "inc/galton_screens.h"
+#include "inc/ssd1306_constexpr.hpp"
+
+namespace {
+
+constexpr uint8_t presets[GALTON_GEOMETRY_PRESETS][2] = { { 6, 6 }, { 9, 4 }, { 7, 4 }, { 3, 12 } };
+
+// Same acceptance rules as galton_geometry_build()
+constexpr bool layout_fits(int rows, int spacing) {
+    int bin_top_y = PIN_TOP_Y + rows * spacing;
+    int first_page = (bin_top_y + 7) / 8;
+    return rows >= MIN_ROWS && rows <= MAX_ROWS && spacing >= MIN_PIN_SPACING &&
+           spacing <= MAX_PIN_SPACING && (spacing & 1) == 0 &&
+           DISPLAY_HEIGHT - first_page * 8 >= MIN_HISTOGRAM_HEIGHT &&
+           BOARD_CENTER_X - ((rows + 1) * spacing) / 2 >= 0;
+}
+
+constexpr bool presets_fit() {
+    for (const auto &preset : presets) {
+        if (!layout_fits(preset[0], preset[1])) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(presets_fit(), "A geometry preset does not fit the display");
+
+// Pins, entry track and bin walls, as galton_draw_background()
+constexpr ssd1306_ce::canvas bake_background(int rows, int spacing) {
+    ssd1306_ce::canvas c{};
+    for (int row = 0; row < rows; row++) {
+        int y = PIN_TOP_Y + row * spacing;
+        int first_x = BOARD_CENTER_X - row * (spacing / 2);
+        for (int col = 0; col <= row; col++) {
+            c.fill_hexagon(first_x + col * spacing, y, PIN_RADIUS);
+        }
+    }
+
+    int spawn_y = PIN_TOP_Y - spacing > 0 ? PIN_TOP_Y - spacing : 0;
+    c.fill_vspan(BOARD_CENTER_X - 2, spawn_y - 2, spawn_y + 2);
+    c.fill_vspan(BOARD_CENTER_X + 2, spawn_y - 2, spawn_y + 2);
+
+    int bin_top_y = PIN_TOP_Y + rows * spacing;
+    int histogram_x = BOARD_CENTER_X - ((rows + 1) * spacing) / 2;
+    for (int b = 0; b <= rows + 1; b++) {
+        c.fill_vspan(histogram_x + b * spacing, bin_top_y, DISPLAY_HEIGHT - 1);
+    }
+    return c;
+}
+
+constexpr ssd1306_ce::canvas bake_splash() {
+    ssd1306_ce::canvas c{};
+    c.draw_string(16, 0, "GALTON BOARD");
+
+    // A small pin triangle with a ball dropping into it
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col <= row; col++) {
+            c.fill_hexagon(BOARD_CENTER_X - row * 6 + col * 12, 20 + row * 7, 2);
+        }
+    }
+    c.fill_circle(BOARD_CENTER_X + 3, 14, 1);
+    c.draw_line(BOARD_CENTER_X - 30, 46, BOARD_CENTER_X + 30, 46);
+
+    c.draw_string(20, 56, "EMBARCATECH");
+    return c;
+}
+
+constexpr ssd1306_ce::canvas splash = bake_splash();
+constexpr ssd1306_ce::canvas backgrounds[GALTON_GEOMETRY_PRESETS] = {
+    bake_background(presets[0][0], presets[0][1]),
+    bake_background(presets[1][0], presets[1][1]),
+    bake_background(presets[2][0], presets[2][1]),
+    bake_background(presets[3][0], presets[3][1]),
+};
+
+}  // namespace
+
+extern "C" {
+
+const uint8_t galton_geometry_presets[GALTON_GEOMETRY_PRESETS][2] = {
+    { presets[0][0], presets[0][1] }, { presets[1][0], presets[1][1] },
+    { presets[2][0], presets[2][1] }, { presets[3][0], presets[3][1] },
+};
+
+const uint8_t *galton_splash_screen(void) {
+    return splash.bytes;
+}
+
+const uint8_t *galton_baked_background(uint8_t rows, uint8_t spacing) {
+    for (int i = 0; i < GALTON_GEOMETRY_PRESETS; i++) {
+        if (presets[i][0] == rows && presets[i][1] == spacing) {
+            return backgrounds[i].bytes;
+        }
+    }
+    return nullptr;
+}
+
+}  // extern "C"
@@ -0,0 +1,342 @@
+// Embarcatech, May 2025 - "Digital Galton Board" simulation
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    This module implements the physics of the Galton board:
+    - Fixed-capacity structure-of-arrays ball pool (no per-ball allocation)
+    - Exact ballistic integration in Q9.7 fixed point, any step length
+    - Pin collisions (swept or discrete O(1) grid lookup) with a biased
+      random left/right decision
+    - Trajectory mode replaying a precomputed bounce arc
+    - Bin counting for the histogram and online distribution statistics
+    ======================================================================== */
+
+#include <string.h>   // memset()
+#include <math.h>     // sqrtf(), used once at initialization
+#include "inc/galton_simulation.h"
+
+#define MAX_BOUNCES_PER_STEP 4  // Bounces resolved within one step (one is enough up to MAX_STEP_SCALE)
+
+// === BALL POOL ===
+
+void ball_pool_init(ball_pool_t *pool) {
+    memset(pool->active, 0, sizeof(pool->active));
+
+    // Lowest indices on top of the stack, so live balls stay packed at the start of the arrays
+    for (int i = 0; i < BALL_POOL_CAPACITY; i++) {
+        pool->free_list[i] = (uint16_t)(BALL_POOL_CAPACITY - 1 - i);
+    }
+    pool->free_count = BALL_POOL_CAPACITY;
+    pool->active_count = 0;
+}
+
+int ball_pool_spawn(ball_pool_t *pool, int16_t x, int16_t y, int16_t vx, int16_t vy) {
+    if (pool->free_count == 0) {
+        return -1;  // Pool full
+    }
+
+    uint16_t idx = pool->free_list[--pool->free_count];
+    pool->x[idx] = x;
+    pool->y[idx] = y;
+    pool->vx[idx] = vx;
+    pool->vy[idx] = vy;
+    pool->active[idx >> 5] |= 1u << (idx & 31);
+    pool->active_count++;
+    return idx;
+}
+
+void ball_pool_retire(ball_pool_t *pool, uint16_t idx) {
+    pool->active[idx >> 5] &= ~(1u << (idx & 31));
+    pool->free_list[pool->free_count++] = idx;
+    pool->active_count--;
+}
+
+// === SIMULATION ===
+
+// xorshift32: same sequence on the host and on the RP2040, unlike rand()
+static inline uint32_t next_random(uint32_t *rng) {
+    uint32_t x = *rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *rng = x;
+    return x;
+}
+
+bool random_decision_with_bias(uint32_t *rng, uint8_t bias) {
+    uint32_t roll = (uint32_t)(((uint64_t)next_random(rng) * 100) >> 32);  // 0..99 without a division
+    return roll < (uint32_t)galton_bias_percent(bias);
+}
+
+void galton_seed(galton_sim_t *sim, uint32_t seed) {
+    sim->rng = seed ? seed : 0x9E3779B9u;  // xorshift must not start at 0
+}
+
+// Clamps to lo..hi; NaN fails both comparisons and gives lo
+static float clamp_float(float value, float lo, float hi) {
+    return value >= lo ? (value <= hi ? value : hi) : lo;
+}
+
+// Computes the bounce speeds so that a ball leaving a pin lands on a pin of the next row,
+// then rebuilds the arc table of the trajectory mode
+void galton_set_physics(galton_sim_t *sim, float gravity, float bounciness) {
+    gravity = clamp_float(gravity, MIN_GRAVITY, MAX_GRAVITY);          // Divided by below
+    bounciness = clamp_float(bounciness, MIN_BOUNCINESS, MAX_BOUNCINESS);
+    float spacing = sim->geom.spacing;
+    float impact = sqrtf(2.0f * gravity * spacing);  // Speed after falling one spacing
+    float up = bounciness * impact;                  // Upward speed after the bounce
+    float flight = (up + sqrtf(up * up + 2.0f * gravity * spacing)) / gravity; // Frames to the next row
+
+    sim->gravity = TO_FIXED(gravity);
+    sim->bounce_vy = TO_FIXED(up);
+    sim->bounce_vx = TO_FIXED((spacing / 2.0f) / flight);
+
+    sim->gravity_setting = gravity;
+    sim->bounciness_setting = bounciness;
+    trajectory_build(&sim->arc, sim->gravity, sim->bounce_vx, sim->bounce_vy, sim->geom.spacing);
+}
+
+int galton_set_geometry(galton_sim_t *sim, uint8_t rows, uint8_t spacing) {
+    int result = galton_geometry_build(&sim->geom, rows, spacing);
+    if (result != GALTON_GEOMETRY_OK) {
+        return result;
+    }
+
+    const galton_geometry_t *g = &sim->geom;
+    pin_grid_init(&sim->pins, g);
+    galton_set_physics(sim, sim->gravity_setting, sim->bounciness_setting);
+    histogram_init(&sim->histogram, g->bins, g->histogram_x + 1, g->spacing, g->spacing - 1,
+                   DISPLAY_HEIGHT - 1, g->histogram_height);
+    galton_reset(sim);
+    return GALTON_GEOMETRY_OK;
+}
+
+void galton_init(galton_sim_t *sim) {
+    sim->bias = DEFAULT_BIAS;
+    sim->balls_per_cycle = 1;
+    sim->mode = DEFAULT_SIM_MODE;
+    sim->gravity_setting = GRAVITY;
+    sim->bounciness_setting = BOUNCINESS;
+    sim->frame = 0;
+    sim->ticks = 0;
+    sim->step_scale = SIM_STEP_SCALE;
+    sim->collision = DEFAULT_COLLISION;
+    galton_seed(sim, 1);
+    galton_set_geometry(sim, DEFAULT_ROWS, DEFAULT_PIN_SPACING);
+}
+
+void galton_set_bias(galton_sim_t *sim, uint8_t bias) {
+    bias = bias > MAX_BIAS ? MAX_BIAS : bias;  // Keeps the probabilities in 5..95 %
+    sim->bias = bias;
+    galton_stats_set_bias(&sim->stats, bias, sim->histogram.counts);
+}
+
+void galton_update_theory_overlay(galton_sim_t *sim) {
+    for (int b = 0; b < sim->geom.bins; b++) {
+        uint8_t height = galton_stats_expected_height(&sim->stats, (uint8_t)b, sim->histogram.max,
+                                                      sim->histogram.max_height);
+        histogram_set_marker(&sim->histogram, (uint8_t)b, height);
+    }
+}
+
+void galton_set_step_scale(galton_sim_t *sim, uint8_t scale) {
+    sim->step_scale = scale < 1 ? 1 : (scale > MAX_STEP_SCALE ? MAX_STEP_SCALE : scale);
+}
+
+void galton_set_collision(galton_sim_t *sim, galton_collision_t collision) {
+    sim->collision = collision;
+}
+
+void galton_set_mode(galton_sim_t *sim, galton_mode_t mode) {
+    if (sim->mode != mode) {
+        sim->mode = mode;
+        ball_pool_init(&sim->balls);
+    }
+}
+
+void galton_reset(galton_sim_t *sim) {
+    ball_pool_init(&sim->balls);
+    histogram_reset(&sim->histogram);
+    galton_stats_init(&sim->stats, sim->geom.rows, sim->bias);
+    sim->pin_hits = 0;
+}
+
+int galton_spawn(galton_sim_t *sim, int n) {
+    int spawned = 0;
+    while (spawned < n) {
+        // Released with the same upward speed as a bounce, so every pin impact looks alike.
+        // In trajectory mode this is the bounce arc with no sideways motion (direction 0, frame 0).
+        int16_t vy = sim->mode == GALTON_MODE_TRAJECTORY ? 0 : -sim->bounce_vy;
+        if (ball_pool_spawn(&sim->balls, sim->geom.spawn_x_fixed, sim->geom.spawn_y_fixed, 0, vy) < 0) {
+            break;
+        }
+        spawned++;
+    }
+    return spawned;
+}
+
+int galton_release_cycle(galton_sim_t *sim) {
+    return galton_spawn(sim, sim->balls_per_cycle);
+}
+
+void galton_frame(galton_sim_t *sim) {
+    // One cycle per FRAMES_PER_CYCLE base steps, whatever the step scale (at most the cycle length)
+    if (sim->ticks % FRAMES_PER_CYCLE < sim->step_scale) {
+        galton_release_cycle(sim);
+    }
+    galton_update(sim);
+    sim->frame++;
+    sim->ticks += sim->step_scale;
+}
+
+void galton_button_a(galton_sim_t *sim) {
+    sim->balls_per_cycle = sim->balls_per_cycle % MAX_BALLS_PER_CYCLE + 1;
+}
+
+void galton_button_b(galton_sim_t *sim) {
+    galton_set_bias(sim, (sim->bias + 1) % (MAX_BIAS + 1));
+}
+
+// Adds a ball to the histogram and frees its slot
+static void collect_ball(galton_sim_t *sim, uint16_t idx, int16_t x) {
+    int bin = (x - sim->geom.bins_left_fixed) / sim->geom.spacing_fixed;
+    if (bin < 0) {
+        bin = 0;
+    } else if (bin >= sim->geom.bins) {
+        bin = sim->geom.bins - 1;
+    }
+    histogram_add(&sim->histogram, (uint8_t)bin);
+    galton_stats_add(&sim->stats, (uint8_t)bin, sim->histogram.counts[bin]);
+    ball_pool_retire(&sim->balls, idx);
+}
+
+// Trajectory mode: one table step per ball, a random decision only when a row is reached
+static void update_trajectory(galton_sim_t *sim) {
+    ball_pool_t *pool = &sim->balls;
+    const int16_t half_spacing = sim->geom.half_spacing_fixed;
+    const int16_t spacing = sim->geom.spacing_fixed;
+    const int16_t bin_top = sim->geom.bin_top_fixed;
+
+    for (int w = 0; w < BALL_POOL_WORDS; w++) {
+        uint32_t bits = pool->active[w];
+        while (bits) {
+            uint16_t i = (uint16_t)(w * 32 + __builtin_ctz(bits));
+            bits &= bits - 1;
+
+            int16_t frame = pool->vy[i] + sim->step_scale;
+            if (frame < sim->arc.length) {
+                pool->vy[i] = frame;
+                continue;
+            }
+
+            // Arc complete: the ball now sits on the next row (frames beyond it carry over)
+            int16_t x = pool->x[i];
+            int16_t y = pool->y[i];
+            int16_t dir = pool->vx[i];
+            bool landed = false;
+            while (frame >= sim->arc.length) {
+                frame -= sim->arc.length;
+                x += dir * half_spacing;
+                y += spacing;
+                if (y >= bin_top) {
+                    landed = true;
+                    break;
+                }
+                dir = random_decision_with_bias(&sim->rng, sim->bias) ? 1 : -1;
+                sim->pin_hits++;
+            }
+            if (landed) {
+                collect_ball(sim, i, x);
+                continue;
+            }
+
+            pool->x[i] = x;
+            pool->y[i] = y;
+            pool->vx[i] = dir;
+            pool->vy[i] = frame;
+        }
+    }
+}
+
+void galton_update(galton_sim_t *sim) {
+    ball_pool_t *pool = &sim->balls;
+    if (pool->active_count == 0) {
+        return;
+    }
+    if (sim->mode == GALTON_MODE_TRAJECTORY) {
+        update_trajectory(sim);
+        return;
+    }
+    const int16_t bin_top = sim->geom.bin_top_fixed;
+    const int32_t step_q8 = (int32_t)sim->step_scale << 8;
+    const int32_t vy_gain = sim->gravity * sim->step_scale;                   // g t
+    const int32_t step_drop = (sim->gravity * sim->step_scale * sim->step_scale) >> 1;  // g t^2 / 2
+
+    // Walks the bitmap word by word; balls are visited in increasing index order
+    for (int w = 0; w < BALL_POOL_WORDS; w++) {
+        uint32_t bits = pool->active[w];
+        while (bits) {
+            uint16_t i = (uint16_t)(w * 32 + __builtin_ctz(bits));
+            bits &= bits - 1;  // Clears the lowest set bit
+
+            int32_t x = pool->x[i];
+            int32_t y = pool->y[i];
+            int32_t vx = pool->vx[i];
+            int32_t vy = pool->vy[i];
+            int16_t pin_x, pin_y;
+
+            if (sim->collision == GALTON_COLLISION_SWEPT && vy + vy_gain > sim->bounce_vy) {
+                // Bounce at the exact time of impact, then fly the rest of the step
+                int32_t remaining = step_q8;
+                int32_t t;
+                for (int b = 0; b < MAX_BOUNCES_PER_STEP && remaining > 0; b++) {
+                    if (!pin_grid_sweep(&sim->pins, (int16_t)x, (int16_t)y, (int16_t)vx, (int16_t)vy, sim->gravity,
+                                        sim->bounce_vy, remaining, &t, &pin_x, &pin_y)) {
+                        break;
+                    }
+                    x = pin_x;
+                    y = pin_y;
+                    vy = -sim->bounce_vy;
+                    vx = random_decision_with_bias(&sim->rng, sim->bias) ? sim->bounce_vx : -sim->bounce_vx;
+                    remaining -= t;
+                    sim->pin_hits++;
+                }
+                ballistic_advance(&x, &y, &vy, vx, sim->gravity, remaining);
+            } else {
+                // Whole step, with the per-step constants
+                x += vx * sim->step_scale;
+                y += vy * sim->step_scale + step_drop;
+                vy += vy_gain;
+
+                // Only a falling ball faster than a bounce can hit a pin; this keeps a
+                // ball from hitting the pin it just left when it comes back down
+                if (sim->collision == GALTON_COLLISION_DISCRETE && vy > sim->bounce_vy &&
+                    pin_grid_find_hit(&sim->pins, (int16_t)x, (int16_t)y, &pin_x, &pin_y)) {
+                    x = pin_x;
+                    y = pin_y;
+                    vy = -sim->bounce_vy;
+                    vx = random_decision_with_bias(&sim->rng, sim->bias) ? sim->bounce_vx : -sim->bounce_vx;
+                    sim->pin_hits++;
+                }
+            }
+
+            // Side walls
+            if (x < 0) {
+                x = 0;
+            } else if (x > TO_FIXED(DISPLAY_WIDTH - 1)) {
+                x = TO_FIXED(DISPLAY_WIDTH - 1);
+            }
+
+            // Ball reached the receptacles
+            if (y >= bin_top) {
+                collect_ball(sim, i, (int16_t)x);
+                continue;
+            }
+
+            pool->x[i] = (int16_t)x;
+            pool->y[i] = (int16_t)y;
+            pool->vx[i] = (int16_t)vx;
+            pool->vy[i] = (int16_t)vy;
+        }
+    }
+}
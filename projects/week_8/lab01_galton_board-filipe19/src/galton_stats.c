@@ -0,0 +1,101 @@
+// Embarcatech, May 2025 - "Digital Galton Board" online statistics
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Implementation notes:
+    - The moments come from the power sums S1, S2, S3 of the bin index:
+        mean = S1/n, var = S2/n - mean^2,
+        skew = (S3/n - 3 mean S2/n + 2 mean^3) / var^1.5
+    - Chi-square uses sum((O - E)^2 / E) = sum(O^2 / (n p)) - n, so each
+      ball only adds (2 O - 1) / p for the bin it landed in; the "- n" is
+      subtracted in integers to avoid cancellation
+    - Floating point is only used when the bias changes and when the
+      summary is requested
+    ======================================================================== */
+
+#include <string.h>   // memset()
+#include <math.h>     // sqrtf(), pow()
+#include "inc/galton_stats.h"
+
+// Saturating add: a grossly mismatched bias only pins chi-square at its maximum
+static uint64_t add_saturated(uint64_t a, uint64_t b) {
+    return a + b < a ? UINT64_MAX : a + b;
+}
+
+// Binomial(rows, p) into the Q16 and 1/p tables
+static void build_theory(galton_stats_t *st) {
+    double p = galton_bias_percent(st->bias) / 100.0;
+    double binom = 1.0;  // C(N, k), built incrementally
+
+    for (int k = 0; k <= st->rows; k++) {
+        double pk = binom * pow(p, k) * pow(1.0 - p, st->rows - k);
+        st->theory_q16[k] = (uint32_t)(pk * STATS_Q16_ONE + 0.5);
+
+        double inv = (1 << STATS_INV_P_SHIFT) / pk + 0.5;
+        st->inv_theory[k] = inv >= UINT32_MAX ? UINT32_MAX : (uint32_t)inv;
+
+        binom = binom * (st->rows - k) / (k + 1);
+    }
+}
+
+void galton_stats_init(galton_stats_t *st, uint8_t rows, uint8_t bias) {
+    memset(st, 0, sizeof(*st));
+    st->rows = rows > MAX_ROWS ? MAX_ROWS : rows;
+    st->bias = bias;
+    build_theory(st);
+}
+
+void galton_stats_set_bias(galton_stats_t *st, uint8_t bias, const uint32_t *counts) {
+    st->bias = bias;
+    build_theory(st);
+
+    st->sum_o2_inv_p = 0;
+    for (int k = 0; k <= st->rows; k++) {
+        uint64_t o2 = (uint64_t)counts[k] * counts[k];
+        uint64_t term = o2 > UINT64_MAX / st->inv_theory[k] ? UINT64_MAX : o2 * st->inv_theory[k];
+        st->sum_o2_inv_p = add_saturated(st->sum_o2_inv_p, term);
+    }
+}
+
+void galton_stats_add(galton_stats_t *st, uint8_t bin, uint32_t count) {
+    uint32_t k = bin;
+    st->n++;
+    st->sum1 += k;
+    st->sum2 += k * k;
+    st->sum3 += k * k * k;
+    st->sum_o2_inv_p = add_saturated(st->sum_o2_inv_p,
+                                     (uint64_t)(2 * count - 1) * st->inv_theory[bin]);  // O^2 - (O-1)^2
+}
+
+void galton_stats_summary(const galton_stats_t *st, galton_stats_summary_t *out) {
+    float p = galton_bias_percent(st->bias) / 100.0f;
+    out->theory_mean = st->rows * p;
+    out->theory_variance = st->rows * p * (1.0f - p);
+
+    if (st->n == 0) {
+        out->mean = out->variance = out->skewness = out->chi_square = 0.0f;
+        return;
+    }
+
+    float n = (float)st->n;
+    float m1 = st->sum1 / n;
+    float m2 = st->sum2 / n;
+    float m3 = st->sum3 / n;
+    float variance = m2 - m1 * m1;
+
+    out->mean = m1;
+    out->variance = variance;
+    out->skewness = variance > 0.0f ? (m3 - 3.0f * m1 * m2 + 2.0f * m1 * m1 * m1) / (variance * sqrtf(variance)) : 0.0f;
+    int64_t excess = (int64_t)(st->sum_o2_inv_p - ((uint64_t)st->n * st->n << STATS_INV_P_SHIFT));
+    out->chi_square = (float)excess / (1 << STATS_INV_P_SHIFT) / n;
+}
+
+uint8_t galton_stats_expected_height(const galton_stats_t *st, uint8_t bin,
+                                     uint32_t max_count, uint8_t max_height) {
+    if (max_count == 0) {
+        return 0;
+    }
+    uint64_t expected_q16 = (uint64_t)st->n * st->theory_q16[bin];  // n * p_k in Q16
+    uint64_t height = expected_q16 * max_height / ((uint64_t)max_count * STATS_Q16_ONE);
+    return height > max_height ? max_height : (uint8_t)height;
+}
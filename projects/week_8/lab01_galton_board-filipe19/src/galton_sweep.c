@@ -0,0 +1,103 @@
+// Embarcatech, May 2025 - "Digital Galton Board" parameter sweep
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    A run feeds GALTON_SWEEP_SPAWN_PER_STEP balls per step until the
+    requested count is in flight or landed, then steps until the board
+    is empty. galton_update() is the same code the live app runs; only
+    the release schedule and the rendering differ.
+    ======================================================================== */
+
+#include <stdio.h>    // snprintf()
+#include <string.h>   // memcpy()
+#include "inc/galton_sweep.h"
+
+uint32_t galton_sweep_count(const galton_sweep_grid_t *grid) {
+    return (uint32_t)grid->num_rows * grid->num_bias * grid->num_balls * grid->num_modes;
+}
+
+// Largest even spacing, up to the default, whose layout fits the display
+static uint8_t fitting_spacing(uint8_t rows) {
+    galton_geometry_t geom;
+    for (uint8_t spacing = DEFAULT_PIN_SPACING; spacing >= MIN_PIN_SPACING; spacing -= 2) {
+        if (galton_geometry_build(&geom, rows, spacing) == GALTON_GEOMETRY_OK) {
+            return spacing;
+        }
+    }
+    return MIN_PIN_SPACING;  // Rejected later by galton_set_geometry()
+}
+
+void galton_sweep_config(const galton_sweep_grid_t *grid, uint32_t index, galton_sweep_config_t *config) {
+    config->mode = grid->modes[index % grid->num_modes];
+    index /= grid->num_modes;
+    config->balls = grid->balls[index % grid->num_balls];
+    index /= grid->num_balls;
+    config->bias = grid->bias[index % grid->num_bias];
+    index /= grid->num_bias;
+    config->rows = grid->rows[index];
+    config->spacing = fitting_spacing(config->rows);
+}
+
+void galton_sweep_run(const galton_sweep_config_t *config, uint32_t seed, galton_sim_t *sim,
+                      galton_sweep_result_t *result, uint32_t (*now_us)(void)) {
+    result->config = *config;
+    result->steps = 0;
+    result->wall_us = 0;
+    memset(result->counts, 0, sizeof(result->counts));
+
+    galton_init(sim);
+    result->status = galton_set_geometry(sim, config->rows, config->spacing);
+    if (result->status != GALTON_GEOMETRY_OK) {
+        galton_stats_summary(&sim->stats, &result->summary);
+        return;
+    }
+    galton_set_mode(sim, (galton_mode_t)config->mode);
+    galton_set_bias(sim, config->bias);
+    galton_seed(sim, seed);
+
+    uint32_t start = now_us();
+    uint32_t released = 0;
+    while (released < config->balls || sim->balls.active_count > 0) {
+        if (released < config->balls) {
+            uint32_t batch = config->balls - released;
+            released += galton_spawn(sim, batch > GALTON_SWEEP_SPAWN_PER_STEP ? GALTON_SWEEP_SPAWN_PER_STEP : (int)batch);
+        }
+        galton_update(sim);
+        result->steps++;
+    }
+    result->wall_us = now_us() - start;
+
+    memcpy(result->counts, sim->histogram.counts, sim->geom.bins * sizeof(uint32_t));
+    galton_stats_summary(&sim->stats, &result->summary);
+}
+
+void galton_sweep_worker(const galton_sweep_grid_t *grid, uint32_t worker, uint32_t workers,
+                         galton_sim_t *sim, galton_sweep_result_t *results, uint32_t (*now_us)(void)) {
+    uint32_t count = galton_sweep_count(grid);
+    for (uint32_t i = worker; i < count; i += workers) {
+        galton_sweep_config_t config;
+        galton_sweep_config(grid, i, &config);
+        galton_sweep_run(&config, 0x1000u + i, sim, &results[i], now_us);  // Seed fixed per configuration
+    }
+}
+
+const char *galton_sweep_csv_header(void) {
+    return "rows,spacing,bias,mode,balls,status,steps,wall_us,balls_per_s,"
+           "mean,theory_mean,variance,theory_variance,skewness,chi2,histogram";
+}
+
+int galton_sweep_csv(const galton_sweep_result_t *result, char *line, size_t size) {
+    const galton_sweep_config_t *c = &result->config;
+    const galton_stats_summary_t *s = &result->summary;
+    uint32_t balls_per_s = result->wall_us ? (uint32_t)((uint64_t)c->balls * 1000000u / result->wall_us) : 0;
+
+    int n = snprintf(line, size, "%u,%u,%u,%u,%lu,%d,%lu,%lu,%lu,%.4f,%.4f,%.4f,%.4f,%.4f,%.3f,",
+                     c->rows, c->spacing, c->bias, c->mode, (unsigned long)c->balls, result->status,
+                     (unsigned long)result->steps, (unsigned long)result->wall_us,
+                     (unsigned long)balls_per_s, s->mean, s->theory_mean, s->variance,
+                     s->theory_variance, s->skewness, s->chi_square);
+    for (int b = 0; b <= c->rows && b < MAX_BINS && n > 0 && (size_t)n < size; b++) {
+        n += snprintf(line + n, size - n, b ? ";%lu" : "%lu", (unsigned long)result->counts[b]);
+    }
+    return n;
+}
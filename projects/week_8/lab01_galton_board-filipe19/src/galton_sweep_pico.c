@@ -0,0 +1,65 @@
+// Embarcatech, May 2025 - "Digital Galton Board" parameter sweep --- Author: Filipe Alves de Sousa
+// Headless firmware: runs the sweep grid on both RP2040 cores and prints the CSV on USB serial.
+// Send 'r' on the serial port to run the grid again.
+//----------------------------------------------------------------------------------------------
+
+#include <stdio.h>             // printf()
+#include "pico/stdlib.h"       // Pico SDK utilities (time, stdio)
+#include "pico/multicore.h"    // Second core and inter-core FIFO
+#include "inc/galton_sweep.h"
+
+#define SWEEP_DONE 0x5EEDu     // Pushed by core 1 when its share of the grid is finished
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+static const uint8_t sweep_rows[] = { 2, 4, 6, 8, 10 };
+static const uint8_t sweep_bias[] = { 0, 5, 10 };
+static const uint32_t sweep_balls[] = { 1000, 10000 };
+static const uint8_t sweep_modes[] = { GALTON_MODE_PHYSICS, GALTON_MODE_TRAJECTORY };
+
+static const galton_sweep_grid_t grid = {
+    sweep_rows, COUNT_OF(sweep_rows), sweep_bias, COUNT_OF(sweep_bias),
+    sweep_balls, COUNT_OF(sweep_balls), sweep_modes, COUNT_OF(sweep_modes)
+};
+
+#define SWEEP_CONFIGS (COUNT_OF(sweep_rows) * COUNT_OF(sweep_bias) * COUNT_OF(sweep_balls) * COUNT_OF(sweep_modes))
+
+static galton_sim_t core_sim[2];                      // One scratch simulation per core
+static galton_sweep_result_t results[SWEEP_CONFIGS];
+
+// === FUNCTION: Core 1 entry: runs the odd configurations ===
+void core1_entry() {
+    galton_sweep_worker(&grid, 1, 2, &core_sim[1], results, time_us_32);
+    multicore_fifo_push_blocking(SWEEP_DONE);
+}
+
+// === FUNCTION: Runs the whole grid on both cores and prints it ===
+void run_sweep() {
+    uint32_t start = time_us_32();
+    multicore_reset_core1();
+    multicore_launch_core1(core1_entry);
+    galton_sweep_worker(&grid, 0, 2, &core_sim[0], results, time_us_32);
+    multicore_fifo_pop_blocking();  // Waits for core 1
+    uint32_t elapsed = time_us_32() - start;
+
+    char line[GALTON_SWEEP_CSV_LINE];
+    printf("%s\n", galton_sweep_csv_header());
+    for (uint32_t i = 0; i < galton_sweep_count(&grid); i++) {
+        galton_sweep_csv(&results[i], line, sizeof(line));
+        printf("%s\n", line);
+    }
+    printf("# %lu configurations on 2 cores in %lu ms\n",
+           (unsigned long)galton_sweep_count(&grid), (unsigned long)(elapsed / 1000));
+}
+
+// === MAIN FUNCTION ===
+int main() {
+    stdio_init_all();
+    sleep_ms(2000);  // Time for the USB serial port to be opened
+
+    run_sweep();
+    while (true) {
+        if (getchar_timeout_us(100000) == 'r') {
+            run_sweep();
+        }
+    }
+}
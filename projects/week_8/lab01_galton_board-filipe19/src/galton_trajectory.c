@@ -0,0 +1,31 @@
+// Embarcatech, May 2025 - "Digital Galton Board" trajectory tables
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Builds the per-frame offset table of the bounce arc. Runs at startup
+    and whenever a physics parameter changes, never in the frame loop.
+    ======================================================================== */
+
+#include "inc/galton_trajectory.h"
+#include "inc/galton_collision.h"   // ballistic_advance()
+
+void trajectory_build(trajectory_table_t *table, int16_t gravity, int16_t bounce_vx, int16_t bounce_vy,
+                      uint8_t spacing) {
+    // Same integration as galton_update(), one base step at a time
+    int32_t x = 0, y = 0;
+    int32_t vy = -bounce_vy;
+    int frame = 0;
+
+    table->dx[0] = 0;
+    table->dy[0] = 0;
+
+    // The arc ends on the step that reaches the next row
+    while (frame < TRAJECTORY_MAX_FRAMES - 1 && y < TO_FIXED(spacing)) {
+        ballistic_advance(&x, &y, &vy, bounce_vx, gravity, 1 << 8);
+        frame++;
+        table->dx[frame] = (int8_t)FROM_FIXED(x);
+        table->dy[frame] = (int8_t)FROM_FIXED(y);
+    }
+
+    table->length = (uint8_t)frame;
+}
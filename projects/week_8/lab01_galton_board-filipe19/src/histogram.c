@@ -0,0 +1,148 @@
+// Embarcatech, May 2025 - Incremental bar-chart histogram
+// Author: Filipe Alves de Sousa
+/* ========================================================================
+
+    Change-only redraw of an auto-normalized histogram:
+    - histogram_add() marks the bin dirty, or every bin when the maximum
+      (and therefore the scale) changes
+    - histogram_draw() recomputes the height of dirty bins only and writes
+      the rows between the old and the new height, one page byte at a time
+    - Markers are XOR-drawn: erased before the bar changes, drawn after it
+    ======================================================================== */
+
+#include <string.h>   // memset()
+#include "inc/histogram.h"
+
+#define FB_WIDTH 128  // SSD1306 framebuffer width (bytes per page)
+#define ALL_BINS(h) ((h)->num_bins >= 32 ? 0xFFFFFFFFu : ((1u << (h)->num_bins) - 1u))
+
+void histogram_init(histogram_t *h, uint8_t num_bins, uint8_t x, uint8_t bin_width,
+                    uint8_t bar_width, uint8_t base_y, uint8_t max_height) {
+    h->num_bins = num_bins > HISTOGRAM_MAX_BINS ? HISTOGRAM_MAX_BINS : num_bins;
+    h->x = x;
+    h->bin_width = bin_width;
+    h->bar_width = bar_width;
+    h->base_y = base_y;
+    h->max_height = max_height;
+    memset(h->drawn, 0, sizeof(h->drawn));  // The area is assumed blank
+    memset(h->marker, 0, sizeof(h->marker));
+    memset(h->marker_drawn, 0, sizeof(h->marker_drawn));
+    histogram_reset(h);
+}
+
+void histogram_reset(histogram_t *h) {
+    memset(h->counts, 0, sizeof(h->counts));
+    h->max = 0;
+    h->total = 0;
+    h->dirty = ALL_BINS(h);
+    h->last_bars_drawn = 0;
+    h->last_bytes_drawn = 0;
+}
+
+void histogram_add(histogram_t *h, uint8_t bin) {
+    if (bin >= h->num_bins) {
+        return;
+    }
+
+    uint32_t count = ++h->counts[bin];
+    h->total++;
+    if (count > h->max) {
+        h->max = count;
+        h->dirty = ALL_BINS(h);  // Scale changed: every height may change
+    } else {
+        h->dirty |= 1u << bin;
+    }
+}
+
+void histogram_set_marker(histogram_t *h, uint8_t bin, uint8_t height) {
+    if (bin >= h->num_bins) {
+        return;
+    }
+    if (height > h->max_height) {
+        height = h->max_height;
+    }
+    if (h->marker[bin] != height) {
+        h->marker[bin] = height;
+        h->dirty |= 1u << bin;
+    }
+}
+
+void histogram_invalidate(histogram_t *h) {
+    memset(h->drawn, 0, sizeof(h->drawn));
+    memset(h->marker_drawn, 0, sizeof(h->marker_drawn));
+    h->dirty = ALL_BINS(h);
+}
+
+uint8_t histogram_bar_height(const histogram_t *h, uint8_t bin) {
+    if (h->max == 0) {
+        return 0;
+    }
+    return (uint8_t)((uint64_t)h->counts[bin] * h->max_height / h->max);
+}
+
+// Sets or clears rows [y_top, y_bottom) of a bar, one byte per page and column
+static int fill_rows(const histogram_t *h, uint8_t *buffer, int x0, int y_top, int y_bottom, bool set) {
+    int bytes = 0;
+    for (int page = y_top >> 3; page <= (y_bottom - 1) >> 3; page++) {
+        int first = page * 8 > y_top ? page * 8 : y_top;
+        int last = page * 8 + 8 < y_bottom ? page * 8 + 8 : y_bottom;
+        uint8_t mask = (uint8_t)(((1u << (last - first)) - 1u) << (first & 7));
+
+        uint8_t *column = buffer + page * FB_WIDTH + x0;
+        for (int i = 0; i < h->bar_width; i++) {
+            column[i] = set ? (column[i] | mask) : (column[i] & ~mask);
+        }
+        bytes += h->bar_width;
+    }
+    return bytes;
+}
+
+// Inverts the top row of a bar of the given height across the bar width
+static int toggle_marker(const histogram_t *h, uint8_t *buffer, int x0, uint8_t height) {
+    int y = h->base_y + 1 - height;
+    uint8_t *column = buffer + (y >> 3) * FB_WIDTH + x0;
+    uint8_t mask = (uint8_t)(1u << (y & 7));
+    for (int i = 0; i < h->bar_width; i++) {
+        column[i] ^= mask;
+    }
+    return h->bar_width;
+}
+
+int histogram_draw(histogram_t *h, uint8_t *buffer) {
+    int bars = 0;
+    int bytes = 0;
+    uint32_t dirty = h->dirty;
+
+    while (dirty) {
+        uint8_t bin = (uint8_t)__builtin_ctz(dirty);
+        dirty &= dirty - 1;
+
+        uint8_t height = histogram_bar_height(h, bin);
+        uint8_t old = h->drawn[bin];
+        if (height == old && h->marker[bin] == h->marker_drawn[bin]) {
+            continue;
+        }
+
+        int x0 = h->x + bin * h->bin_width;
+        int base = h->base_y + 1;  // Exclusive bottom row
+        if (h->marker_drawn[bin]) {
+            bytes += toggle_marker(h, buffer, x0, h->marker_drawn[bin]);  // Restores the bar pixels
+        }
+        if (height > old) {
+            bytes += fill_rows(h, buffer, x0, base - height, base - old, true);
+        } else if (height < old) {
+            bytes += fill_rows(h, buffer, x0, base - old, base - height, false);
+        }
+        if (h->marker[bin]) {
+            bytes += toggle_marker(h, buffer, x0, h->marker[bin]);
+        }
+        h->drawn[bin] = height;
+        h->marker_drawn[bin] = h->marker[bin];
+        bars++;
+    }
+
+    h->dirty = 0;
+    h->last_bars_drawn = (uint16_t)bars;
+    h->last_bytes_drawn = (uint16_t)bytes;
+    return bytes;
+}
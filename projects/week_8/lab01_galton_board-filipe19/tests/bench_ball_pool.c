@@ -0,0 +1,55 @@
+// Embarcatech, May 2025 - "Digital Galton Board" ball pool benchmark (host)
+// Author: Filipe Alves de Sousa
+// Measures the cost of galton_update() as the number of balls in flight grows,
+// in physics and trajectory mode, and reports the memory used per ball slot.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -I. tests/bench_ball_pool.c src/galton_simulation.c src/galton_geometry.c src/galton_collision.c src/galton_trajectory.c src/histogram.c src/galton_stats.c -lm -o bench_ball_pool
+//   ./bench_ball_pool
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <time.h>      // clock_gettime()
+#include "inc/galton_simulation.h"
+
+#define BENCH_FRAMES 2000  // Frames simulated per measurement
+
+static galton_sim_t sim;
+
+// Monotonic time in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Keeps `balls` in flight for BENCH_FRAMES frames and returns the mean time per frame
+static double measure(galton_mode_t mode, int balls) {
+    galton_init(&sim);
+    galton_set_mode(&sim, mode);
+    galton_spawn(&sim, balls);
+
+    double start = now_ns();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        galton_update(&sim);
+        // Refill the pool so the load stays constant
+        galton_spawn(&sim, balls - sim.balls.active_count);
+    }
+    return (now_ns() - start) / BENCH_FRAMES;
+}
+
+int main(void) {
+    printf("===== BALL POOL BENCHMARK =====\n");
+    printf("Capacity: %d balls | Pool size: %zu bytes\n", BALL_POOL_CAPACITY, sizeof(ball_pool_t));
+    printf("Memory per ball: %.3f bytes (%zu bytes of state)\n\n",
+           BALL_POOL_BYTES_PER_BALL, BALL_STATE_BYTES);
+
+    printf("%-8s %-14s %-12s %-14s %-12s\n", "Balls", "physics ns", "ns/ball", "trajectory ns", "ns/ball");
+    for (int balls = 1; balls <= BALL_POOL_CAPACITY; balls *= 2) {
+        double physics_ns = measure(GALTON_MODE_PHYSICS, balls);
+        double trajectory_ns = measure(GALTON_MODE_TRAJECTORY, balls);
+        printf("%-8d %-14.0f %-12.1f %-14.0f %-12.1f\n", balls,
+               physics_ns, physics_ns / balls, trajectory_ns, trajectory_ns / balls);
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Embarcatech, May 2025 - "Digital Galton Board" collision benchmark (host)
+// Author: Filipe Alves de Sousa
+// Compares the cost of the physics mode with the discrete pin test at the base
+// step against the swept test at 1x..8x steps. Times are per simulated base
+// step, so a longer step that stays correct shows up as a lower cost.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -I. tests/bench_collision.c src/galton_simulation.c src/galton_geometry.c src/galton_collision.c src/galton_trajectory.c src/histogram.c src/galton_stats.c -lm -o bench_collision
+//   ./bench_collision
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <time.h>      // clock_gettime()
+#include "inc/galton_simulation.h"
+
+#define BENCH_TICKS 4096  // Base steps simulated per measurement
+
+static galton_sim_t sim;
+
+// Monotonic time in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Keeps `balls` in flight for BENCH_TICKS base steps and returns the mean time per base step
+static double measure(galton_collision_t collision, uint8_t scale, int balls) {
+    galton_init(&sim);
+    galton_set_collision(&sim, collision);
+    galton_set_step_scale(&sim, scale);
+    galton_spawn(&sim, balls);
+
+    double start = now_ns();
+    for (int t = 0; t < BENCH_TICKS; t += scale) {
+        galton_update(&sim);
+        // Refill the pool so the load stays constant
+        galton_spawn(&sim, balls - sim.balls.active_count);
+    }
+    return (now_ns() - start) / BENCH_TICKS;
+}
+
+int main(void) {
+    static const uint8_t scales[] = { 1, 2, 4, 8 };
+
+    printf("===== COLLISION BENCHMARK (ns per simulated base step) =====\n");
+    printf("%-8s %-12s", "Balls", "discrete 1x");
+    for (unsigned s = 0; s < sizeof(scales); s++) {
+        printf(" swept %ux    ", scales[s]);
+    }
+    printf("\n");
+
+    for (int balls = 64; balls <= BALL_POOL_CAPACITY; balls *= 4) {
+        printf("%-8d %-12.0f", balls, measure(GALTON_COLLISION_DISCRETE, 1, balls));
+        for (unsigned s = 0; s < sizeof(scales); s++) {
+            printf(" %-12.0f", measure(GALTON_COLLISION_SWEPT, scales[s], balls));
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,253 @@
+// Embarcatech, May 2025 - SSD1306 dither check and benchmark (host)
+// Author: Filipe Alves de Sousa
+// Checks the streaming dither against full-frame references (Bayer pixel for
+// pixel; Floyd-Steinberg against a two-dimensional error buffer with the same
+// fixed-point shares), checks that both modes keep the mean gray level, then
+// times them against a per-pixel float Floyd-Steinberg on full frames.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -I. tests/bench_dither.c inc/ssd1306_dither.c -o bench_dither
+//   ./bench_dither   (exit code 0 when the checks pass)
+// On the RP2040, the dither_bench firmware (src/dither_bench_pico.c) prints the same timing.
+//-----------------------------------------------------------------------------
+
+#include <stdbool.h>   // bool type
+#include <stdio.h>     // printf()
+#include <string.h>    // memcmp(), memset()
+#include <time.h>      // clock_gettime()
+#include "inc/ssd1306_dither.h"
+
+#define WIDTH 128
+#define HEIGHT 64
+#define FRAME_BYTES (WIDTH * HEIGHT / 8)
+#define BENCH_FRAMES 2000  // Frames dithered per measurement
+
+static uint8_t gray[HEIGHT][WIDTH];
+static uint8_t expected[FRAME_BYTES];
+static uint8_t actual[FRAME_BYTES];
+static uint32_t rng = 2025;
+
+static uint8_t next_byte(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (uint8_t)rng;
+}
+
+// Monotonic time in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Smooth test image: horizontal ramp plus a bright blob, like a sensor heatmap
+static void make_heatmap(void) {
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            int dx = x - 80, dy = y - 28;
+            int blob = 180 - (dx * dx + dy * dy) / 6;
+            int value = x * 2 + (blob > 0 ? blob : 0);
+            gray[y][x] = (uint8_t)(value > 255 ? 255 : value);
+        }
+    }
+}
+
+static void dither_frame(uint8_t *pages, ssd1306_dither_mode_t mode, int width, int height) {
+    ssd1306_dither_t d;
+    ssd1306_dither_init(&d, pages, width, height, mode);
+    for (int y = 0; y < height; y++) {
+        ssd1306_dither_row(&d, gray[y]);
+    }
+}
+
+// === Full-frame references ===
+
+// Page-format pixel write as ssd1306_set_pixel(): divide and modulo per pixel
+static void set_page_pixel(uint8_t *pages, int width, int x, int y) {
+    pages[(y / 8) * width + x] |= (uint8_t)(1 << (y % 8));
+}
+
+static int count_lit(const uint8_t *pages, int bytes) {
+    int lit = 0;
+    for (int i = 0; i < bytes; i++) {
+        lit += __builtin_popcount(pages[i]);
+    }
+    return lit;
+}
+
+static void bayer_reference(uint8_t *pages, int width, int height) {
+    static const int index[8][8] = {
+        {  0, 32,  8, 40,  2, 34, 10, 42 }, { 48, 16, 56, 24, 50, 18, 58, 26 },
+        { 12, 44,  4, 36, 14, 46,  6, 38 }, { 60, 28, 52, 20, 62, 30, 54, 22 },
+        {  3, 35, 11, 43,  1, 33,  9, 41 }, { 51, 19, 59, 27, 49, 17, 57, 25 },
+        { 15, 47,  7, 39, 13, 45,  5, 37 }, { 63, 31, 55, 23, 61, 29, 53, 21 }
+    };
+    memset(pages, 0, (size_t)width * ((height + 7) / 8));
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (gray[y][x] > index[y % 8][x % 8] * 4 + 2) {
+                set_page_pixel(pages, width, x, y);
+            }
+        }
+    }
+}
+
+// Same fixed-point shares as the library, with a whole frame of error
+static void floyd_reference(uint8_t *pages, int width, int height) {
+    static int error[HEIGHT + 1][WIDTH + 2];
+    memset(error, 0, sizeof(error));
+    memset(pages, 0, (size_t)width * ((height + 7) / 8));
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int value = gray[y][x] * 16 + error[y][x + 1];
+            int lit = value >= 128 * 16;
+            int e = lit ? value - 255 * 16 : value;
+            if (lit) {
+                set_page_pixel(pages, width, x, y);
+            }
+            error[y][x + 2] += (e * 7) >> 4;
+            error[y + 1][x] += (e * 3) >> 4;
+            error[y + 1][x + 1] += (e * 5) >> 4;
+            error[y + 1][x + 2] += e >> 4;
+        }
+        error[y + 1][width + 1] = 0;  // Shares past the right edge are dropped
+    }
+}
+
+// Textbook version: float error for the whole frame, then per-pixel writes
+static void floyd_float(uint8_t *pages) {
+    static float error[HEIGHT + 1][WIDTH + 2];
+    memset(error, 0, sizeof(error));
+    memset(pages, 0, FRAME_BYTES);
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            float value = gray[y][x] + error[y][x + 1];
+            float out = value >= 128.0f ? 255.0f : 0.0f;
+            float e = value - out;
+            if (out > 0) {
+                set_page_pixel(pages, WIDTH, x, y);
+            }
+            error[y][x + 2] += e * 7.0f / 16.0f;
+            error[y + 1][x] += e * 3.0f / 16.0f;
+            error[y + 1][x + 1] += e * 5.0f / 16.0f;
+            error[y + 1][x + 2] += e * 1.0f / 16.0f;
+        }
+    }
+}
+
+// === Checks ===
+
+static int check_references(void) {
+    static const int sizes[][2] = { { 128, 64 }, { 13, 11 }, { 1, 1 }, { 40, 9 }, { 128, 8 } };
+    for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int width = sizes[s][0], height = sizes[s][1];
+        size_t bytes = (size_t)width * ((height + 7) / 8);
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) {
+                gray[y][x] = next_byte();
+            }
+        }
+        for (int m = 0; m < 2; m++) {
+            ssd1306_dither_mode_t mode = m ? SSD1306_DITHER_FLOYD : SSD1306_DITHER_BAYER;
+            if (mode == SSD1306_DITHER_BAYER) {
+                bayer_reference(expected, width, height);
+            } else {
+                floyd_reference(expected, width, height);
+            }
+            memset(actual, 0xA5, FRAME_BYTES);  // Stale data must be overwritten, not merged
+            dither_frame(actual, mode, width, height);
+            if (memcmp(expected, actual, bytes) != 0) {
+                printf("  FAIL: %s %d x %d differs from the full-frame reference\n",
+                       m ? "Floyd-Steinberg" : "Bayer", width, height);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+// Flat fields: lit fraction within 2% of level / 255, exact at black and white
+static int check_levels(void) {
+    for (int level = 0; level <= 255; level += 5) {
+        memset(gray, level, sizeof(gray));
+        for (int m = 0; m < 2; m++) {
+            dither_frame(actual, m ? SSD1306_DITHER_FLOYD : SSD1306_DITHER_BAYER, WIDTH, HEIGHT);
+            double lit = (double)count_lit(actual, FRAME_BYTES) / (WIDTH * HEIGHT);
+            double wanted = level / 255.0;
+            bool edge = level == 0 || level == 255;
+            if ((edge && lit != wanted) || lit - wanted > 0.02 || wanted - lit > 0.02) {
+                printf("  FAIL: %s level %d lights %.3f of the pixels\n",
+                       m ? "Floyd-Steinberg" : "Bayer", level, lit);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int check_stream(void) {
+    ssd1306_dither_t d;
+    if (ssd1306_dither_init(&d, actual, SSD1306_DITHER_MAX_WIDTH + 1, 8, SSD1306_DITHER_BAYER) !=
+            SSD1306_DITHER_BAD_SIZE ||
+        ssd1306_dither_init(&d, actual, 16, 0, SSD1306_DITHER_BAYER) != SSD1306_DITHER_BAD_SIZE) {
+        printf("  FAIL: bad size accepted\n");
+        return 1;
+    }
+    ssd1306_dither_init(&d, actual, 16, 3, SSD1306_DITHER_FLOYD);
+    for (int y = 0; y < 3; y++) {
+        if (ssd1306_dither_row(&d, gray[y]) != SSD1306_DITHER_OK) {
+            printf("  FAIL: row %d refused\n", y);
+            return 1;
+        }
+    }
+    if (ssd1306_dither_row(&d, gray[3]) != SSD1306_DITHER_FULL) {
+        printf("  FAIL: row past the image accepted\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    int failures = check_references() + check_levels() + check_stream();
+    printf("Reference, level and streaming checks: %s\n\n", failures ? "FAIL" : "ok");
+
+    make_heatmap();
+    printf("===== DITHER BENCHMARK (128 x 64 frame) =====\n");
+    printf("%-30s %-12s %-10s\n", "Method", "us/frame", "Mpixel/s");
+
+    double t0 = now_ns();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        floyd_float(expected);
+    }
+    double t_float = (now_ns() - t0) / BENCH_FRAMES;
+
+    t0 = now_ns();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        bayer_reference(expected, WIDTH, HEIGHT);
+    }
+    double t_bayer_ref = (now_ns() - t0) / BENCH_FRAMES;
+
+    t0 = now_ns();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        dither_frame(actual, SSD1306_DITHER_FLOYD, WIDTH, HEIGHT);
+    }
+    double t_floyd = (now_ns() - t0) / BENCH_FRAMES;
+
+    t0 = now_ns();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        dither_frame(actual, SSD1306_DITHER_BAYER, WIDTH, HEIGHT);
+    }
+    double t_bayer = (now_ns() - t0) / BENCH_FRAMES;
+
+    const char *names[] = { "Floyd float, full frame", "Bayer per pixel", "Floyd fixed, streaming",
+                            "Bayer streaming" };
+    double times[] = { t_float, t_bayer_ref, t_floyd, t_bayer };
+    for (int i = 0; i < 4; i++) {
+        printf("%-30s %-12.2f %-10.1f\n", names[i], times[i] / 1000, WIDTH * HEIGHT / times[i] * 1000);
+    }
+    printf("\nState: %u bytes streaming vs %u bytes for a full grayscale frame\n",
+           (unsigned)sizeof(ssd1306_dither_t), (unsigned)(WIDTH * HEIGHT));
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,170 @@
+// Embarcatech, May 2025 - SSD1306 rasterizer check and benchmark (host)
+// Author: Filipe Alves de Sousa
+// Checks that every sprite stamp matches the filled shape it was built from,
+// at all 8 vertical bit offsets and across the screen edges, then times
+// pixel-by-pixel drawing (as ssd1306_set_pixel() does it) against the span
+// rasterizer and the pre-shifted sprites.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -I. tests/bench_raster.c inc/ssd1306_raster.c -o bench_raster
+//   ./bench_raster   (exit code 0 when the checks pass)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <string.h>    // memcmp(), memset()
+#include <time.h>      // clock_gettime()
+#include "inc/ssd1306_raster.h"
+
+#define FB_BYTES (SSD1306_RASTER_WIDTH * SSD1306_RASTER_HEIGHT / 8)
+#define BENCH_SHAPES 200000  // Shapes drawn per measurement
+
+static uint8_t expected[FB_BYTES];
+static uint8_t actual[FB_BYTES];
+
+// Monotonic time in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Same arithmetic as ssd1306_set_pixel() (divide and modulo per pixel), kept out of
+// line like the library call
+__attribute__((noinline)) static void set_pixel_reference(uint8_t *ssd, int x, int y) {
+    if (x < 0 || x >= SSD1306_RASTER_WIDTH || y < 0 || y >= SSD1306_RASTER_HEIGHT) {
+        return;
+    }
+    ssd[(y / 8) * SSD1306_RASTER_WIDTH + x] |= 1 << (y % 8);
+}
+
+// Circle pixel by pixel, same rule as the rasterizer (dx^2 + dy^2 <= r^2 + r)
+static void fill_circle_reference(uint8_t *ssd, int cx, int cy, int r) {
+    for (int dy = -r; dy <= r; dy++) {
+        for (int dx = -r; dx <= r; dx++) {
+            if (dx * dx + dy * dy <= r * r + r) {
+                set_pixel_reference(ssd, cx + dx, cy + dy);
+            }
+        }
+    }
+}
+
+// The Galton pin drawn as before (five set_pixel calls)
+static void draw_pin_reference(uint8_t *ssd, int x, int y) {
+    set_pixel_reference(ssd, x, y - 1);
+    set_pixel_reference(ssd, x - 1, y);
+    set_pixel_reference(ssd, x, y);
+    set_pixel_reference(ssd, x + 1, y);
+    set_pixel_reference(ssd, x, y + 1);
+}
+
+static int check(const char *what, int x, int y) {
+    if (memcmp(expected, actual, FB_BYTES) != 0) {
+        printf("  FAIL: %s at (%d, %d)\n", what, x, y);
+        return 1;
+    }
+    return 0;
+}
+
+// Stamps and fills the same shape at many positions, including off-screen ones
+static int check_positions(void) {
+    static const int xs[] = { -3, 0, 1, 60, 126, 127, 130 };
+    int failures = 0;
+    ssd1306_sprite_t circle[4], hexagon[4];
+    for (int r = 0; r < 4; r++) {
+        ssd1306_sprite_circle(&circle[r], r);
+        ssd1306_sprite_hexagon(&hexagon[r], r);
+    }
+
+    for (unsigned i = 0; i < sizeof(xs) / sizeof(xs[0]); i++) {
+        for (int y = -4; y < SSD1306_RASTER_HEIGHT + 4; y++) {
+            for (int r = 0; r < 4 && !failures; r++) {
+                memset(expected, 0, FB_BYTES);
+                memset(actual, 0, FB_BYTES);
+                fill_circle_reference(expected, xs[i], y, r);
+                ssd1306_fill_circle(actual, xs[i], y, r, true);
+                failures += check("fill_circle differs from the reference", xs[i], y);
+
+                memset(actual, 0, FB_BYTES);
+                ssd1306_draw_sprite(actual, &circle[r], xs[i], y, true);
+                failures += check("circle sprite differs from fill_circle", xs[i], y);
+
+                memset(expected, 0, FB_BYTES);
+                memset(actual, 0, FB_BYTES);
+                ssd1306_fill_hexagon(expected, xs[i], y, r, true);
+                ssd1306_draw_sprite(actual, &hexagon[r], xs[i], y, true);
+                failures += check("hexagon sprite differs from fill_hexagon", xs[i], y);
+
+                // Clearing with the sprite removes exactly what it drew
+                ssd1306_draw_sprite(actual, &hexagon[r], xs[i], y, false);
+                memset(expected, 0, FB_BYTES);
+                failures += check("hexagon sprite did not clear", xs[i], y);
+            }
+        }
+    }
+
+    // The radius-1 hexagon is the Galton pin
+    memset(expected, 0, FB_BYTES);
+    memset(actual, 0, FB_BYTES);
+    draw_pin_reference(expected, 40, 21);
+    ssd1306_draw_sprite(actual, &hexagon[1], 40, 21, true);
+    failures += check("radius-1 hexagon is not the pin shape", 40, 21);
+    return failures;
+}
+
+int main(void) {
+    int failures = check_positions();
+    printf("Sprite and span checks: %s\n\n", failures ? "FAIL" : "ok");
+
+    ssd1306_sprite_t pin, ball;
+    ssd1306_sprite_hexagon(&pin, 1);
+    ssd1306_sprite_circle(&ball, 3);
+
+    printf("===== RASTER BENCHMARK (ns per shape) =====\n");
+    printf("%-22s %-12s %-12s %-12s\n", "Shape", "per pixel", "spans", "sprite");
+
+    double t0 = now_ns();
+    for (int i = 0; i < BENCH_SHAPES; i++) {
+        draw_pin_reference(actual, 1 + i % 126, 1 + i % 62);
+    }
+    double t1 = now_ns();
+    for (int i = 0; i < BENCH_SHAPES; i++) {
+        ssd1306_fill_hexagon(actual, 1 + i % 126, 1 + i % 62, 1, true);
+    }
+    double t2 = now_ns();
+    for (int i = 0; i < BENCH_SHAPES; i++) {
+        ssd1306_draw_sprite(actual, &pin, 1 + i % 126, 1 + i % 62, true);
+    }
+    double t3 = now_ns();
+    printf("%-22s %-12.1f %-12.1f %-12.1f\n", "Pin (hexagon r=1)",
+           (t1 - t0) / BENCH_SHAPES, (t2 - t1) / BENCH_SHAPES, (t3 - t2) / BENCH_SHAPES);
+
+    t0 = now_ns();
+    for (int i = 0; i < BENCH_SHAPES; i++) {
+        fill_circle_reference(actual, 3 + i % 122, 3 + i % 58, 3);
+    }
+    t1 = now_ns();
+    for (int i = 0; i < BENCH_SHAPES; i++) {
+        ssd1306_fill_circle(actual, 3 + i % 122, 3 + i % 58, 3, true);
+    }
+    t2 = now_ns();
+    for (int i = 0; i < BENCH_SHAPES; i++) {
+        ssd1306_draw_sprite(actual, &ball, 3 + i % 122, 3 + i % 58, true);
+    }
+    t3 = now_ns();
+    printf("%-22s %-12.1f %-12.1f %-12.1f\n", "Ball (circle r=3)",
+           (t1 - t0) / BENCH_SHAPES, (t2 - t1) / BENCH_SHAPES, (t3 - t2) / BENCH_SHAPES);
+
+    t0 = now_ns();
+    for (int i = 0; i < BENCH_SHAPES / 100; i++) {
+        fill_circle_reference(actual, 64, 32, 24);
+    }
+    t1 = now_ns();
+    for (int i = 0; i < BENCH_SHAPES / 100; i++) {
+        ssd1306_fill_circle(actual, 64, 32, 24, true);
+    }
+    t2 = now_ns();
+    printf("%-22s %-12.1f %-12.1f %-12s\n", "Disc (circle r=24)",
+           (t1 - t0) / (BENCH_SHAPES / 100), (t2 - t1) / (BENCH_SHAPES / 100), "-");
+
+    return failures ? 1 : 0;
+}
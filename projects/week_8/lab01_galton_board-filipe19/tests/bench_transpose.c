@@ -0,0 +1,178 @@
+// Embarcatech, May 2025 - SSD1306 transpose check and benchmark (host)
+// Author: Filipe Alves de Sousa
+// Checks the 8x8 transpose kernel, the row-major import (XBM and PBM bit
+// order, odd sizes) and both panel rotations against per-pixel loops, then
+// times the kernel against those loops on full frames.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -I. tests/bench_transpose.c inc/ssd1306_transpose.c -o bench_transpose
+//   ./bench_transpose   (exit code 0 when the checks pass)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <string.h>    // memcmp(), memset()
+#include <time.h>      // clock_gettime()
+#include "inc/ssd1306_transpose.h"
+
+#define FRAME_BYTES (SSD1306_PANEL_WIDTH * SSD1306_PANEL_HEIGHT / 8)
+#define BENCH_FRAMES 2000  // Frames converted per measurement
+
+static uint8_t portrait[FRAME_BYTES];
+static uint8_t rows[FRAME_BYTES];
+static uint8_t expected[FRAME_BYTES];
+static uint8_t actual[FRAME_BYTES];
+static uint32_t rng = 2025;
+
+static uint8_t next_byte(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (uint8_t)rng;
+}
+
+// Monotonic time in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// === Per-pixel references ===
+
+static int page_pixel(const uint8_t *pages, int width, int x, int y) {
+    return (pages[(y / 8) * width + x] >> (y % 8)) & 1;
+}
+
+static void set_page_pixel(uint8_t *pages, int width, int x, int y) {
+    pages[(y / 8) * width + x] |= (uint8_t)(1 << (y % 8));
+}
+
+static void import_reference(uint8_t *pages, const uint8_t *in, int width, int height, bool msb_first) {
+    int row_bytes = (width + 7) / 8;
+    memset(pages, 0, (size_t)width * ((height + 7) / 8));
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t byte = in[y * row_bytes + x / 8];
+            if ((byte >> (msb_first ? 7 - x % 8 : x % 8)) & 1) {
+                set_page_pixel(pages, width, x, y);
+            }
+        }
+    }
+}
+
+// Panel pixel (X, Y) shows portrait pixel (Y, 127 - X) at 90 degrees, (63 - Y, X) at 270
+static void rotate_reference(uint8_t *panel, const uint8_t *in, ssd1306_rotation_t rotation) {
+    memset(panel, 0, FRAME_BYTES);
+    for (int y = 0; y < SSD1306_PANEL_HEIGHT; y++) {
+        for (int x = 0; x < SSD1306_PANEL_WIDTH; x++) {
+            int px = rotation == SSD1306_ROTATE_90 ? y : SSD1306_PORTRAIT_WIDTH - 1 - y;
+            int py = rotation == SSD1306_ROTATE_90 ? SSD1306_PORTRAIT_HEIGHT - 1 - x : x;
+            if (page_pixel(in, SSD1306_PORTRAIT_WIDTH, px, py)) {
+                set_page_pixel(panel, SSD1306_PANEL_WIDTH, x, y);
+            }
+        }
+    }
+}
+
+// === Checks ===
+
+static int check_kernel(void) {
+    for (int trial = 0; trial < 10000; trial++) {
+        uint8_t in[8], out[8];
+        for (int r = 0; r < 8; r++) {
+            in[r] = next_byte();
+        }
+        ssd1306_transpose8x8(in, 1, out, 1);
+        for (int r = 0; r < 8; r++) {
+            for (int c = 0; c < 8; c++) {
+                if (((in[r] >> c) & 1) != ((out[c] >> r) & 1)) {
+                    printf("  FAIL: transpose bit (%d, %d)\n", r, c);
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static int check_import(void) {
+    static const int sizes[][2] = { { 128, 64 }, { 8, 8 }, { 13, 11 }, { 1, 1 }, { 30, 17 }, { 64, 128 } };
+    for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int width = sizes[s][0], height = sizes[s][1];
+        for (int i = 0; i < FRAME_BYTES; i++) {
+            rows[i] = next_byte();
+        }
+        for (int msb = 0; msb < 2; msb++) {
+            import_reference(expected, rows, width, height, msb);
+            memset(actual, 0, FRAME_BYTES);
+            ssd1306_import_rows(actual, rows, width, height, msb);
+            if (memcmp(expected, actual, (size_t)width * ((height + 7) / 8)) != 0) {
+                printf("  FAIL: import %d x %d (%s)\n", width, height, msb ? "MSB first" : "LSB first");
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int check_rotation(void) {
+    for (int i = 0; i < FRAME_BYTES; i++) {
+        portrait[i] = next_byte();
+    }
+    for (int r = 0; r < 2; r++) {
+        ssd1306_rotation_t rotation = r ? SSD1306_ROTATE_270 : SSD1306_ROTATE_90;
+        rotate_reference(expected, portrait, rotation);
+        ssd1306_rotate_frame(actual, portrait, rotation);
+        if (memcmp(expected, actual, FRAME_BYTES) != 0) {
+            printf("  FAIL: rotation %d degrees\n", r ? 270 : 90);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    int failures = check_kernel() + check_import() + check_rotation();
+    printf("Kernel, import and rotation checks: %s\n\n", failures ? "FAIL" : "ok");
+
+    printf("===== TRANSPOSE BENCHMARK (us per 128 x 64 frame) =====\n");
+    printf("%-22s %-12s %-12s %-8s\n", "Conversion", "per pixel", "8x8 kernel", "speedup");
+
+    double t0 = now_ns();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        rotate_reference(expected, portrait, SSD1306_ROTATE_90);
+    }
+    double t1 = now_ns();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        ssd1306_rotate_frame(actual, portrait, SSD1306_ROTATE_90);
+    }
+    double t2 = now_ns();
+    printf("%-22s %-12.2f %-12.2f %-8.1f\n", "Rotate 90 degrees", (t1 - t0) / BENCH_FRAMES / 1000,
+           (t2 - t1) / BENCH_FRAMES / 1000, (t1 - t0) / (t2 - t1));
+
+    t0 = now_ns();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        import_reference(expected, rows, 128, 64, false);
+    }
+    t1 = now_ns();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        ssd1306_import_rows(actual, rows, 128, 64, false);
+    }
+    t2 = now_ns();
+    printf("%-22s %-12.2f %-12.2f %-8.1f\n", "Import XBM", (t1 - t0) / BENCH_FRAMES / 1000,
+           (t2 - t1) / BENCH_FRAMES / 1000, (t1 - t0) / (t2 - t1));
+
+    t0 = now_ns();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        import_reference(expected, rows, 128, 64, true);
+    }
+    t1 = now_ns();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        ssd1306_import_rows(actual, rows, 128, 64, true);
+    }
+    t2 = now_ns();
+    printf("%-22s %-12.2f %-12.2f %-8.1f\n", "Import PBM", (t1 - t0) / BENCH_FRAMES / 1000,
+           (t2 - t1) / BENCH_FRAMES / 1000, (t1 - t0) / (t2 - t1));
+
+    return failures ? 1 : 0;
+}
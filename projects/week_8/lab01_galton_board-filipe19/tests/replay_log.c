@@ -0,0 +1,261 @@
+// Embarcatech, May 2025 - "Digital Galton Board" log replayer (host)
+// Author: Filipe Alves de Sousa
+// Replays a log recorded on the board and prints the final histogram, its
+// checksum and the per-frame timing profile. Without arguments, records a
+// synthetic session, replays it and checks that both runs are identical, then
+// checks that a full recorder refuses every event after the first lost one and
+// that its log still ends and replays up to that event, and that logs with an
+// out-of-range header field or event value are rejected.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -I. tests/replay_log.c src/galton_replay.c src/galton_simulation.c src/galton_geometry.c src/galton_collision.c src/galton_trajectory.c src/histogram.c src/galton_stats.c -lm -o replay_log
+//   ./replay_log [log.bin | log.hex]
+// A ".hex" file is the text dump printed by the board after pressing 'd'.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf(), fopen()
+#include <stdlib.h>    // malloc()
+#include <string.h>    // strlen(), strcmp()
+#include <ctype.h>     // isxdigit()
+#include <time.h>      // clock_gettime()
+#include "inc/galton_replay.h"
+
+#define MAX_LOG_BYTES (1u << 20)
+#define MAX_PROFILE_FRAMES 100000
+#define SELFTEST_FRAMES 5000
+
+static galton_sim_t sim;
+static uint32_t frame_us[MAX_PROFILE_FRAMES];
+
+static uint32_t host_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000u + ts.tv_nsec / 1000);
+}
+
+// Reads a binary log, or a hex dump when the name ends in ".hex"
+static size_t load_log(const char *path, uint8_t *log) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return 0;
+    }
+
+    size_t length = 0;
+    size_t name_len = strlen(path);
+    if (name_len > 4 && strcmp(path + name_len - 4, ".hex") == 0) {
+        int c, high = -1;
+        while ((c = fgetc(f)) != EOF && length < MAX_LOG_BYTES) {
+            if (!isxdigit(c)) {
+                continue;
+            }
+            int nibble = isdigit(c) ? c - '0' : tolower(c) - 'a' + 10;
+            if (high < 0) {
+                high = nibble;
+            } else {
+                log[length++] = (uint8_t)(high << 4 | nibble);
+                high = -1;
+            }
+        }
+    } else {
+        length = fread(log, 1, MAX_LOG_BYTES, f);
+    }
+    fclose(f);
+    return length;
+}
+
+static void print_result(const galton_profile_t *profile) {
+    printf("Histogram:");
+    for (int b = 0; b < sim.geom.bins; b++) {
+        printf(" %lu", (unsigned long)sim.histogram.counts[b]);
+    }
+    printf("\nChecksum: %08lx\n", (unsigned long)galton_histogram_checksum(&sim));
+    printf("Frames: %lu | Events: %lu | Frame us min/avg/max: %lu / %.2f / %lu\n",
+           (unsigned long)profile->frames, (unsigned long)profile->events,
+           (unsigned long)profile->min_us,
+           profile->frames ? (double)profile->total_us / profile->frames : 0.0,
+           (unsigned long)profile->max_us);
+}
+
+// Records a session with scripted inputs, then replays its log
+static int self_test(void) {
+    static uint8_t log[4096];
+    galton_recorder_t rec;
+
+    galton_init(&sim);
+    galton_seed(&sim, 12345);
+    galton_set_step_scale(&sim, 3);      // Not the defaults: the replay must take them from the header
+    galton_set_collision(&sim, GALTON_COLLISION_DISCRETE);
+    galton_recorder_begin(&rec, log, sizeof(log), &sim, 12345);
+
+    // Live run: the same path as the main loop on the board
+    while (sim.frame < SELFTEST_FRAMES) {
+        uint8_t type = 0;
+        uint32_t value = 0;
+        if (sim.frame % 397 == 13) {
+            type = GALTON_EV_BUTTON_A;
+        } else if (sim.frame % 631 == 50) {
+            type = GALTON_EV_BUTTON_B;
+        } else if (sim.frame == 2500) {
+            type = GALTON_EV_SET_MODE;
+            value = GALTON_MODE_TRAJECTORY;
+        } else if (sim.frame == 3500) {
+            type = GALTON_EV_SET_GEOMETRY;
+            value = 9 | 4 << 8;  // 9 rows, 4 pixels apart
+        }
+        if (type) {
+            galton_recorder_event(&rec, sim.frame, type, value);
+            galton_apply_event(&sim, type, value);
+        }
+        galton_frame(&sim);
+    }
+    galton_recorder_end(&rec, sim.frame);
+    uint32_t live = galton_histogram_checksum(&sim);
+    printf("Recorded %u frames in %zu log bytes, checksum %08lx\n",
+           SELFTEST_FRAMES, rec.length, (unsigned long)live);
+
+    galton_profile_t profile = { .frame_us = frame_us, .frame_us_capacity = MAX_PROFILE_FRAMES };
+    int result = galton_replay(log, rec.length, &sim, &profile, host_now_us);
+    if (result != GALTON_LOG_OK) {
+        printf("FAIL: replay returned %d\n", result);
+        return 1;
+    }
+    print_result(&profile);
+
+    uint32_t replayed = galton_histogram_checksum(&sim);
+    if (replayed != live || sim.frame != SELFTEST_FRAMES || sim.step_scale != 3 ||
+        sim.collision != GALTON_COLLISION_DISCRETE) {
+        printf("FAIL: replay diverged\n");
+        return 1;
+    }
+    printf("PASS: replay is bit-identical\n");
+    return 0;
+}
+
+// Fills a small log during a run: a shorter event after the lost one is refused too, and the
+// log still ends and replays bit for bit up to the lost event
+static int overflow_test(void) {
+    // Header, END reserve, four 4-byte presses, then 3 bytes: a fifth press does not fit, a 3-byte event would
+    static uint8_t log[GALTON_LOG_HEADER_BYTES + GALTON_LOG_END_BYTES + 4 * 4 + 3];
+    galton_recorder_t rec;
+
+    galton_init(&sim);
+    galton_seed(&sim, 777);
+    galton_recorder_begin(&rec, log, sizeof(log), &sim, 777);
+    uint32_t lost_checksum = 0, lost_frame = 0;
+    int small = GALTON_LOG_OK;
+    while (sim.frame < 2000) {
+        if (sim.frame % 200 == 199) {   // Two-byte frame delta: 4 bytes per press
+            if (galton_recorder_event(&rec, sim.frame, GALTON_EV_BUTTON_A, 0) != GALTON_LOG_OK && !lost_frame) {
+                lost_frame = sim.frame;
+                lost_checksum = galton_histogram_checksum(&sim);
+                small = galton_recorder_event(&rec, rec.last_frame, GALTON_EV_BUTTON_B, 0);
+            }
+            galton_apply_event(&sim, GALTON_EV_BUTTON_A, 0);
+        }
+        galton_frame(&sim);
+    }
+    size_t full_length = rec.length;
+    int end = galton_recorder_end(&rec, sim.frame);
+    if (!rec.overflow || rec.lost_frame != lost_frame || small != GALTON_LOG_ERR_FULL ||
+        full_length + GALTON_LOG_END_BYTES + 3 > sizeof(log) || end != GALTON_LOG_OK) {
+        printf("FAIL: recording went on after a lost event, or could not end\n");
+        return 1;
+    }
+
+    int result = galton_replay(log, rec.length, &sim, NULL, NULL);
+    if (result != GALTON_LOG_OK || sim.frame != lost_frame || galton_histogram_checksum(&sim) != lost_checksum) {
+        printf("FAIL: truncated log (result %d) did not replay up to the lost event\n", result);
+        return 1;
+    }
+    printf("PASS: full log ends at the first lost event (frame %lu, %zu of %zu bytes) and replays to it\n",
+           (unsigned long)lost_frame, rec.length, sizeof(log));
+    return 0;
+}
+
+// Corrupts one header field or event value at a time: each log must be rejected before it is run
+static int corrupt_test(void) {
+    static uint8_t log[256], bad[256];
+    galton_recorder_t rec;
+
+    galton_init(&sim);
+    galton_recorder_begin(&rec, log, sizeof(log), &sim, 99);
+    galton_recorder_event(&rec, 10, GALTON_EV_BUTTON_A, 0);
+    galton_recorder_end(&rec, 20);
+    size_t length = rec.length;
+    if (galton_replay(log, length, &sim, NULL, NULL) != GALTON_LOG_OK) {
+        printf("FAIL: valid log rejected\n");
+        return 1;
+    }
+
+    const uint32_t nan_bits = 0x7FC00000u, zero_bits = 0, big_bits = 0x40000000u;  // NaN, 0.0f, 2.0f
+    const struct { size_t offset; const uint8_t *bytes; size_t n; } fields[] = {
+        { 7, (const uint8_t[]){ GALTON_MODE_TRAJECTORY + 1 }, 1 },  // Mode
+        { 12, (const uint8_t[]){ MAX_BIAS + 1 }, 1 },               // Bias: probability above 100 %
+        { 13, (const uint8_t[]){ 0 }, 1 },                          // Balls per cycle
+        { 14, (const uint8_t *)&zero_bits, 4 },                     // Gravity 0: division by zero
+        { 14, (const uint8_t *)&nan_bits, 4 },                      // Gravity NaN
+        { 18, (const uint8_t *)&big_bits, 4 },                      // Bounciness 2
+        { 22, (const uint8_t[]){ 0 }, 1 },                          // Step scale
+        { 23, (const uint8_t[]){ GALTON_COLLISION_DISCRETE + 1 }, 1 },
+    };
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        memcpy(bad, log, length);
+        memcpy(bad + fields[i].offset, fields[i].bytes, fields[i].n);  // Host is little endian, as the log
+        if (galton_replay(bad, length, &sim, NULL, NULL) != GALTON_LOG_ERR_FORMAT) {
+            printf("FAIL: header byte %zu corrupted, log accepted\n", fields[i].offset);
+            failures++;
+        }
+    }
+
+    const struct { uint8_t type; uint32_t value; } events[] = {
+        { GALTON_EV_SET_BIAS, MAX_BIAS + 1 }, { GALTON_EV_SET_BALLS, MAX_BALLS_PER_CYCLE + 1 },
+        { GALTON_EV_SET_MODE, 7 }, { GALTON_EV_SET_GRAVITY, zero_bits }, { GALTON_EV_SET_GRAVITY, nan_bits },
+        { GALTON_EV_SET_BOUNCINESS, big_bits }, { 0x42, 0 },
+    };
+    for (size_t i = 0; i < sizeof(events) / sizeof(events[0]); i++) {
+        galton_init(&sim);
+        galton_recorder_begin(&rec, bad, sizeof(bad), &sim, 99);
+        galton_recorder_event(&rec, 10, events[i].type, events[i].value);
+        galton_recorder_end(&rec, 20);
+        if (galton_replay(bad, rec.length, &sim, NULL, NULL) != GALTON_LOG_ERR_FORMAT || sim.frame != 10) {
+            printf("FAIL: event %u with value %08lx accepted\n", events[i].type, (unsigned long)events[i].value);
+            failures++;
+        }
+    }
+    if (!failures) {
+        printf("PASS: corrupted header fields and event values rejected\n");
+    }
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        return self_test() | overflow_test() | corrupt_test();
+    }
+
+    uint8_t *log = malloc(MAX_LOG_BYTES);
+    size_t length = log ? load_log(argv[1], log) : 0;
+    if (length == 0) {
+        printf("Cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    galton_profile_t profile = { .frame_us = frame_us, .frame_us_capacity = MAX_PROFILE_FRAMES };
+    int result = galton_replay(log, length, &sim, &profile, host_now_us);
+    if (result != GALTON_LOG_OK) {
+        printf("Replay failed: %d\n", result);
+        return 1;
+    }
+    print_result(&profile);
+
+    // Slowest frames, to spot spikes (e.g. a bias change rebuilding the tables)
+    uint32_t frames = profile.frames < MAX_PROFILE_FRAMES ? profile.frames : MAX_PROFILE_FRAMES;
+    for (uint32_t f = 0; f < frames; f++) {
+        if (frame_us[f] * 4 > profile.max_us * 3) {
+            printf("  frame %lu: %lu us\n", (unsigned long)f, (unsigned long)frame_us[f]);
+        }
+    }
+    free(log);
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Embarcatech, May 2025 - "Digital Galton Board" parameter sweep (host)
+// Author: Filipe Alves de Sousa
+// Runs the sweep grid on every host core (one worker thread per core) and
+// prints one CSV line per configuration, in grid order.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -I. tests/sweep_runner.c src/galton_sweep.c src/galton_simulation.c src/galton_geometry.c src/galton_collision.c src/galton_trajectory.c src/histogram.c src/galton_stats.c -lm -lpthread -o sweep_runner
+//   ./sweep_runner [threads] > sweep.csv
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <stdlib.h>    // atoi(), calloc()
+#include <time.h>      // clock_gettime()
+#include <pthread.h>   // Worker threads
+#include <unistd.h>    // sysconf()
+#include "inc/galton_sweep.h"
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+static const uint8_t sweep_rows[] = { 2, 4, 6, 8, 10 };
+static const uint8_t sweep_bias[] = { 0, 2, 5, 8, 10 };
+static const uint32_t sweep_balls[] = { 1000, 10000, 100000 };
+static const uint8_t sweep_modes[] = { GALTON_MODE_PHYSICS, GALTON_MODE_TRAJECTORY };
+
+static const galton_sweep_grid_t grid = {
+    sweep_rows, COUNT_OF(sweep_rows), sweep_bias, COUNT_OF(sweep_bias),
+    sweep_balls, COUNT_OF(sweep_balls), sweep_modes, COUNT_OF(sweep_modes)
+};
+
+typedef struct {
+    pthread_t thread;
+    uint32_t worker;
+    uint32_t workers;
+    galton_sim_t sim;              // ~21 KB, one per thread
+    galton_sweep_result_t *results;
+} worker_t;
+
+static uint32_t host_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000u + ts.tv_nsec / 1000);
+}
+
+static void *run_worker(void *arg) {
+    worker_t *w = arg;
+    galton_sweep_worker(&grid, w->worker, w->workers, &w->sim, w->results, host_now_us);
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t workers = argc > 1 ? (uint32_t)atoi(argv[1]) : (uint32_t)(cores > 0 ? cores : 1);
+    if (workers == 0) {
+        workers = 1;
+    }
+
+    uint32_t count = galton_sweep_count(&grid);
+    galton_sweep_result_t *results = calloc(count, sizeof(*results));
+    worker_t *pool = calloc(workers, sizeof(*pool));
+    if (!results || !pool) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    uint32_t start = host_now_us();
+    for (uint32_t w = 0; w < workers; w++) {
+        pool[w] = (worker_t){ .worker = w, .workers = workers, .results = results };
+        pthread_create(&pool[w].thread, NULL, run_worker, &pool[w]);
+    }
+    for (uint32_t w = 0; w < workers; w++) {
+        pthread_join(pool[w].thread, NULL);
+    }
+    uint32_t elapsed = host_now_us() - start;
+
+    char line[GALTON_SWEEP_CSV_LINE];
+    printf("%s\n", galton_sweep_csv_header());
+    for (uint32_t i = 0; i < count; i++) {
+        galton_sweep_csv(&results[i], line, sizeof(line));
+        printf("%s\n", line);
+    }
+    fprintf(stderr, "%lu configurations on %lu threads in %.2f s\n",
+            (unsigned long)count, (unsigned long)workers, elapsed / 1e6);
+
+    free(pool);
+    free(results);
+    return 0;
+}
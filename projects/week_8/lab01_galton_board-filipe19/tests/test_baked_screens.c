@@ -0,0 +1,77 @@
+// Embarcatech, May 2025 - "Digital Galton Board" baked screens test (host)
+// Author: Filipe Alves de Sousa
+// Checks that every background rendered at compile time (src/galton_screens.cpp)
+// is identical to the run-time rasterizer, that the pins sit where the collision
+// grid has them, and that the splash screen was baked.
+//
+// Build and run on the host (from the project folder):
+//   g++ -std=c++17 -O2 -I. -c src/galton_screens.cpp -o galton_screens.o
+//   gcc -O2 -I. tests/test_baked_screens.c galton_screens.o src/galton_background.c src/galton_geometry.c src/galton_collision.c inc/ssd1306_raster.c -o test_baked_screens
+//   ./test_baked_screens   (exit code 0 and "PASS" when every check holds)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <string.h>    // memcmp()
+#include "inc/galton_screens.h"
+#include "inc/galton_collision.h"
+
+static uint8_t runtime[GALTON_SCREEN_BYTES];
+
+static int pixel(const uint8_t *screen, int x, int y) {
+    return (screen[(y / 8) * 128 + x] >> (y % 8)) & 1;
+}
+
+int main(void) {
+    int failures = 0;
+
+    for (int p = 0; p < GALTON_GEOMETRY_PRESETS; p++) {
+        uint8_t rows = galton_geometry_presets[p][0];
+        uint8_t spacing = galton_geometry_presets[p][1];
+        galton_geometry_t geom;
+        if (galton_geometry_build(&geom, rows, spacing) != GALTON_GEOMETRY_OK) {
+            printf("  FAIL: preset %u x %u rejected by galton_geometry_build()\n", rows, spacing);
+            failures++;
+            continue;
+        }
+
+        const uint8_t *baked = galton_baked_background(rows, spacing);
+        galton_draw_background(runtime, &geom);
+        if (!baked || memcmp(baked, runtime, GALTON_SCREEN_BYTES) != 0) {
+            printf("  FAIL: preset %u x %u: baked background differs from the run-time one\n", rows, spacing);
+            failures++;
+            continue;
+        }
+
+        // Every pin of the collision grid is drawn
+        pin_grid_t pins;
+        pin_grid_init(&pins, &geom);
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < pin_grid_row_count(row); col++) {
+                int x = FROM_FIXED(pins.row_first_x[row]) + col * spacing;
+                int y = FROM_FIXED(pins.row_y[row]);
+                if (!pixel(baked, x, y)) {
+                    printf("  FAIL: preset %u x %u: no pin drawn at (%d, %d)\n", rows, spacing, x, y);
+                    failures++;
+                }
+            }
+        }
+        printf("Preset %u rows x %u px: identical\n", rows, spacing);
+    }
+
+    if (galton_baked_background(5, 8) != NULL) {
+        printf("  FAIL: a layout that is not a preset has a baked background\n");
+        failures++;
+    }
+
+    int lit = 0;
+    for (int i = 0; i < GALTON_SCREEN_BYTES; i++) {
+        lit += galton_splash_screen()[i] != 0;
+    }
+    if (lit == 0) {
+        printf("  FAIL: the splash screen is blank\n");
+        failures++;
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,122 @@
+// Embarcatech, May 2025 - Layered compositor test (host)
+// Author: Filipe Alves de Sousa
+// Checks the composed frame pixel by pixel against the layer rule
+// ((background | objects) & ~mask) | hud, and checks that only the pages
+// that really changed are reported for flushing.
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -I. tests/test_compositor.c src/compositor.c -o test_compositor
+//   ./test_compositor   (exit code 0 and "PASS" when every check holds)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include <string.h>    // memset()
+#include "inc/compositor.h"
+
+#define TEST_FRAMES 200
+
+static compositor_t c;
+static uint32_t rng = 12345;
+
+static uint32_t next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static int pixel(const compositor_plane_t *plane, int x, int y) {
+    return (plane->bytes[(y / 8) * COMPOSITOR_WIDTH + x] >> (y % 8)) & 1;
+}
+
+// Compares every composed pixel with the layer rule
+static int check_frame(void) {
+    for (int y = 0; y < c.pages * 8; y++) {
+        for (int x = 0; x < COMPOSITOR_WIDTH; x++) {
+            int expected = ((pixel(&c.background, x, y) | pixel(&c.objects, x, y)) & !pixel(&c.hud_mask, x, y)) |
+                           pixel(&c.hud, x, y);
+            if (pixel(&c.frame, x, y) != expected) {
+                printf("  FAIL: pixel (%d, %d) is %d, expected %d\n", x, y, pixel(&c.frame, x, y), expected);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    int failures = 0;
+    uint8_t first, last;
+
+    compositor_init(&c, 6);  // Pages 6 and 7 left to the client
+    for (int i = 0; i < COMPOSITOR_BYTES; i++) {
+        c.background.bytes[i] = (uint8_t)next_random();
+    }
+    compositor_background_changed(&c);
+    compositor_hud_box(&c, 0, 0, 24);
+    c.hud.bytes[3] = 0x7E;
+    compositor_hud_box(&c, 88, 5, 40);
+    c.hud.bytes[5 * COMPOSITOR_WIDTH + 90] = 0x3C;
+    compositor_compose(&c);
+    failures += check_frame();
+    compositor_take_flush(&c, &first, &last);
+
+    // Client pages are never written by the compositor
+    if (c.frame.bytes[6 * COMPOSITOR_WIDTH] != 0 || c.frame.bytes[7 * COMPOSITOR_WIDTH + 127] != 0) {
+        printf("  FAIL: compositor wrote into the client pages\n");
+        failures++;
+    }
+
+    // Moving objects: every frame must match the rule, and objects confined to
+    // pages 2..3 must only dirty those pages (plus the pages they left)
+    for (int f = 0; f < TEST_FRAMES; f++) {
+        compositor_clear_objects(&c);
+        for (int n = 0; n < 20; n++) {
+            compositor_set_pixel(&c, next_random() % COMPOSITOR_WIDTH, 16 + next_random() % 16);
+        }
+        compositor_compose(&c);
+        failures += check_frame();
+        if (compositor_take_flush(&c, &first, &last) && (first < 2 || last > 3)) {
+            printf("  FAIL: frame %d flushed pages %u..%u, objects only in 2..3\n", f, first, last);
+            failures++;
+        }
+        if (failures) {
+            break;
+        }
+    }
+
+    // The same objects drawn again change nothing: recomposed, but not flushed
+    uint8_t saved[COMPOSITOR_BYTES];
+    memcpy(saved, c.objects.bytes, sizeof(saved));
+    compositor_clear_objects(&c);
+    for (int i = 0; i < COMPOSITOR_BYTES; i++) {
+        for (int b = 0; b < 8; b++) {
+            if (saved[i] & (1u << b)) {
+                compositor_set_pixel(&c, i % COMPOSITOR_WIDTH, (i / COMPOSITOR_WIDTH) * 8 + b);
+            }
+        }
+    }
+    if (compositor_compose(&c) != 0 || compositor_take_flush(&c, &first, &last)) {
+        printf("  FAIL: an unchanged frame was reported for flushing\n");
+        failures++;
+    }
+
+    // Nothing drawn, nothing composed
+    compositor_compose(&c);
+    compositor_take_flush(&c, &first, &last);
+    compositor_compose(&c);
+    if (c.last_pages_composed != 0) {
+        printf("  FAIL: %u pages composed with no change\n", c.last_pages_composed);
+        failures++;
+    }
+
+    // Client pages are flushed on request
+    compositor_mark_flush(&c, (uint8_t)(COMPOSITOR_ALL_PAGES << c.pages));
+    if (!compositor_take_flush(&c, &first, &last) || first != 6 || last != 7) {
+        printf("  FAIL: client pages not flushed\n");
+        failures++;
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,85 @@
+// Embarcatech, May 2025 - "Digital Galton Board" tunneling test (host)
+// Author: Filipe Alves de Sousa
+// Drops balls through the board at every step scale, with both collision tests
+// and several board geometries, and measures how many pin rows were skipped.
+// A ball that lands has crossed every row, so it should have hit `rows` pins;
+// the tunneling rate is 1 - pin_hits / (rows * landed).
+//
+// Build and run on the host (from the project folder):
+//   gcc -O2 -I. tests/test_tunneling.c src/galton_simulation.c src/galton_geometry.c src/galton_collision.c src/galton_trajectory.c src/histogram.c src/galton_stats.c -lm -o test_tunneling
+//   ./test_tunneling   (exit code 0 and "PASS" when every check holds)
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>     // printf()
+#include "inc/galton_simulation.h"
+
+#define TEST_BALLS 4000          // Balls dropped per run
+#define TEST_SPAWN_PER_STEP 4    // Balls released per update while feeding the board
+#define TEST_CHI2_LIMIT 40.0f    // Far above any fit seen with a correct board (df <= 10)
+
+static galton_sim_t sim;
+
+static const struct { uint8_t rows, spacing; } boards[] = {
+    { 6, 6 }, { 9, 4 }, { 7, 4 }, { 3, 12 }
+};
+
+// Drops TEST_BALLS balls, drains the board and returns the tunneling rate
+static float tunneling_rate(uint8_t rows, uint8_t spacing, galton_collision_t collision, uint8_t scale,
+                            float *chi2) {
+    galton_init(&sim);
+    galton_set_geometry(&sim, rows, spacing);
+    galton_set_collision(&sim, collision);
+    galton_set_step_scale(&sim, scale);
+    galton_seed(&sim, 0xC0FFEEu);
+
+    int released = 0;
+    while (released < TEST_BALLS || sim.balls.active_count > 0) {
+        if (released < TEST_BALLS) {
+            released += galton_spawn(&sim, TEST_SPAWN_PER_STEP);
+        }
+        galton_update(&sim);
+    }
+
+    galton_stats_summary_t summary;
+    galton_stats_summary(&sim.stats, &summary);
+    *chi2 = summary.chi_square;
+    return 1.0f - (float)sim.pin_hits / ((float)rows * sim.stats.n);
+}
+
+int main(void) {
+    int failures = 0;
+
+    printf("%-6s %-8s %-6s %-10s %-10s %-8s\n", "Rows", "Spacing", "Scale", "Collision", "Tunneled", "Chi2");
+    for (unsigned g = 0; g < sizeof(boards) / sizeof(boards[0]); g++) {
+        for (uint8_t scale = 1; scale <= MAX_STEP_SCALE; scale++) {
+            for (int c = 0; c < 2; c++) {
+                galton_collision_t collision = c ? GALTON_COLLISION_DISCRETE : GALTON_COLLISION_SWEPT;
+                float chi2;
+                float rate = tunneling_rate(boards[g].rows, boards[g].spacing, collision, scale, &chi2);
+                printf("%-6u %-8u %-6u %-10s %-10.4f %-8.1f\n", boards[g].rows, boards[g].spacing, scale,
+                       c ? "discrete" : "swept", rate, chi2);
+
+                // The swept test must never miss a row, at any step size
+                if (collision == GALTON_COLLISION_SWEPT && (rate != 0.0f || chi2 > TEST_CHI2_LIMIT)) {
+                    printf("  FAIL: swept collision missed pins or lost the distribution\n");
+                    failures++;
+                }
+                // The discrete test is only exact at the base step
+                if (collision == GALTON_COLLISION_DISCRETE && scale == 1 && rate != 0.0f) {
+                    printf("  FAIL: discrete collision missed pins at the base step\n");
+                    failures++;
+                }
+            }
+        }
+    }
+
+    // Sanity check of the measurement itself: long discrete steps do skip rows
+    float chi2;
+    if (tunneling_rate(6, 6, GALTON_COLLISION_DISCRETE, MAX_STEP_SCALE, &chi2) <= 0.0f) {
+        printf("FAIL: discrete collision at %dx shows no tunneling\n", MAX_STEP_SCALE);
+        failures++;
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}